@@ -1,32 +1,39 @@
-#ifndef ABOUTSCREEN_HPP
-#define ABOUTSCREEN_HPP
-
-#include <SFML/Graphics.hpp>
-
-class AboutScreen {
-public:
-    // Enum to indicate what to do after About screen (returning back)
-    enum class AboutState { ABOUT, BACK };
-
-    // Constructor to set up the screen
-    AboutScreen(sf::RenderWindow& window, sf::Font& titleFont, sf::Font& bodyFont);
-
-    // Main loop for the About screen
-    AboutState run();
-
-private:
-    sf::RenderWindow& window;
-    sf::Font& titleFont;
-    sf::Font& bodyFont;
-
-    sf::Texture backgroundTexture;
-    sf::Sprite background;
-    sf::Text aboutText;
-    sf::Text backButton;
-
-    void draw();  // Draw everything
-    AboutState handleEvents();  // Handle mouse clicks
-    void handleMouseHover(const sf::Vector2f& mousePos);  // Highlight "Back" button on hover
-};
-
+#ifndef ABOUTSCREEN_HPP
+#define ABOUTSCREEN_HPP
+
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include "Screen.h"
+#include "Widget.h"
+#include "WidgetLayer.h"
+
+class Game;
+
+class AboutScreen : public Screen {
+public:
+    // Constructor to set up the screen
+    AboutScreen(sf::RenderWindow& window, sf::Font& titleFont, sf::Font& bodyFont, Game& game);
+
+    void onEnter() override;                            // Picks up the background texture
+    void onExit() override;
+    void onResize() override;                           // Refits the background
+    void handleEvent(const sf::Event& event) override;  // Passed to the widgets
+    void update(float deltaTime) override;
+    void draw(sf::RenderTarget& target) override;       // Draw everything
+
+private:
+    sf::RenderWindow& window;
+    sf::Font& titleFont;
+    sf::Font& bodyFont;
+    Game& game;
+
+    std::shared_ptr<const sf::Texture> backgroundTexture;  // Held only while the screen is up
+    sf::Sprite background;
+    WidgetLayer ui;
+    Label aboutText;
+    TextButton backButton;      // Red on hover
+
+    void loadBackground();
+};
+
 #endif // ABOUTSCREEN_HPP
\ No newline at end of file
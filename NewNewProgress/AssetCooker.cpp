@@ -0,0 +1,85 @@
+// Offline asset cooker. Turns source images too big to load as one texture into
+// tiled mip pyramids (.tiles) that the game streams a tile at a time; see TiledImage.
+//
+//   AssetCooker                                  cook everything in cookList
+//   AssetCooker <source image> <output.tiles> [--tile N]
+//
+// Run it from the game's asset folder after adding or changing a source image, and
+// ship the .tiles files next to the game; the source images themselves are not needed
+// at runtime. Exit status is 1 if anything failed to cook.
+
+#include <SFML/Graphics.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "TiledImage.h"
+
+namespace {
+    struct CookEntry {
+        const char* source;
+        const char* output;
+    };
+
+    // Everything the story inspects with an INSPECT cue
+    const CookEntry cookList[] = {
+        { "BiringanPanorama.png", "BiringanPanorama.tiles" },   // "Pan on the city of Biringan"
+        { "LagusanMap.png", "LagusanMap.tiles" }                // The map of the eight lagusan
+    };
+
+    bool cook(const std::string& source, const std::string& output, unsigned tileSize) {
+        auto start = std::chrono::steady_clock::now();
+        sf::Image image;
+        if (!image.loadFromFile(source)) {
+            std::cerr << "Failed to load " << source << "\n";
+            return false;
+        }
+        if (!TiledImage::cook(image, output, tileSize))
+            return false;
+
+        // Read it back, as the game would, to report on it and catch a bad write
+        TiledImage cooked;
+        if (!cooked.open(output))
+            return false;
+        std::size_t tiles = 0;
+        for (std::size_t level = 0; level < cooked.getLevelCount(); ++level)
+            tiles += static_cast<std::size_t>(cooked.getLevel(level).columns) * cooked.getLevel(level).rows;
+        std::ifstream file(output, std::ios::binary | std::ios::ate);
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << source << " (" << image.getSize().x << "x" << image.getSize().y << ") -> " << output
+            << ": " << cooked.getLevelCount() << " levels, " << tiles << " tiles of " << tileSize
+            << ", " << static_cast<long long>(file.tellg()) << " bytes, " << seconds << " s\n";
+        return true;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    unsigned tileSize = TiledImage::defaultTileSize;
+    std::string source;
+    std::string output;
+    bool usage = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--tile") == 0 && i + 1 < argc) tileSize = std::atoi(argv[++i]);
+        else if (source.empty()) source = argv[i];
+        else if (output.empty()) output = argv[i];
+        else usage = true;
+    }
+
+    // Tiles have to fit the smallest GL_MAX_TEXTURE_SIZE we might meet
+    if (usage || tileSize < 16 || tileSize > 2048 || (!source.empty() && output.empty())) {
+        std::cerr << "usage: AssetCooker [<source image> <output.tiles>] [--tile N]  (16 <= N <= 2048)\n";
+        return 2;
+    }
+
+    if (!source.empty())
+        return cook(source, output, tileSize) ? 0 : 1;
+
+    bool ok = true;
+    for (const CookEntry& entry : cookList)
+        ok = cook(entry.source, entry.output, tileSize) && ok;
+    return ok ? 0 : 1;
+}
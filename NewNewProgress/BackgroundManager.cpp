@@ -1,85 +1,369 @@
-#include "BackgroundManager.h"
-#include <iostream>
-
-BackgroundManager::BackgroundManager(sf::RenderWindow& win)
-    : window(win) {
-    fadeRect.setSize(sf::Vector2f(window.getSize()));
-    fadeRect.setFillColor(sf::Color(0, 0, 0, 0));
-}
-
-void BackgroundManager::setBackground(const std::string& imagePath) {
-    if (texture.loadFromFile(imagePath)) {
-        sprite.setTexture(texture);
-        float windowWidth = static_cast<float>(window.getSize().x);
-        float windowHeight = static_cast<float>(window.getSize().y);
-        float textureWidth = static_cast<float>(texture.getSize().x);
-        float textureHeight = static_cast<float>(texture.getSize().y);
-
-        float scale = std::max(windowWidth / textureWidth, windowHeight / textureHeight); // Fill entire window
-
-        sprite.setTexture(texture);
-        sprite.setScale(scale, scale);
-
-        // center the image if it's larger than the window
-        float offsetX = (textureWidth * scale - windowWidth) / 2.0f;
-        float offsetY = (textureHeight * scale - windowHeight) / 2.0f;
-        sprite.setPosition(-offsetX, -offsetY);
-        hasBackground = true;
-        isHiddenFlag = false;
-        currentBackgroundPath = imagePath;
-    }
-    else {
-        std::cerr << "Failed to load background: " << imagePath << std::endl;
-        hasBackground = false;
-        currentBackgroundPath = "";
-    }
-    
-}
-
-void BackgroundManager::update(float deltaTime) {
-    if (isFadingFlag) {
-        fadeElapsed += deltaTime;
-        fadeOpacity = std::min(255.0f, (fadeElapsed / fadeDuration) * 255.0f);
-        fadeRect.setFillColor(sf::Color(0, 0, 0, static_cast<sf::Uint8>(fadeOpacity)));
-
-        if (fadeElapsed >= fadeDuration) {
-            isFadingFlag = false;
-            isHiddenFlag = true;
-        }
-    }
-}
-
-void BackgroundManager::draw() {
-    if (hasBackground && !isHiddenFlag) {
-        window.draw(sprite);
-    }
-    if (isFadingFlag || isHiddenFlag) {
-        window.draw(fadeRect);
-    }
-}
-
-void BackgroundManager::startFadeOut(float duration) {
-    fadeDuration = duration;
-    fadeElapsed = 0.0f;
-    fadeOpacity = 0.0f;
-    isFadingFlag = true;
-    isHiddenFlag = false;
-}
-
-void BackgroundManager::resetFade() {
-    isHiddenFlag = false;
-    fadeOpacity = 255.0f;
-    fadeRect.setFillColor(sf::Color(0, 0, 0, static_cast<sf::Uint8>(fadeOpacity)));
-}
-
-bool BackgroundManager::isFading() const {
-    return isFadingFlag;
-}
-
-bool BackgroundManager::isHidden() const {
-    return isHiddenFlag;
-}
-
-std::string BackgroundManager::getCurrentBackground() const {
-    return currentBackgroundPath;
+#include "BackgroundManager.h"
+#include "TextureCache.h"
+#include "Profiler.h"
+#include "Tracer.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+namespace {
+    // Both layers are worked out per pixel from the scene position, so one quad over
+    // the screen draws the whole transition whatever the two backgrounds are
+    const char* const transitionVertexShader = R"(
+uniform mat4 toOld;         // Scene position to the outgoing texture's coordinates
+uniform mat4 toNew;
+uniform vec2 screenSize;
+varying vec2 oldCoord;
+varying vec2 newCoord;
+varying vec2 screenCoord;
+
+void main() {
+    oldCoord = (toOld * gl_Vertex).xy;
+    newCoord = (toNew * gl_Vertex).xy;
+    screenCoord = gl_Vertex.xy / screenSize;
+    gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;
+}
+)";
+
+    const char* const transitionFragmentShader = R"(
+uniform sampler2D oldTexture;
+uniform sampler2D newTexture;
+uniform vec4 oldColor;      // Used instead of the texture when solid is 1
+uniform vec4 newColor;
+uniform float oldSolid;
+uniform float newSolid;
+uniform float progress;     // 0 to 1
+uniform int mode;           // 0 crossfade, 1 dip, 2 wipe, 3 dissolve
+uniform vec4 dipColor;
+uniform vec2 wipeDirection; // The way the edge travels
+uniform vec2 screenSize;
+varying vec2 oldCoord;
+varying vec2 newCoord;
+varying vec2 screenCoord;
+
+void main() {
+    vec4 a = mix(texture2D(oldTexture, oldCoord), oldColor, oldSolid);
+    vec4 b = mix(texture2D(newTexture, newCoord), newColor, newSolid);
+    float t = progress;
+
+    if (mode == 1) {
+        gl_FragColor = t < 0.5 ? mix(a, dipColor, t * 2.0) : mix(dipColor, b, t * 2.0 - 1.0);
+        return;
+    }
+    if (mode == 2) {
+        // 0 on the side the wipe starts from, with a soft edge
+        float along = dot(screenCoord - 0.5, wipeDirection) + 0.5;
+        t = smoothstep(along, along + 0.05, t * 1.05);
+    }
+    else if (mode == 3) {
+        vec2 block = floor(screenCoord * screenSize / 4.0);
+        float noise = fract(sin(dot(block, vec2(12.9898, 78.233))) * 43758.5453);
+        t = smoothstep(noise, noise + 0.1, t * 1.1);
+    }
+    gl_FragColor = mix(a, b, t);
+}
+)";
+
+    // Compiled on the first transition, shared by every BackgroundManager
+    struct TransitionShader {
+        sf::Shader shader;
+        sf::Texture blank;      // Bound for a solid layer, so no sampler points at a freed texture
+        bool tried = false;
+        bool ready = false;
+    };
+
+    TransitionShader* getTransitionShader() {
+        static TransitionShader transition;
+        if (!transition.tried) {
+            transition.tried = true;
+            sf::Image white;
+            white.create(1, 1, sf::Color::White);
+            transition.ready = sf::Shader::isAvailable()
+                && transition.shader.loadFromMemory(transitionVertexShader, transitionFragmentShader)
+                && transition.blank.loadFromImage(white);
+            if (!transition.ready)
+                std::cerr << "Transition shader unavailable; background transitions will crossfade\n";
+        }
+        return transition.ready ? &transition : nullptr;
+    }
+
+    // Maps scene positions to the layer's normalized texture coordinates
+    sf::Transform sceneToTexture(const sf::Sprite& sprite, const sf::Texture& texture) {
+        sf::Transform toTexture;
+        toTexture.scale(1.0f / texture.getSize().x, 1.0f / texture.getSize().y);
+        toTexture.combine(sprite.getInverseTransform());
+        return toTexture;
+    }
+
+    sf::Vector2f wipeDirection(TransitionType type) {
+        switch (type) {
+        case TransitionType::WIPE_LEFT: return sf::Vector2f(-1.0f, 0.0f);
+        case TransitionType::WIPE_RIGHT: return sf::Vector2f(1.0f, 0.0f);
+        case TransitionType::WIPE_UP: return sf::Vector2f(0.0f, -1.0f);
+        default: return sf::Vector2f(0.0f, 1.0f);
+        }
+    }
+
+    int shaderMode(TransitionType type) {
+        switch (type) {
+        case TransitionType::DIP: return 1;
+        case TransitionType::WIPE_LEFT:
+        case TransitionType::WIPE_RIGHT:
+        case TransitionType::WIPE_UP:
+        case TransitionType::WIPE_DOWN: return 2;
+        case TransitionType::DISSOLVE: return 3;
+        default: return 0;
+        }
+    }
+}
+
+BackgroundManager::BackgroundManager(sf::RenderTarget& target)
+    : target(target), screenQuad(sf::TriangleStrip, 4) {
+    sf::Vector2f size(target.getDefaultView().getSize());     // View units, like everything drawn on it
+    fadeRect.setSize(size);
+    fadeRect.setFillColor(sf::Color(0, 0, 0, 0));
+    solidRect.setSize(size);
+    screenQuad[0].position = sf::Vector2f(0.0f, 0.0f);
+    screenQuad[1].position = sf::Vector2f(size.x, 0.0f);
+    screenQuad[2].position = sf::Vector2f(0.0f, size.y);
+    screenQuad[3].position = size;
+}
+
+bool BackgroundManager::isSolidColor(const std::string& background) {
+    return background.size() == 7 && background[0] == '#';
+}
+
+void BackgroundManager::setBackground(const std::string& imagePath) {
+    TRACE_SCOPE("BackgroundManager::setBackground");
+    transitioning = false;
+    waitingForLoad = false;
+    previous = Layer();
+    if (loadLayer(current, imagePath)) {
+        isHiddenFlag = false;
+        currentBackgroundPath = imagePath;
+    }
+    else {
+        currentBackgroundPath = "";
+    }
+}
+
+std::string BackgroundManager::getTextureKey(const std::string& background) const {
+    if (isSolidColor(background))
+        return background;
+    return TextureCache::fittedKey(background, target.getSize(), FitMode::COVER);
+}
+
+void BackgroundManager::refit() {
+    TRACE_SCOPE("BackgroundManager::refit");
+    if (current.texture)
+        loadLayer(current, current.background);
+    if (transitioning && previous.texture)
+        loadLayer(previous, previous.background);
+}
+
+bool BackgroundManager::loadLayer(Layer& layer, const std::string& background) {
+    layer.texture.reset();
+    layer.visible = false;
+    layer.background = background;
+
+    if (isSolidColor(background)) {
+        unsigned long rgb = std::strtoul(background.c_str() + 1, nullptr, 16);
+        layer.color = sf::Color((rgb >> 16) & 0xFF, (rgb >> 8) & 0xFF, rgb & 0xFF);
+        layer.visible = true;
+        return true;
+    }
+
+    // Preloaded backgrounds come straight out of the cache with no decode
+    layer.texture = TextureCache::getInstance().get(getTextureKey(background));
+    if (!layer.texture) {
+        std::cerr << "Failed to load background: " << background << std::endl;
+        return false;
+    }
+
+    // In view units, which stay put when the window is resized
+    float windowWidth = target.getDefaultView().getSize().x;
+    float windowHeight = target.getDefaultView().getSize().y;
+    float textureWidth = static_cast<float>(layer.texture->getSize().x);
+    float textureHeight = static_cast<float>(layer.texture->getSize().y);
+
+    float scale = std::max(windowWidth / textureWidth, windowHeight / textureHeight); // Fill entire window
+
+    layer.sprite.setTexture(*layer.texture, true);
+    layer.sprite.setScale(scale, scale);
+
+    // center the image if it's larger than the window
+    float offsetX = (textureWidth * scale - windowWidth) / 2.0f;
+    float offsetY = (textureHeight * scale - windowHeight) / 2.0f;
+    layer.sprite.setPosition(-offsetX, -offsetY);
+    layer.visible = true;
+    return true;
+}
+
+void BackgroundManager::transitionTo(const std::string& background, const BackgroundTransition& next) {
+    if (next.type == TransitionType::CUT || next.duration <= 0.0f) {
+        setBackground(background);
+        return;
+    }
+
+    transition = next;
+    pendingBackground = background;
+    std::string key = getTextureKey(background);
+    if (isSolidColor(background) || TextureCache::getInstance().isLoaded(key)) {
+        beginTransition();
+        return;
+    }
+
+    // Not prefetched: keep showing the old one rather than stall the frame on a decode
+    pendingLoad = TextureCache::getInstance().loadAsync(key);
+    waitingForLoad = true;
+}
+
+void BackgroundManager::beginTransition() {
+    TRACE_SCOPE("BackgroundManager::beginTransition");
+    waitingForLoad = false;
+    previous = std::move(current);
+    current = Layer();
+    if (!previous.visible || isHiddenFlag) {
+        previous = Layer();     // Nothing on screen: come in from black
+        previous.visible = true;
+    }
+
+    if (!loadLayer(current, pendingBackground)) {
+        currentBackgroundPath = "";
+        transitioning = false;
+        previous = Layer();
+        return;
+    }
+    currentBackgroundPath = pendingBackground;
+    isHiddenFlag = false;
+    transitionElapsed = 0.0f;
+    transitioning = true;
+}
+
+bool BackgroundManager::isTransitioning() const {
+    return transitioning || waitingForLoad;
+}
+
+float BackgroundManager::transitionProgress() const {
+    return std::min(transitionElapsed / transition.duration, 1.0f);
+}
+
+void BackgroundManager::update(float deltaTime) {
+    if (waitingForLoad && JobSystem::isDone(pendingLoad))
+        beginTransition();
+
+    if (transitioning) {
+        transitionElapsed += deltaTime;
+        if (transitionElapsed >= transition.duration) {
+            transitioning = false;
+            previous = Layer();     // Lets the cache evict the old texture
+        }
+    }
+
+    if (isFadingFlag) {
+        fadeElapsed += deltaTime;
+        fadeOpacity = std::min(255.0f, (fadeElapsed / fadeDuration) * 255.0f);
+        fadeRect.setFillColor(sf::Color(0, 0, 0, static_cast<sf::Uint8>(fadeOpacity)));
+
+        if (fadeElapsed >= fadeDuration) {
+            isFadingFlag = false;
+            isHiddenFlag = true;
+        }
+    }
+}
+
+void BackgroundManager::draw(const sf::View& camera) {
+    PROFILE_SCOPE(BackgroundDraw);
+    if (current.visible && !isHiddenFlag) {
+        sf::View screenView = target.getView();
+        target.setView(camera);
+        if (!transitioning) {
+            drawLayer(current, 255);
+        }
+        else if (!drawComposite()) {
+            // Fixed-function fallback: the new background over the old, fading in
+            float t = transitionProgress();
+            drawLayer(previous, 255);
+            drawLayer(current, static_cast<sf::Uint8>(t * 255.0f));
+        }
+        target.setView(screenView);
+    }
+    if (isFadingFlag || isHiddenFlag || isFadeHeld) {
+        target.draw(fadeRect);
+        PROFILE_DRAW(fadeRect);
+    }
+}
+
+void BackgroundManager::drawLayer(Layer& layer, sf::Uint8 alpha) {
+    if (layer.texture) {
+        layer.sprite.setColor(sf::Color(255, 255, 255, alpha));
+        target.draw(layer.sprite);
+        PROFILE_DRAW(layer.sprite);
+    }
+    else {
+        solidRect.setFillColor(sf::Color(layer.color.r, layer.color.g, layer.color.b, alpha));
+        target.draw(solidRect);
+        PROFILE_DRAW(solidRect);
+    }
+}
+
+bool BackgroundManager::drawComposite() {
+    TransitionShader* composite = getTransitionShader();
+    if (!composite)
+        return false;
+
+    sf::Shader& shader = composite->shader;
+    auto bindLayer = [&](const Layer& layer, const char* texture, const char* color, const char* solid, const char* toTexture) {
+        shader.setUniform(texture, layer.texture ? *layer.texture : composite->blank);
+        shader.setUniform(color, sf::Glsl::Vec4(layer.color));
+        shader.setUniform(solid, layer.texture ? 0.0f : 1.0f);
+        shader.setUniform(toTexture, sf::Glsl::Mat4(layer.texture ? sceneToTexture(layer.sprite, *layer.texture) : sf::Transform::Identity));
+    };
+    bindLayer(previous, "oldTexture", "oldColor", "oldSolid", "toOld");
+    bindLayer(current, "newTexture", "newColor", "newSolid", "toNew");
+    shader.setUniform("progress", transitionProgress());
+    shader.setUniform("mode", shaderMode(transition.type));
+    shader.setUniform("dipColor", sf::Glsl::Vec4(transition.color));
+    shader.setUniform("wipeDirection", wipeDirection(transition.type));
+    shader.setUniform("screenSize", target.getDefaultView().getSize());
+
+    target.draw(screenQuad, sf::RenderStates(&shader));
+    PROFILE_DRAW(current.texture.get());
+    return true;
+}
+
+void BackgroundManager::startFadeOut(float duration) {
+    fadeDuration = duration;
+    fadeElapsed = 0.0f;
+    fadeOpacity = 0.0f;
+    isFadingFlag = true;
+    isHiddenFlag = false;
+    isFadeHeld = false;
+}
+
+void BackgroundManager::resetFade() {
+    isHiddenFlag = false;
+    isFadeHeld = false;
+    fadeOpacity = 255.0f;
+    fadeRect.setFillColor(sf::Color(0, 0, 0, static_cast<sf::Uint8>(fadeOpacity)));
+}
+
+void BackgroundManager::setFadeAmount(float amount) {
+    fadeOpacity = std::min(std::max(amount, 0.0f), 1.0f) * 255.0f;
+    fadeRect.setFillColor(sf::Color(0, 0, 0, static_cast<sf::Uint8>(fadeOpacity)));
+    isFadingFlag = false;
+    isHiddenFlag = false;
+    isFadeHeld = fadeOpacity > 0.0f;
+}
+
+bool BackgroundManager::isFading() const {
+    return isFadingFlag;
+}
+
+bool BackgroundManager::isHidden() const {
+    return isHiddenFlag;
+}
+
+const std::string& BackgroundManager::getCurrentBackground() const {
+    return currentBackgroundPath;
 }
\ No newline at end of file
@@ -1,40 +1,107 @@
-#ifndef BACKGROUND_MANAGER_H
-#define BACKGROUND_MANAGER_H
-
-#include <SFML/Graphics.hpp>
-#include <string>
-
-class BackgroundManager {
-public:
-    BackgroundManager(sf::RenderWindow& window);
-
-    void setBackground(const std::string& imagePath);
-    void update(float deltaTime);
-    void draw();
-    void startFadeOut(float duration);
-    void resetFade();
-    bool isFading() const;
-    bool isHidden() const;
-
-    // Getter for the currently set background path
-    std::string getCurrentBackground() const;
-
-private:
-    sf::RenderWindow& window;
-    sf::Texture texture;
-    sf::Sprite sprite;
-    sf::RectangleShape fadeRect;
-
-    bool hasBackground = false;
-    bool isFadingFlag = false;
-    bool isHiddenFlag = false;
-
-    float fadeOpacity = 255.0f;
-    float fadeDuration = 1.0f;
-    float fadeElapsed = 0.0f;
-
-    //  Track the background image path for saving
-    std::string currentBackgroundPath;
-};
-
-#endif
\ No newline at end of file
+#ifndef BACKGROUND_MANAGER_H
+#define BACKGROUND_MANAGER_H
+
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <string>
+#include "JobSystem.h"
+
+enum class TransitionType {
+    CUT,
+    CROSSFADE,
+    DIP,            // Out to a colour, then in from it
+    WIPE_LEFT,      // The new background sweeps in moving left
+    WIPE_RIGHT,
+    WIPE_UP,
+    WIPE_DOWN,
+    DISSOLVE        // Scattered blocks switch over at random
+};
+
+struct BackgroundTransition {
+    TransitionType type = TransitionType::CUT;
+    float duration = 0.0f;
+    sf::Color color = sf::Color::Black;     // DIP: the colour passed through
+};
+
+// The full-screen image behind everything, and the black fade over it.
+//
+// A background is an image path, or a solid colour written "#rrggbb", which needs
+// no texture at all. A transition keeps the outgoing and incoming backgrounds and
+// composites them in a single full-screen draw through a small shader; without
+// shader support every kind of transition falls back to a crossfade.
+//
+// Images come from TextureCache already resampled to the window's size (see
+// getTextureKey), and are fitted again by refit() when the window is resized.
+class BackgroundManager {
+public:
+    BackgroundManager(sf::RenderTarget& target);
+
+    void setBackground(const std::string& imagePath);   // Cuts straight to it
+    // Blends into it. If the image isn't in the texture cache yet, it's loaded in the
+    // background and the transition starts once it arrives; the old one stays up meanwhile.
+    void transitionTo(const std::string& background, const BackgroundTransition& transition);
+    bool isTransitioning() const;   // Including while waiting for the new image
+
+    // The TextureCache key a background is drawn from at the current window size;
+    // preload through this so the background is ready when it's set
+    std::string getTextureKey(const std::string& background) const;
+    void refit();   // After a resize, reloads what's on screen at the new size
+
+    void update(float deltaTime);
+    // The backgrounds go through the camera's view; the fade stays over the whole screen
+    void draw(const sf::View& camera);
+    void startFadeOut(float duration);
+    void resetFade();
+    // Holds the black over the screen at a given strength, 0 clear to 1 opaque
+    void setFadeAmount(float amount);
+    bool isFading() const;
+    bool isHidden() const;
+
+    // Getter for the currently set background path
+    const std::string& getCurrentBackground() const;
+
+    static bool isSolidColor(const std::string& background);
+
+private:
+    // One background: a texture scaled to fill the screen, or a solid colour
+    struct Layer {
+        std::shared_ptr<const sf::Texture> texture;     // Keeps it resident in TextureCache
+        sf::Sprite sprite;
+        sf::Color color = sf::Color::Black;
+        bool visible = false;
+        std::string background;     // As given, for refit
+    };
+
+    bool loadLayer(Layer& layer, const std::string& background);
+    void beginTransition();
+    void drawLayer(Layer& layer, sf::Uint8 alpha);
+    bool drawComposite();   // The shader path; false if shaders aren't available
+    float transitionProgress() const;
+
+    sf::RenderTarget& target;   // The window, or an offscreen texture in the benchmark
+    Layer current;
+    Layer previous;             // Only while transitioning
+    sf::RectangleShape solidRect;
+    sf::VertexArray screenQuad;
+    sf::RectangleShape fadeRect;
+
+    bool isFadingFlag = false;
+    bool isHiddenFlag = false;
+    bool isFadeHeld = false;
+
+    float fadeOpacity = 255.0f;
+    float fadeDuration = 1.0f;
+    float fadeElapsed = 0.0f;
+
+    BackgroundTransition transition;
+    float transitionElapsed = 0.0f;
+    bool transitioning = false;
+    std::string pendingBackground;  // Loading; the transition starts once it's in
+    JobHandle pendingLoad;
+    bool waitingForLoad = false;
+
+    //  Track the background image path for saving
+    std::string currentBackgroundPath;
+};
+
+#endif
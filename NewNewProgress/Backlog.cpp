@@ -0,0 +1,63 @@
+#include "Backlog.h"
+#include <algorithm>
+
+const std::size_t Backlog::capacity;
+
+// Let it grow to twice the capacity, then drop the older half in one go
+void Backlog::record(LineId line, unsigned rows, std::uint16_t lineNames) {
+    if (lines.size() >= 2 * capacity) {
+        std::size_t dropped = lines.size() - capacity;
+        std::uint32_t droppedRows = rowEnds[dropped - 1];
+        lines.erase(lines.begin(), lines.begin() + dropped);
+        rowEnds.erase(rowEnds.begin(), rowEnds.begin() + dropped);
+        names.erase(names.begin(), names.begin() + dropped);
+        for (std::uint32_t& end : rowEnds)
+            end -= droppedRows;
+    }
+    if (lines.capacity() < 2 * capacity) {
+        lines.reserve(2 * capacity);
+        rowEnds.reserve(2 * capacity);
+        names.reserve(2 * capacity);
+    }
+
+    lines.push_back(line);
+    rowEnds.push_back(getTotalRows() + rows);
+    names.push_back(lineNames);
+}
+
+void Backlog::clear() {
+    lines.clear();
+    rowEnds.clear();
+    names.clear();
+}
+
+std::size_t Backlog::getCount() const {
+    return lines.size();
+}
+
+LineId Backlog::getLine(std::size_t index) const {
+    return lines[index];
+}
+
+std::uint16_t Backlog::getNames(std::size_t index) const {
+    return names[index];
+}
+
+std::uint32_t Backlog::getFirstRow(std::size_t index) const {
+    return index == 0 ? 0 : rowEnds[index - 1];
+}
+
+std::uint32_t Backlog::getTotalRows() const {
+    return rowEnds.empty() ? 0 : rowEnds.back();
+}
+
+std::size_t Backlog::findEntry(std::uint32_t row) const {
+    return std::upper_bound(rowEnds.begin(), rowEnds.end(), row) - rowEnds.begin();
+}
+
+unsigned Backlog::countRows(const DialogueEntry& entry) {
+    unsigned rows = 2 + static_cast<unsigned>(std::count(entry.text.begin(), entry.text.end(), '\n'));
+    if (!entry.speaker.empty())
+        ++rows;
+    return rows;
+}
@@ -0,0 +1,43 @@
+#ifndef BACKLOG_HPP
+#define BACKLOG_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "StoryScript.h"
+
+// The lines read so far, for the history viewer. Only line IDs are kept; the text
+// is looked up in the script when an entry comes into view. Each entry also
+// remembers how many rows it takes up, so the viewer can find what's on screen
+// without measuring anything.
+//
+// Lines with the player's names in them are shown with the names as they were when
+// the line was read, so each entry keeps which set of names that was.
+//
+// Only the newest `capacity` lines are guaranteed; older ones are dropped in
+// batches, so memory stays the same however long the game is played.
+class Backlog {
+public:
+    static const std::size_t capacity = 1000;
+
+    void record(LineId line, unsigned rows, std::uint16_t names);
+    void clear();
+
+    std::size_t getCount() const;
+    LineId getLine(std::size_t index) const;        // 0 = oldest kept
+    std::uint16_t getNames(std::size_t index) const;    // A TextVariables snapshot
+    std::uint32_t getFirstRow(std::size_t index) const;
+    std::uint32_t getTotalRows() const;
+    // The entry covering a row, or getCount() if it's past the end
+    std::size_t findEntry(std::uint32_t row) const;
+
+    // Rows a line takes in the viewer: its speaker, its text and a gap
+    static unsigned countRows(const DialogueEntry& entry);
+
+private:
+    std::vector<LineId> lines;
+    std::vector<std::uint32_t> rowEnds;     // Rows up to and including each entry
+    std::vector<std::uint16_t> names;
+};
+
+#endif // BACKLOG_HPP
@@ -0,0 +1,152 @@
+#include "BacklogScreen.h"
+#include "Backlog.h"
+#include "Game.h"
+#include "GameplayScreen.h"
+#include "Profiler.h"
+#include "TextVariables.h"
+#include <algorithm>
+
+BacklogScreen::BacklogScreen(sf::RenderWindow& win, sf::Font& font, Game& game)
+    : window(win), font(font), game(game), snapshot(win)
+{
+    hint.setFont(font);
+    hint.setString("Scroll to read back, Esc to return");
+    hint.setCharacterSize(18);
+    hint.setFillColor(sf::Color(200, 200, 200));
+
+    scrollTrack.setFillColor(sf::Color(255, 255, 255, 40));
+    scrollThumb.setFillColor(sf::Color(255, 255, 255, 160));
+}
+
+void BacklogScreen::onEnter() {
+    backlog = &game.getGameplayScreen().getBacklog();
+    scroll = 0;
+    snapshot.invalidate();
+    onResize();
+}
+
+// The area is fixed in view units, but the clipping view's viewport depends on them too
+void BacklogScreen::onResize() {
+    snapshot.invalidate();
+    sf::Vector2f size = window.getDefaultView().getSize();
+    area = sf::FloatRect(250.0f, 60.0f, size.x - 500.0f, size.y - 150.0f);
+    clip.reset(sf::FloatRect(0.0f, 0.0f, area.width, area.height));
+    clip.setViewport(sf::FloatRect(area.left / size.x, area.top / size.y, area.width / size.x, area.height / size.y));
+
+    rowHeight = font.getLineSpacing(characterSize);
+    visibleRows = std::max(1u, static_cast<unsigned>(area.height / rowHeight));
+
+    sf::FloatRect bounds = hint.getLocalBounds();
+    hint.setOrigin(bounds.left + bounds.width / 2.0f, bounds.top);
+    hint.setPosition(size.x / 2.0f, area.top + area.height + 30.0f);
+    scrollTrack.setPosition(area.left + area.width + 20.0f, area.top);
+    scrollTrack.setSize(sf::Vector2f(6.0f, area.height));
+    layoutVisible();
+}
+
+void BacklogScreen::handleEvent(const sf::Event& event) {
+    if ((event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape) ||
+        (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Right)) {
+        game.getScreens().pop();
+        return;
+    }
+
+    if (event.type == sf::Event::MouseWheelScrolled && event.mouseWheelScroll.wheel == sf::Mouse::VerticalWheel) {
+        // Scrolling down at the newest line goes back to it in the story
+        if (event.mouseWheelScroll.delta < 0.0f && scroll == 0) {
+            game.getScreens().pop();
+            return;
+        }
+        scrollBy(static_cast<int>(event.mouseWheelScroll.delta * wheelRows));
+    }
+    else if (event.type == sf::Event::KeyPressed) {
+        switch (event.key.code) {
+        case sf::Keyboard::Up: scrollBy(1); break;
+        case sf::Keyboard::Down: scrollBy(-1); break;
+        case sf::Keyboard::PageUp: scrollBy(static_cast<int>(visibleRows)); break;
+        case sf::Keyboard::PageDown: scrollBy(-static_cast<int>(visibleRows)); break;
+        case sf::Keyboard::Home: scrollBy(static_cast<int>(backlog->getTotalRows())); break;
+        case sf::Keyboard::End: scrollBy(-static_cast<int>(scroll)); break;
+        default: break;
+        }
+    }
+}
+
+void BacklogScreen::scrollBy(int rows) {
+    std::uint32_t total = backlog->getTotalRows();
+    std::int64_t maxScroll = total > visibleRows ? total - visibleRows : 0;
+    std::int64_t next = std::min(std::max(static_cast<std::int64_t>(scroll) + rows, std::int64_t(0)), maxScroll);
+    if (next == scroll) return;
+    scroll = static_cast<std::uint32_t>(next);
+    layoutVisible();
+}
+
+// Nothing moves unless the player scrolls
+void BacklogScreen::update(float deltaTime) {
+}
+
+// Finds the entries overlapping the rows in view and gives each a text object
+void BacklogScreen::layoutVisible() {
+    shown = 0;
+    if (!backlog) return;
+
+    std::uint32_t total = backlog->getTotalRows();
+    std::uint32_t bottom = total - std::min(scroll, total);
+    std::uint32_t top = bottom > visibleRows ? bottom - visibleRows : 0;
+
+    for (std::size_t i = backlog->findEntry(top); i < backlog->getCount() && backlog->getFirstRow(i) < bottom; ++i) {
+        const DialogueEntry* entry = StoryScript::getLine(backlog->getLine(i));
+        if (!entry) continue;
+
+        float y = (static_cast<float>(backlog->getFirstRow(i)) - top) * rowHeight;
+        if (!entry->speaker.empty()) {
+            sf::Text& speaker = nextText();
+            speaker.setString(sf::String(entry->speaker));    // Converted the way the dialogue box does
+            speaker.setFillColor(sf::Color(255, 220, 130));
+            speaker.setPosition(0.0f, y);
+            y += rowHeight;
+        }
+        sf::Text& text = nextText();
+        TextVariables::getInstance().expand(entry->text, backlog->getNames(i), expanded);
+        text.setString(sf::String(expanded));
+        text.setFillColor(sf::Color::White);
+        text.setPosition(20.0f, y);
+    }
+
+    // Thumb size and place follow the share of rows in view
+    float share = total > visibleRows ? static_cast<float>(visibleRows) / total : 1.0f;
+    float thumbHeight = area.height * share;
+    float thumbTop = total > visibleRows ? static_cast<float>(top) / (total - visibleRows) * (area.height - thumbHeight) : 0.0f;
+    scrollThumb.setPosition(scrollTrack.getPosition().x, area.top + thumbTop);
+    scrollThumb.setSize(sf::Vector2f(6.0f, thumbHeight));
+}
+
+// The pool only grows as far as the most entries that have been in view at once
+sf::Text& BacklogScreen::nextText() {
+    if (shown == texts.size()) {
+        texts.emplace_back();
+        texts.back().setFont(font);
+        texts.back().setCharacterSize(characterSize);
+    }
+    return texts[shown++];
+}
+
+void BacklogScreen::draw(sf::RenderTarget& target) {
+    snapshot.draw(target, sf::Color(50, 50, 50));
+
+    PROFILE_SCOPE(TextDraw);
+    sf::View screenView = target.getView();
+    target.setView(clip);
+    for (std::size_t i = 0; i < shown; ++i) {
+        target.draw(texts[i]);
+        PROFILE_DRAW(texts[i]);
+    }
+    target.setView(screenView);
+
+    target.draw(scrollTrack);
+    PROFILE_DRAW(scrollTrack);
+    target.draw(scrollThumb);
+    PROFILE_DRAW(scrollThumb);
+    target.draw(hint);
+    PROFILE_DRAW(hint);
+}
@@ -0,0 +1,61 @@
+#ifndef BACKLOGSCREEN_HPP
+#define BACKLOGSCREEN_HPP
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Screen.h"
+#include "SceneSnapshot.h"
+
+class Game;
+class Backlog;
+
+// The lines read so far, pushed over gameplay by scrolling up. Scroll (or use the
+// arrow and page keys) to read back; scrolling down past the newest line, Escape or
+// a right-click goes back to the story.
+//
+// Only the entries in view have text objects. Where each entry sits is known from
+// the backlog's row counts, so scrolling looks up the few entries now in view and
+// sets their strings; nothing is laid out or drawn for the rest.
+class BacklogScreen : public Screen {
+public:
+    BacklogScreen(sf::RenderWindow& window, sf::Font& font, Game& game);
+
+    void onEnter() override;
+    void onResize() override;
+    void handleEvent(const sf::Event& event) override;
+    void update(float deltaTime) override;
+    void draw(sf::RenderTarget& target) override;
+
+    bool isOverlay() const override { return !snapshot.isCaptured(); }
+
+private:
+    void scrollBy(int rows);
+    void layoutVisible();
+    sf::Text& nextText();
+
+    sf::RenderWindow& window;
+    sf::Font& font;
+    Game& game;
+    const Backlog* backlog = nullptr;
+
+    SceneSnapshot snapshot;
+    sf::FloatRect area;             // Where the entries are shown, in view units
+    sf::View clip;                  // Cuts entries off at the edges of the area
+    float rowHeight = 0.0f;
+    std::uint32_t visibleRows = 0;
+    std::uint32_t scroll = 0;       // Rows up from the newest line
+
+    std::vector<sf::Text> texts;    // Pool; the first `shown` are in view
+    std::size_t shown = 0;
+    std::string expanded;           // An entry's text with the names it was read with
+    sf::RectangleShape scrollTrack;
+    sf::RectangleShape scrollThumb;
+    sf::Text hint;
+
+    const unsigned characterSize = 22;
+    const unsigned wheelRows = 3;
+};
+
+#endif // BACKLOGSCREEN_HPP
@@ -0,0 +1,836 @@
+// Headless replay benchmark. Plays the whole story - every line of every node and
+// every option of every choice - through the real gameplay systems into an offscreen
+// RenderTexture, on a fixed-step game clock, and prints a JSON report.
+//
+//   Benchmark [--fast] [--steps N] [--paths] [--zero-alloc] [--texture-budget MB]
+//             [--out report.json]
+//
+//   --fast   advance as soon as a line has finished typing instead of waiting for
+//            auto-forward (same frames per character, far fewer idle frames)
+//   --steps  60 Hz updates per rendered frame (default 1); higher values get through
+//            the story in fewer frames, at N times the simulated speed
+//   --paths  bot mode: play every route through the choice graph from the start,
+//            each with cold texture, sound and glyph caches, and report per route
+//            what it loaded and how long each choice click took to show the next
+//            line. Clicks slower than one frame are flagged as stalls, and make
+//            the exit status 3. Also checks that loading a save from the pause
+//            menu exits the game underneath before resuming (exit status 5 if not).
+//   --zero-alloc  fail (exit status 4) if any steady-state frame allocates. A frame
+//            is steady when no line, menu, node or chapter started and no timeline
+//            event fired in it; typing a line out, hovering and auto-forward
+//            waits all count.
+//   --texture-budget  texture cache budget in megabytes, to see how a low-memory
+//            machine gets on: routes report how many textures were evicted or
+//            loaded at a reduced resolution
+//
+// Audio goes to OpenAL Soft's null device. On Linux, run it under Mesa without a
+// display, e.g.:  LIBGL_ALWAYS_SOFTWARE=1 xvfb-run ./Benchmark --out report.json
+//
+// Frame times are CPU time for update + draw + RenderTexture::display().
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "BackgroundManager.h"
+#include "Camera.h"
+#include "TimelinePlayer.h"
+#include "ParticleSystem.h"
+#include "DialogueBox.h"
+#include "ChoiceBox.h"
+#include "WidgetLayer.h"
+#include "PortraitStage.h"
+#include "SoundManager.h"
+#include "StoryScript.h"
+#include "StoryPlayer.h"
+#include "StoryVariables.h"
+#include "TextureCache.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include "GameClock.h"
+#include "ScreenStack.h"
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    const float timeStep = 1.0f / 60.0f;
+    const std::size_t maxFramesPerNode = 200000;   // Guards against a node that never ends
+
+    std::size_t peakMemoryBytes() {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return counters.PeakWorkingSetSize;
+        return 0;
+#else
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        return static_cast<std::size_t>(usage.ru_maxrss) * 1024;   // Linux reports KiB
+#endif
+    }
+
+    void useNullAudioDevice() {
+#ifdef _WIN32
+        _putenv_s("ALSOFT_DRIVERS", "null");
+#else
+        setenv("ALSOFT_DRIVERS", "null", 0);
+#endif
+    }
+
+    std::string jsonString(const std::string& text) {
+        std::string out = "\"";
+        for (char c : text) {
+            if (c == '"' || c == '\\') { out += '\\'; out += c; }
+            else if (c == '\n') out += "\\n";
+            else if (static_cast<unsigned char>(c) >= 0x20) out += c;
+        }
+        return out + "\"";
+    }
+
+    double percentile(std::vector<double> values, double percent) {
+        if (values.empty()) return 0.0;
+        std::size_t rank = static_cast<std::size_t>(percent / 100.0 * (values.size() - 1) + 0.5);
+        std::nth_element(values.begin(), values.begin() + rank, values.end());
+        return values[rank];
+    }
+
+    // Current resident set, unlike peakMemoryBytes() which only ever goes up
+    std::size_t residentBytes() {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return counters.WorkingSetSize;
+        return 0;
+#else
+        std::ifstream statm("/proc/self/statm");
+        std::size_t pages = 0, resident = 0;
+        statm >> pages >> resident;
+        return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+    }
+
+    // A steady-state frame that allocated, with the scopes the allocations came from
+    struct AllocatingFrame {
+        std::size_t frame = 0;
+        std::string node;
+        std::size_t line = 0;
+        unsigned allocations = 0;
+        unsigned bytes = 0;
+        std::vector<std::pair<const char*, unsigned>> scopes;
+    };
+
+    struct Hitch {
+        double ms = 0.0;
+        std::size_t frame = 0;
+        std::string node;
+        std::size_t line = 0;
+    };
+
+    // One step of a route: the node whose menu it's at, and its choice taken there
+    struct RouteStep {
+        std::string node;
+        std::size_t choice;
+    };
+
+    // One route from the first node to an ending: the option taken at each menu
+    using StoryPath = std::vector<RouteStep>;
+
+    struct ClickTiming {
+        std::string node;
+        std::string choice;
+        std::string next;
+        double ms = 0.0;            // Click until the next line's first frame is done
+        unsigned cacheMisses = 0;
+        unsigned cacheWaits = 0;
+        bool stalled = false;
+    };
+
+    struct PathResult {
+        std::string route;
+        std::vector<ClickTiming> clicks;
+        std::vector<std::string> textures;
+        std::vector<std::string> sounds;
+        TextureCacheStats cache;
+        std::size_t frames = 0;
+        std::size_t peakResidentBytes = 0;
+        std::size_t peakTextureBytes = 0;
+        std::size_t peakParticles = 0;
+        bool stalled = false;
+    };
+
+    // Every route through the graph. A choice that leads back to a node already on
+    // the route ends it there. JUMP cues are followed; one with a condition might not
+    // be taken, so the node's own ending is a route too. Conditions can't be known
+    // here, so some routes may turn out not to be playable (see playPath).
+    void enumeratePaths(const std::string& nodeId, StoryPath& prefix,
+        std::vector<std::string>& onRoute, std::vector<StoryPath>& paths) {
+        ScriptNode node;
+        if (std::find(onRoute.begin(), onRoute.end(), nodeId) != onRoute.end() ||
+            !StoryScript::loadNode(nodeId, node)) {
+            paths.push_back(prefix);
+            return;
+        }
+        onRoute.push_back(nodeId);
+
+        bool alwaysJumps = false;
+        for (const ScriptCue& cue : node.cues) {
+            if (cue.type != CueType::JUMP) continue;
+            enumeratePaths(cue.argument, prefix, onRoute, paths);
+            if (cue.condition.empty()) {
+                alwaysJumps = true;
+                break;
+            }
+        }
+
+        auto chapter = std::find_if(node.cues.begin(), node.cues.end(),
+            [](const ScriptCue& cue) { return cue.type == CueType::CHAPTER; });
+        if (alwaysJumps) {
+            // Nothing past the jump is reached
+        }
+        else if (chapter != node.cues.end()) {
+            enumeratePaths(chapter->argument, prefix, onRoute, paths);
+        }
+        else if (node.choices.empty()) {
+            paths.push_back(prefix);
+        }
+        else {
+            for (std::size_t i = 0; i < node.choices.size(); ++i) {
+                prefix.push_back({ nodeId, i });
+                enumeratePaths(node.choices[i].nextNode, prefix, onRoute, paths);
+                prefix.pop_back();
+            }
+        }
+        onRoute.pop_back();
+    }
+
+    // Stands in for a screen in checkResumeOrder, noting what the stack calls on it.
+    // A queued resume runs from onEnter, as in GameplayScreen.
+    class RecordingScreen : public Screen {
+    public:
+        RecordingScreen(const std::string& name, bool overlay, std::vector<std::string>& calls)
+            : name(name), overlay(overlay), calls(calls) {
+        }
+
+        void queueResume() { resumeQueued = true; }
+
+        void onEnter() override {
+            calls.push_back(name + " enter");
+            if (resumeQueued) {
+                resumeQueued = false;
+                calls.push_back(name + " resume");
+            }
+        }
+        void onExit() override { calls.push_back(name + " exit"); }
+        void handleEvent(const sf::Event&) override {}
+        void update(float) override {}
+        void draw(sf::RenderTarget&) override {}
+        bool isOverlay() const override { return overlay; }
+
+    private:
+        std::string name;
+        bool overlay;
+        bool resumeQueued = false;
+        std::vector<std::string>& calls;
+    };
+
+    // Pause -> Load -> Load Saved Game, the way Game drives the stack. The gameplay
+    // under the menus has to exit (saving where it was, stopping its timeline and
+    // music) before the save is read, or it would undo the resume.
+    bool checkResumeOrder() {
+        std::vector<std::string> calls;
+        RecordingScreen gameplay("gameplay", false, calls);
+        RecordingScreen pause("pause", true, calls);
+        RecordingScreen load("load", false, calls);
+        ScreenStack screens;
+        screens.add(GameState::GAMEPLAY, gameplay);
+        screens.add(GameState::PAUSE, pause);
+        screens.add(GameState::LOAD, load);
+
+        screens.switchTo(GameState::GAMEPLAY);
+        screens.push(GameState::PAUSE);
+        screens.push(GameState::LOAD);
+        screens.applyPendingChanges();
+        calls.clear();
+
+        gameplay.queueResume();
+        screens.switchTo(GameState::GAMEPLAY);
+        screens.applyPendingChanges();
+
+        std::vector<std::string> expected = {
+            "load exit", "pause exit", "gameplay exit", "gameplay enter", "gameplay resume"
+        };
+        if (calls == expected && screens.isOnTop(GameState::GAMEPLAY) && screens.getDepth() == 1)
+            return true;
+
+        std::cerr << "Resuming from the pause menu went:";
+        for (const std::string& call : calls)
+            std::cerr << " " << call << ";";
+        std::cerr << "\n";
+        return false;
+    }
+}
+
+// Owns the systems and walks the story graph
+class Benchmark {
+public:
+    Benchmark(sf::RenderTexture& target, sf::Font& font, bool fast, unsigned stepsPerFrame)
+        : target(target), fast(fast), stepsPerFrame(stepsPerFrame),
+        background(target), ui(target), dialogue(target, font, ui), choices(target, font, ui), stage(target), camera(sf::Vector2f(target.getSize())),
+        timelines(target, font, background, stage, camera, SoundManager::getInstance()),
+        story(background, dialogue, choices, stage, camera, timelines, particles, SoundManager::getInstance())
+    {
+        loadSound("ECH1", "ECH1.ogg");
+
+        clock.setFixedStep(timeStep, stepsPerFrame);
+        dialogue.setAutoForward(!fast);
+        story.onChapter = [this](const ScriptCue& cue) { pendingChapter = cue.argument; };
+        story.onTriggerTimed = [this](const TriggerTiming& timing) { triggers.push_back(timing); };
+    }
+
+    void run() {
+        StoryVariables::getInstance().reset();
+        ScriptNode first;
+        StoryScript::loadNode(StoryScript::firstNode, first);
+        startNode(first, 0, true);
+        explore();
+    }
+
+    // Bot mode: follow one route, clicking the given option at each menu
+    PathResult playPath(const StoryPath& path);
+
+    std::size_t getAllocatingFrameCount() const { return allocatingFrames.size(); }
+    void writeReport(std::ostream& out) const;
+
+private:
+    enum class Stop { END, CHOICE, CHAPTER };
+
+    // Play the node on screen until it ends, offers a choice or hands over to a chapter
+    Stop runUntilStop();
+    void frame();
+    void explore();
+    void loadChapter(const std::string& nodeId);
+    void loadSound(const std::string& name, const std::string& file);
+    void startNode(const ScriptNode& node, std::size_t firstLine = 0, bool newChapter = false);
+    // By its place in the node's choices; false if the menu doesn't offer it
+    bool selectChoice(std::size_t index);
+
+    sf::RenderTexture& target;
+    bool fast;
+    unsigned stepsPerFrame;
+    GameClock clock;
+    float accumulator = 0.0f;
+
+    BackgroundManager background;
+    WidgetLayer ui;             // Never gets a mouse event, so nothing is ever hovered
+    DialogueBox dialogue;
+    ChoiceBox choices;
+    PortraitStage stage;
+    Camera camera;
+    TimelinePlayer timelines;
+    ParticleSystem particles;   // No cursor here, so nothing pushes the smoke
+    StoryPlayer story;
+
+    std::string pendingChapter;
+    std::set<std::string> visited;
+    std::size_t choicesTaken = 0;
+    std::size_t linesShown = 0;
+
+    std::vector<double> frameTimes;     // Milliseconds
+    std::vector<unsigned> frameAllocations;
+    std::vector<TriggerTiming> triggers;
+    Hitch worst;
+
+    std::vector<std::string> soundsLoaded;
+    std::size_t peakResident = 0;
+    std::size_t peakTextureBytes = 0;
+    std::size_t peakParticles = 0;
+
+    // Anything the bench does to the story between frames makes the next one a transition
+    std::size_t transitions = 0;
+    std::size_t transitionsSeen = 0;
+    std::size_t steadyFrames = 0;
+    std::vector<AllocatingFrame> allocatingFrames;
+};
+
+void Benchmark::frame() {
+    std::size_t linesBefore = dialogue.getLinesStarted();
+    bool choicesBefore = choices.isVisible();
+    std::size_t eventsBefore = timelines.getEventsFired();
+    bool transition = transitions != transitionsSeen;
+    transitionsSeen = transitions;
+
+    Profiler::getInstance().beginFrame();
+    auto start = std::chrono::steady_clock::now();
+
+    accumulator += clock.tick();
+    while (accumulator >= timeStep) {
+        background.update(timeStep);
+        timelines.update(timeStep);
+        camera.update(timeStep);
+        stage.update(timeStep);
+        particles.update(timeStep);
+        dialogue.update(timeStep);
+        ui.update();
+        story.update();
+        accumulator -= timeStep;
+    }
+    JobSystem::getInstance().runMainThreadJobs(0.004f);
+
+    target.clear(sf::Color::Black);
+    background.draw(camera.getView());
+    target.setView(camera.getView());
+    stage.draw(target);
+    particles.draw(target);
+    target.setView(target.getDefaultView());
+    dialogue.draw();
+    choices.draw(target);
+    timelines.draw();
+    target.display();
+
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    Profiler::getInstance().endFrame();
+
+    frameTimes.push_back(ms);
+    frameAllocations.push_back(Profiler::getInstance().getCounter(ProfileCounter::Allocations));
+    if (ms > worst.ms) {
+        worst.ms = ms;
+        worst.frame = frameTimes.size() - 1;
+        worst.node = story.getNode().id;
+        worst.line = story.getLineIndex();
+    }
+    if (dialogue.getLinesStarted() > linesBefore)
+        linesShown += dialogue.getLinesStarted() - linesBefore;
+
+    bool steady = !transition && dialogue.getLinesStarted() == linesBefore
+        && choices.isVisible() == choicesBefore && pendingChapter.empty()
+        && timelines.getEventsFired() == eventsBefore;
+    if (steady) {
+        ++steadyFrames;
+        const Profiler& profiler = Profiler::getInstance();
+        if (profiler.getCounter(ProfileCounter::Allocations) > 0) {
+            AllocatingFrame allocating;
+            allocating.frame = frameTimes.size() - 1;
+            allocating.node = story.getNode().id;
+            allocating.line = story.getLineIndex();
+            allocating.allocations = profiler.getCounter(ProfileCounter::Allocations);
+            allocating.bytes = profiler.getCounter(ProfileCounter::AllocatedBytes);
+            for (std::size_t i = 0; i < Profiler::scopeCount; ++i) {
+                ProfileScope scope = static_cast<ProfileScope>(i);
+                if (profiler.getScopeAllocations(scope) > 0)
+                    allocating.scopes.push_back({ Profiler::getTraceName(scope), profiler.getScopeAllocations(scope) });
+            }
+            allocatingFrames.push_back(allocating);
+        }
+    }
+
+    peakResident = std::max(peakResident, residentBytes());
+    peakTextureBytes = std::max(peakTextureBytes, TextureCache::getInstance().getMemoryBytes());
+    peakParticles = std::max(peakParticles, particles.getCount());
+}
+
+Benchmark::Stop Benchmark::runUntilStop() {
+    for (std::size_t i = 0; i < maxFramesPerNode; ++i) {
+        if (fast && dialogue.isVisible() && !dialogue.isTyping() && !choices.isVisible()) {
+            sf::Event space;
+            space.type = sf::Event::KeyPressed;
+            space.key.code = sf::Keyboard::Space;
+            dialogue.handleInput(space);
+            ++transitions;
+        }
+
+        frame();
+
+        if (!pendingChapter.empty()) return Stop::CHAPTER;
+        if (choices.isVisible()) return Stop::CHOICE;
+        if (!dialogue.isVisible()) return Stop::END;
+    }
+    std::cerr << "Node " << story.getNode().id << " did not finish\n";
+    return Stop::END;
+}
+
+void Benchmark::loadChapter(const std::string& nodeId) {
+    // What the chapter cards hide in the game, done synchronously so it can be timed
+    auto start = std::chrono::steady_clock::now();
+    ScriptNode node;
+    if (!StoryScript::loadNode(nodeId, node)) {
+        std::cerr << "Unknown script node: " << nodeId << "\n";
+        return;
+    }
+    TextureCache::getInstance().preload(background.getTextureKey(node.background));
+    for (const std::string& path : node.preloadBackgrounds)
+        TextureCache::getInstance().preload(background.getTextureKey(path));
+    for (const auto& character : node.characters)
+        TextureCache::getInstance().preload(stage.getTextureKey(character.second));
+    for (const auto& sound : node.sounds) {
+        if (!SoundManager::getInstance().hasSound(sound.first))
+            loadSound(sound.first, sound.second);
+    }
+    for (const DialogueEntry& line : node.lines)
+        dialogue.prewarmGlyphs(line);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    triggers.push_back({ "chapter", nodeId, seconds });
+
+    startNode(node, 0, true);
+}
+
+void Benchmark::startNode(const ScriptNode& node, std::size_t firstLine, bool newChapter) {
+    if (newChapter)
+        story.startChapter(node, firstLine);
+    else
+        story.start(node, firstLine);
+    ++transitions;
+}
+
+bool Benchmark::selectChoice(std::size_t index) {
+    const std::vector<std::size_t>& offered = story.getOfferedChoices();
+    auto option = std::find(offered.begin(), offered.end(), index);
+    if (option == offered.end())
+        return false;
+    choices.select(static_cast<std::size_t>(option - offered.begin()));
+    ++transitions;
+    return true;
+}
+
+void Benchmark::loadSound(const std::string& name, const std::string& file) {
+    if (SoundManager::getInstance().loadSound(name, file))
+        soundsLoaded.push_back(name);
+    else
+        std::cerr << "Failed to load " << file << "\n";
+}
+
+PathResult Benchmark::playPath(const StoryPath& path) {
+    TextureCache& cache = TextureCache::getInstance();
+    PathResult result;
+
+    // Every route starts from a new game's variables, so its choices come up the same
+    StoryVariables::getInstance().reset();
+    ScriptNode first;
+    StoryScript::loadNode(StoryScript::firstNode, first);
+    startNode(first, 0, true);
+    result.route = first.id;
+    std::string at = first.id;
+
+    std::size_t taken = 0;
+    for (;;) {
+        Stop stop = runUntilStop();
+        // Anywhere else now was reached by a JUMP cue
+        if (story.getNode().id != at) {
+            at = story.getNode().id;
+            result.route += " > " + at;
+        }
+        if (stop == Stop::CHAPTER) {
+            std::string next = pendingChapter;
+            pendingChapter.clear();
+            loadChapter(next);
+            result.route += " > " + next;
+            at = next;
+            continue;
+        }
+        if (stop == Stop::END || taken >= path.size())
+            break;
+
+        // The variables took the story somewhere the route didn't expect, or left
+        // its option off the menu
+        const ScriptNode& here = story.getNode();
+        const RouteStep& step = path[taken++];
+        if (here.id != step.node || step.choice >= here.choices.size()) {
+            result.route += " > (expected " + step.node + ")";
+            break;
+        }
+        ClickTiming click;
+        click.node = here.id;
+        click.choice = here.choices[step.choice].text;
+        click.next = here.choices[step.choice].nextNode;
+
+        TextureCacheStats before = cache.getStats();
+        auto start = std::chrono::steady_clock::now();
+        if (!selectChoice(step.choice)) {
+            result.route += " > [" + click.choice + "] (not offered)";
+            break;
+        }
+        frame();    // The first frame the player sees after clicking
+        click.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        click.cacheMisses = cache.getStats().misses - before.misses;
+        click.cacheWaits = cache.getStats().waits - before.waits;
+        click.stalled = click.ms > timeStep * 1000.0;
+
+        result.stalled = result.stalled || click.stalled;
+        result.route += " > [" + click.choice + "] " + click.next;
+        result.clicks.push_back(click);
+        at = click.next;
+    }
+
+    result.textures = cache.getLoadedPaths();
+    std::sort(result.textures.begin(), result.textures.end());
+    result.sounds = soundsLoaded;
+    result.cache = cache.getStats();
+    result.frames = frameTimes.size();
+    result.peakResidentBytes = peakResident;
+    result.peakTextureBytes = peakTextureBytes;
+    result.peakParticles = peakParticles;
+    return result;
+}
+
+void Benchmark::explore() {
+    visited.insert(story.getNode().id);
+
+    switch (runUntilStop()) {
+    case Stop::END:
+        return;
+
+    case Stop::CHAPTER: {
+        std::string next = pendingChapter;
+        pendingChapter.clear();
+        loadChapter(next);
+        explore();
+        return;
+    }
+
+    case Stop::CHOICE: {
+        // Take every option offered; each node is only played through the first time
+        ScriptNode here = story.getNode();
+        std::vector<std::size_t> offered = story.getOfferedChoices();
+        for (std::size_t i : offered) {
+            if (i != offered.front()) {
+                startNode(here, here.lines.size() - 1);
+                if (runUntilStop() != Stop::CHOICE) return;
+            }
+            if (!selectChoice(i)) continue;     // Not on the menu the second time round
+            ++choicesTaken;
+            if (!visited.count(here.choices[i].nextNode))
+                explore();
+        }
+        return;
+    }
+    }
+}
+
+void Benchmark::writeReport(std::ostream& out) const {
+    double total = 0.0;
+    for (double ms : frameTimes) total += ms;
+
+    out << "{\n";
+    out << "  \"mode\": " << jsonString(fast ? "fast" : "auto-forward") << ",\n";
+#ifdef _DEBUG
+    out << "  \"build\": \"debug\",\n";
+#else
+    out << "  \"build\": \"release\",\n";
+#endif
+    out << "  \"stepsPerFrame\": " << stepsPerFrame << ",\n";
+    out << "  \"frames\": " << frameTimes.size() << ",\n";
+    out << "  \"simulatedSeconds\": " << clock.getTime() << ",\n";
+    out << "  \"nodes\": " << visited.size() << ",\n";
+    out << "  \"lines\": " << linesShown << ",\n";
+    out << "  \"choicesTaken\": " << choicesTaken << ",\n";
+    out << "  \"frameTimeMs\": {"
+        << "\"mean\": " << (frameTimes.empty() ? 0.0 : total / frameTimes.size())
+        << ", \"p50\": " << percentile(frameTimes, 50.0)
+        << ", \"p95\": " << percentile(frameTimes, 95.0)
+        << ", \"p99\": " << percentile(frameTimes, 99.0)
+        << ", \"max\": " << worst.ms << "},\n";
+    out << "  \"worstHitch\": {\"ms\": " << worst.ms << ", \"frame\": " << worst.frame
+        << ", \"node\": " << jsonString(worst.node) << ", \"line\": " << worst.line << "},\n";
+
+#if BIRINGAN_PROFILE
+    unsigned allocations = 0, maxAllocations = 0;
+    for (unsigned count : frameAllocations) {
+        allocations += count;
+        maxAllocations = std::max(maxAllocations, count);
+    }
+    out << "  \"allocations\": {\"total\": " << allocations << ", \"maxPerFrame\": " << maxAllocations << "},\n";
+
+    out << "  \"steadyState\": {\"frames\": " << steadyFrames
+        << ", \"allocatingFrames\": " << allocatingFrames.size() << ", \"examples\": [";
+    for (std::size_t i = 0; i < allocatingFrames.size() && i < 10; ++i) {
+        const AllocatingFrame& allocating = allocatingFrames[i];
+        out << (i ? ",\n    " : "\n    ")
+            << "{\"frame\": " << allocating.frame
+            << ", \"node\": " << jsonString(allocating.node)
+            << ", \"line\": " << allocating.line
+            << ", \"allocations\": " << allocating.allocations
+            << ", \"bytes\": " << allocating.bytes << ", \"scopes\": {";
+        for (std::size_t j = 0; j < allocating.scopes.size(); ++j) {
+            out << (j ? ", " : "") << jsonString(allocating.scopes[j].first)
+                << ": " << allocating.scopes[j].second;
+        }
+        out << "}}";
+    }
+    out << (allocatingFrames.empty() ? "]},\n" : "\n  ]},\n");
+#endif
+
+    out << "  \"triggers\": [";
+    for (std::size_t i = 0; i < triggers.size(); ++i) {
+        out << (i ? ",\n    " : "\n    ")
+            << "{\"kind\": " << jsonString(triggers[i].kind)
+            << ", \"target\": " << jsonString(triggers[i].target)
+            << ", \"ms\": " << triggers[i].seconds * 1000.0 << "}";
+    }
+    out << "\n  ],\n";
+    out << "  \"chapterArena\": {\"peakBytes\": " << story.getArena().getPeakBytes()
+        << ", \"capacity\": " << story.getArena().getCapacity() << "},\n";
+    out << "  \"peakMemoryBytes\": " << peakMemoryBytes() << "\n";
+    out << "}\n";
+}
+
+void writePathReport(std::ostream& out, const std::vector<PathResult>& results) {
+    std::size_t stalledPaths = 0;
+    for (const PathResult& result : results) {
+        if (result.stalled) ++stalledPaths;
+    }
+
+    out << "{\n";
+    out << "  \"paths\": " << results.size() << ",\n";
+    out << "  \"stalledPaths\": " << stalledPaths << ",\n";
+    out << "  \"frameBudgetMs\": " << timeStep * 1000.0 << ",\n";
+    out << "  \"results\": [";
+    for (std::size_t p = 0; p < results.size(); ++p) {
+        const PathResult& result = results[p];
+        out << (p ? ",\n" : "\n");
+        out << "    {\"route\": " << jsonString(result.route) << ",\n";
+        out << "     \"stalled\": " << (result.stalled ? "true" : "false")
+            << ", \"frames\": " << result.frames
+            << ", \"peakResidentBytes\": " << result.peakResidentBytes
+            << ", \"peakTextureBytes\": " << result.peakTextureBytes
+            << ", \"peakParticles\": " << result.peakParticles << ",\n";
+        out << "     \"textureCache\": {\"hits\": " << result.cache.hits
+            << ", \"misses\": " << result.cache.misses
+            << ", \"waits\": " << result.cache.waits
+            << ", \"evictions\": " << result.cache.evictions
+            << ", \"reduced\": " << result.cache.reduced << "},\n";
+
+        out << "     \"textures\": [";
+        for (std::size_t i = 0; i < result.textures.size(); ++i)
+            out << (i ? ", " : "") << jsonString(result.textures[i]);
+        out << "],\n     \"sounds\": [";
+        for (std::size_t i = 0; i < result.sounds.size(); ++i)
+            out << (i ? ", " : "") << jsonString(result.sounds[i]);
+        out << "],\n     \"clicks\": [";
+        for (std::size_t i = 0; i < result.clicks.size(); ++i) {
+            const ClickTiming& click = result.clicks[i];
+            out << (i ? ",\n       " : "\n       ")
+                << "{\"node\": " << jsonString(click.node)
+                << ", \"choice\": " << jsonString(click.choice)
+                << ", \"next\": " << jsonString(click.next)
+                << ", \"timeToInteractiveMs\": " << click.ms
+                << ", \"cacheMisses\": " << click.cacheMisses
+                << ", \"cacheWaits\": " << click.cacheWaits
+                << ", \"stalled\": " << (click.stalled ? "true" : "false") << "}";
+        }
+        out << "]}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+int main(int argc, char* argv[]) {
+    bool fast = false;
+    bool paths = false;
+    bool zeroAlloc = false;
+    unsigned stepsPerFrame = 1;
+    std::size_t textureBudgetMb = 0;
+    std::string outPath;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--fast") == 0) fast = true;
+        else if (std::strcmp(argv[i], "--paths") == 0) paths = true;
+        else if (std::strcmp(argv[i], "--zero-alloc") == 0) zeroAlloc = true;
+        else if (std::strcmp(argv[i], "--steps") == 0 && i + 1 < argc) stepsPerFrame = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--texture-budget") == 0 && i + 1 < argc) textureBudgetMb = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc) outPath = argv[++i];
+        else {
+            std::cerr << "usage: Benchmark [--fast] [--steps N] [--paths] [--zero-alloc] [--texture-budget MB] [--out report.json]\n";
+            return 2;
+        }
+    }
+
+    useNullAudioDevice();
+    JobSystem::getInstance().start();
+    if (textureBudgetMb > 0)
+        TextureCache::getInstance().setBudget(textureBudgetMb * 1024 * 1024);
+
+    sf::RenderTexture target;
+    if (!target.create(1600, 900)) {
+        std::cerr << "Failed to create the offscreen render target\n";
+        return 1;
+    }
+
+    sf::Font font;
+    if (!font.loadFromFile("Railway.ttf")) {
+        std::cerr << "Failed to load Railway.ttf\n";
+        return 1;
+    }
+
+    std::ofstream file;
+    if (!outPath.empty()) {
+        file.open(outPath);
+        if (!file) {
+            std::cerr << "Failed to write " << outPath << "\n";
+            return 1;
+        }
+    }
+    std::ostream& out = outPath.empty() ? std::cout : file;
+
+    if (!paths) {
+        Benchmark benchmark(target, font, fast, stepsPerFrame);
+        benchmark.run();
+        JobSystem::getInstance().shutdown();
+        benchmark.writeReport(out);
+#if BIRINGAN_PROFILE
+        if (zeroAlloc && benchmark.getAllocatingFrameCount() > 0) {
+            std::cerr << benchmark.getAllocatingFrameCount() << " steady-state frames allocated\n";
+            return 4;
+        }
+#else
+        if (zeroAlloc) {
+            std::cerr << "--zero-alloc needs a build with BIRINGAN_PROFILE=1\n";
+            return 2;
+        }
+#endif
+        return 0;
+    }
+
+    if (!checkResumeOrder())
+        return 5;
+
+    std::vector<StoryPath> routes;
+    StoryPath prefix;
+    std::vector<std::string> onRoute;
+    enumeratePaths(StoryScript::firstNode, prefix, onRoute, routes);
+
+    std::vector<PathResult> results;
+    for (const StoryPath& route : routes) {
+        // Start every route from cold caches, the way a player starting the game would
+        TextureCache::getInstance().clear();
+        TextureCache::getInstance().resetStats();
+        SoundManager::getInstance().unloadSounds();
+        sf::Font routeFont;
+        if (!routeFont.loadFromFile("Railway.ttf")) {
+            std::cerr << "Failed to load Railway.ttf\n";
+            return 1;
+        }
+
+        Benchmark benchmark(target, routeFont, fast, stepsPerFrame);
+        results.push_back(benchmark.playPath(route));
+    }
+    JobSystem::getInstance().shutdown();
+    writePathReport(out, results);
+
+    // Non-zero when a click stalled, so a script can fail on it
+    for (const PathResult& result : results) {
+        if (result.stalled) return 3;
+    }
+    return 0;
+}
@@ -0,0 +1,112 @@
+#include "Camera.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    const float degreesToRadians = 3.14159265f / 180.0f;
+
+    float smoothstep(float t) {
+        return t * t * (3.0f - 2.0f * t);
+    }
+
+    float lerp(float a, float b, float t) {
+        return a + (b - a) * t;
+    }
+
+    // Sums of sines at unrelated frequencies: never repeats visibly, and the same
+    // time always gives the same offset, so benchmark runs stay comparable
+    float noise(float t, float a, float b, float phase) {
+        return 0.6f * std::sin(t * a + phase) + 0.4f * std::sin(t * b + phase * 2.3f);
+    }
+}
+
+Camera::Camera(const sf::Vector2f& screenSize)
+    : screenSize(screenSize) {
+    updateView();
+}
+
+void Camera::play(const std::vector<CameraKeyframe>& moves) {
+    keyframes = moves;
+    next = 0;
+    moveTime = 0.0f;
+    from = pose;
+    update(0.0f);
+}
+
+void Camera::setPose(const CameraPose& newPose) {
+    keyframes.clear();
+    next = 0;
+    pose = newPose;
+    updateView();
+}
+
+void Camera::reset() {
+    setPose(CameraPose());
+}
+
+void Camera::update(float deltaTime) {
+    shakeTime += deltaTime;
+
+    if (next < keyframes.size()) {
+        moveTime += deltaTime;
+
+        // Keyframes whose time has passed (several, after a long frame)
+        while (next < keyframes.size() && moveTime >= keyframes[next].time) {
+            from = keyframes[next].pose;
+            ++next;
+        }
+        if (next < keyframes.size()) {
+            float start = next > 0 ? keyframes[next - 1].time : 0.0f;
+            const CameraPose& to = keyframes[next].pose;
+            float t = smoothstep((moveTime - start) / (keyframes[next].time - start));
+            pose.pan = from.pan + (to.pan - from.pan) * t;
+            pose.zoom = lerp(from.zoom, to.zoom, t);
+            pose.rotation = lerp(from.rotation, to.rotation, t);
+            pose.shake = lerp(from.shake, to.shake, t);
+        }
+        else {
+            pose = from;
+        }
+    }
+
+    updateView();
+}
+
+const CameraPose& Camera::getPose() const {
+    return pose;
+}
+
+bool Camera::isMoving() const {
+    return next < keyframes.size();
+}
+
+const sf::View& Camera::getView() const {
+    return view;
+}
+
+void Camera::updateView() {
+    sf::Vector2f offset = pose.pan;
+    float rotation = pose.rotation;
+    if (pose.shake > 0.0f) {
+        offset.x += pose.shake * noise(shakeTime, 31.0f, 53.0f, 0.0f);
+        offset.y += pose.shake * noise(shakeTime, 37.0f, 47.0f, 1.7f);
+        rotation += pose.shake * 0.08f * noise(shakeTime, 23.0f, 41.0f, 2.9f);
+    }
+
+    float zoom = std::max(pose.zoom, coverZoom(offset, rotation));
+    view.setCenter(screenSize / 2.0f + offset);
+    view.setSize(screenSize / zoom);
+    view.setRotation(rotation);
+}
+
+// Smallest zoom at which the view, moved and tilted, still lies inside the screen
+// (the area the background is scaled to fill)
+float Camera::coverZoom(const sf::Vector2f& offset, float rotation) const {
+    float angle = std::abs(rotation) * degreesToRadians;
+    float c = std::cos(angle);
+    float s = std::sin(angle);
+    sf::Vector2f half = screenSize / 2.0f;
+    float roomX = std::max(half.x - std::abs(offset.x), 1.0f);
+    float roomY = std::max(half.y - std::abs(offset.y), 1.0f);
+    return std::max((half.x * c + half.y * s) / roomX, (half.x * s + half.y * c) / roomY);
+}
@@ -0,0 +1,53 @@
+#ifndef CAMERA_HPP
+#define CAMERA_HPP
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+// Where the camera is looking, relative to the plain screen view
+struct CameraPose {
+    sf::Vector2f pan;       // Screen pixels the middle of the view moves by
+    float zoom = 1.0f;      // 2 shows half as much
+    float rotation = 0.0f;  // Degrees
+    float shake = 0.0f;     // Amplitude of the jitter, in screen pixels
+};
+
+struct CameraKeyframe {
+    float time;             // Seconds from the start of the move
+    CameraPose pose;
+};
+
+// The view the background and the portrait are drawn through. A move eases from
+// wherever the camera is to each keyframe in turn; shake is noise laid on top of the
+// pose. Moving the camera only changes the view transform: nothing is reloaded or
+// drawn twice. The zoom is raised as far as needed to keep the screen covered, so a
+// pan, tilt or shake never shows past the edge of the background.
+class Camera {
+public:
+    explicit Camera(const sf::Vector2f& screenSize);
+
+    // Starts a move from the current pose; a keyframe at time 0 is a cut
+    void play(const std::vector<CameraKeyframe>& keyframes);
+    void setPose(const CameraPose& pose);   // Cut straight there, dropping any move
+    void reset();                           // Back to the plain screen view
+    void update(float deltaTime);
+
+    const CameraPose& getPose() const;
+    bool isMoving() const;
+    const sf::View& getView() const;
+
+private:
+    void updateView();
+    float coverZoom(const sf::Vector2f& offset, float rotation) const;
+
+    sf::Vector2f screenSize;
+    CameraPose pose;
+    CameraPose from;                        // Pose when the current keyframe was started
+    std::vector<CameraKeyframe> keyframes;  // Reused for every move
+    std::size_t next = 0;                   // Keyframe being eased towards
+    float moveTime = 0.0f;
+    float shakeTime = 0.0f;                 // Keeps running between moves so the noise doesn't restart
+    sf::View view;
+};
+
+#endif // CAMERA_HPP
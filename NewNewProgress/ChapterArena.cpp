@@ -0,0 +1,78 @@
+#include "ChapterArena.h"
+#include <algorithm>
+#include <cstring>
+
+ChapterArena::ChapterArena(std::size_t blockSize)
+    : blockSize(blockSize) {
+}
+
+void* ChapterArena::allocate(std::size_t size, std::size_t alignment) {
+    if (blocks.empty())
+        addBlock(size + alignment);
+
+    for (;;) {
+        Block& block = blocks[currentBlock];
+        std::size_t address = reinterpret_cast<std::size_t>(block.memory.get()) + offset;
+        std::size_t padding = (alignment - address % alignment) % alignment;
+
+        if (offset + padding + size <= block.size) {
+            void* result = block.memory.get() + offset + padding;
+            offset += padding + size;
+            bytesUsed += padding + size;
+            peakBytes = std::max(peakBytes, bytesUsed);
+            return result;
+        }
+
+        // Move on to the next block, reusing one left over from an earlier chapter
+        offset = 0;
+        if (currentBlock + 1 < blocks.size() && blocks[currentBlock + 1].size >= size + alignment)
+            ++currentBlock;
+        else
+            addBlock(size + alignment);
+    }
+}
+
+const char* ChapterArena::copyString(const std::string& text) {
+    char* copy = static_cast<char*>(allocate(text.size() + 1, 1));
+    std::memcpy(copy, text.c_str(), text.size() + 1);
+    return copy;
+}
+
+void ChapterArena::reset() {
+    // A chapter that spilled into several blocks gets one block big enough for all of
+    // it next time, so the next chapter's data sits together
+    if (blocks.size() > 1) {
+        std::size_t total = 0;
+        for (const Block& block : blocks)
+            total += block.size;
+        blocks.clear();
+        addBlock(total);
+    }
+    currentBlock = 0;
+    offset = 0;
+    bytesUsed = 0;
+}
+
+std::size_t ChapterArena::getBytesUsed() const {
+    return bytesUsed;
+}
+
+std::size_t ChapterArena::getPeakBytes() const {
+    return peakBytes;
+}
+
+std::size_t ChapterArena::getCapacity() const {
+    std::size_t total = 0;
+    for (const Block& block : blocks)
+        total += block.size;
+    return total;
+}
+
+void ChapterArena::addBlock(std::size_t minimumSize) {
+    std::size_t size = std::max(blockSize, minimumSize);
+    Block block;
+    block.memory.reset(new char[size]);
+    block.size = size;
+    blocks.push_back(std::move(block));
+    currentBlock = blocks.size() - 1;
+}
@@ -0,0 +1,58 @@
+#ifndef CHAPTERARENA_HPP
+#define CHAPTERARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Monotonic allocator for data that lives exactly as long as a chapter: allocating
+// is a pointer bump, nothing is freed one at a time, and reset() drops everything at
+// once when the chapter ends. Memory is kept between chapters, so after the first
+// few the arena stops asking the heap for anything. Main thread only.
+class ChapterArena {
+public:
+    explicit ChapterArena(std::size_t blockSize = 64 * 1024);
+
+    void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+    // Uninitialized storage for count objects; no destructors ever run, so only for
+    // plain data
+    template <typename T>
+    T* allocateArray(std::size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value, "arena objects are never destroyed");
+        return static_cast<T*>(allocate(sizeof(T) * (count ? count : 1), alignof(T)));
+    }
+
+    // Null-terminated copy that stays valid until reset()
+    const char* copyString(const std::string& text);
+
+    // Everything handed out so far becomes invalid
+    void reset();
+
+    std::size_t getBytesUsed() const;   // Since the last reset: the chapter's footprint
+    std::size_t getPeakBytes() const;   // Largest chapter so far
+    std::size_t getCapacity() const;
+
+    // Prevent copying
+    ChapterArena(const ChapterArena&) = delete;
+    ChapterArena& operator=(const ChapterArena&) = delete;
+
+private:
+    struct Block {
+        std::unique_ptr<char[]> memory;
+        std::size_t size;
+    };
+
+    void addBlock(std::size_t minimumSize);
+
+    std::size_t blockSize;
+    std::vector<Block> blocks;
+    std::size_t currentBlock = 0;
+    std::size_t offset = 0;         // Into the current block
+    std::size_t bytesUsed = 0;
+    std::size_t peakBytes = 0;
+};
+
+#endif // CHAPTERARENA_HPP
@@ -1,35 +1,106 @@
-#include "CharacterPortrait.h"
-
-bool CharacterPortrait::load(const std::string& filename) {
-    if (!texture.loadFromFile(filename)) {
-        return false;
-    }
-    sprite.setTexture(texture);
-    return true;
-}
-
-void CharacterPortrait::setPosition(float x, float y) {
-    sprite.setPosition(x, y);
-}
-
-void CharacterPortrait::setScale(float scaleX, float scaleY) {
-    sprite.setScale(scaleX, scaleY);
-}
-
-void CharacterPortrait::draw(sf::RenderWindow& window) {
-    if (visible) {
-        window.draw(sprite);
-    }
-}
-
-void CharacterPortrait::setVisible(bool vis) {
-    visible = vis;
-}
-
-bool CharacterPortrait::isVisible() const {
-    return visible;
-}
-
-sf::FloatRect CharacterPortrait::getGlobalBounds() const {
-    return sprite.getGlobalBounds(); 
+#include "CharacterPortrait.h"
+#include "Profiler.h"
+#include "TextureCache.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+std::string CharacterPortrait::getTextureKey(const CharacterSheet& sheet, sf::Vector2u windowSize) {
+    unsigned columns = std::max(1u, sheet.columns);
+    unsigned frames = std::max<unsigned>(1, static_cast<unsigned>(sheet.expressions.size()));
+    unsigned rows = (frames + columns - 1) / columns;
+    if (sheet.frameSize.y == 0)
+        return sheet.texture;
+
+    // A frame is drawn sheet.height of the window tall; the sheet never grows past its own size
+    float scale = std::min(1.0f, sheet.height * windowSize.y / sheet.frameSize.y);
+    sf::Vector2u footprint(
+        static_cast<unsigned>(std::ceil(sheet.frameSize.x * columns * scale)),
+        static_cast<unsigned>(std::ceil(sheet.frameSize.y * rows * scale)));
+    return TextureCache::fittedKey(sheet.texture, footprint, FitMode::LETTERBOX);
+}
+
+bool CharacterPortrait::load(const CharacterSheet& characterSheet, sf::Vector2u windowSize) {
+    TextureCache& cache = TextureCache::getInstance();
+    std::string key = getTextureKey(characterSheet, windowSize);
+    texture = cache.get(key);
+    if (!texture) {
+        std::cerr << "Failed to load character sheet: " << characterSheet.texture << "\n";
+        return false;
+    }
+    sheet = characterSheet;
+
+    // Frames are given in the image's own pixels; the texture is smaller
+    sf::Vector2u source = cache.getSourceSize(key);
+    texelScale = sf::Vector2f(static_cast<float>(texture->getSize().x) / source.x,
+        static_cast<float>(texture->getSize().y) / source.y);
+    sprite.setTexture(*texture);
+
+    std::string keep = expression;
+    expression.clear();
+    if (keep.empty() || !setExpression(keep))
+        setExpression(sheet.expressions.empty() ? std::string() : sheet.expressions.front());
+    return true;
+}
+
+bool CharacterPortrait::setExpression(const std::string& name) {
+    std::size_t frame = 0;
+    if (!sheet.expressions.empty()) {
+        auto found = std::find(sheet.expressions.begin(), sheet.expressions.end(), name);
+        if (found == sheet.expressions.end())
+            return false;
+        frame = found - sheet.expressions.begin();
+    }
+    expression = name;
+
+    // Edges rounded on their own, so neighbouring frames never overlap or leave a gap
+    unsigned columns = std::max(1u, sheet.columns);
+    unsigned column = static_cast<unsigned>(frame % columns);
+    unsigned row = static_cast<unsigned>(frame / columns);
+    float frameWidth = sheet.frameSize.x * texelScale.x;
+    float frameHeight = sheet.frameSize.y * texelScale.y;
+    int left = static_cast<int>(std::lround(column * frameWidth));
+    int top = static_cast<int>(std::lround(row * frameHeight));
+    int right = static_cast<int>(std::lround((column + 1) * frameWidth));
+    int bottom = static_cast<int>(std::lround((row + 1) * frameHeight));
+    sprite.setTextureRect(sf::IntRect(left, top, right - left, bottom - top));
+    sprite.setOrigin((right - left) / 2.0f, static_cast<float>(bottom - top));
+    updateScale();
+    return true;
+}
+
+const std::string& CharacterPortrait::getExpression() const {
+    return expression;
+}
+
+void CharacterPortrait::setPosition(float x, float y) {
+    sprite.setPosition(x, y);
+}
+
+void CharacterPortrait::setHeight(float viewHeight) {
+    height = viewHeight;
+    updateScale();
+}
+
+void CharacterPortrait::setOpacity(float opacity) {
+    float alpha = std::max(0.0f, std::min(1.0f, opacity)) * 255.0f;
+    sprite.setColor(sf::Color(255, 255, 255, static_cast<sf::Uint8>(alpha + 0.5f)));
+}
+
+void CharacterPortrait::draw(sf::RenderTarget& target) {
+    if (!texture || sprite.getColor().a == 0)
+        return;
+    target.draw(sprite);
+    PROFILE_DRAW(sprite);
+}
+
+sf::FloatRect CharacterPortrait::getGlobalBounds() const {
+    return sprite.getGlobalBounds();
+}
+
+void CharacterPortrait::updateScale() {
+    int frameHeight = sprite.getTextureRect().height;
+    if (frameHeight <= 0) return;
+    float scale = height / frameHeight;
+    sprite.setScale(scale, scale);
 }
\ No newline at end of file
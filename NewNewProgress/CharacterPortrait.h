@@ -1,23 +1,47 @@
-#ifndef CHARACTER_PORTRAIT_H
-#define CHARACTER_PORTRAIT_H
-
-#include <SFML/Graphics.hpp>
-#include <string>
-
-class CharacterPortrait {
-public:
-    bool load(const std::string& filename);
-    void setPosition(float x, float y);
-    void setScale(float scaleX, float scaleY);
-    void draw(sf::RenderWindow& window);
-    void setVisible(bool visible);
-    bool isVisible() const;
-    sf::FloatRect getGlobalBounds() const; 
-
-private:
-    sf::Sprite sprite;
-    sf::Texture texture;
-    bool visible = false;
-};
-
+#ifndef CHARACTER_PORTRAIT_H
+#define CHARACTER_PORTRAIT_H
+
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+// One character's expressions, packed into a single image as a grid of equal frames
+struct CharacterSheet {
+    std::string texture;                    // TextureCache key, so "path|filters" works too
+    sf::Vector2u frameSize;                 // One frame, in the image's own pixels
+    unsigned columns = 1;                   // Frames across the sheet
+    std::vector<std::string> expressions;   // One per frame, along each row then down; the first is the default
+    float height = 0.8f;                    // Drawn this share of the screen tall
+};
+
+// A character drawn from its sheet. The whole sheet is one shared texture from
+// TextureCache, fitted to the size the frames are drawn at, so an expression is just
+// a texture rect: changing it loads and uploads nothing.
+class CharacterPortrait {
+public:
+    // The sheet fitted to a window of that many pixels, for loading and preloading
+    static std::string getTextureKey(const CharacterSheet& sheet, sf::Vector2u windowSize);
+
+    bool load(const CharacterSheet& sheet, sf::Vector2u windowSize);
+    bool setExpression(const std::string& expression);  // False if the sheet has no such frame
+    const std::string& getExpression() const;
+
+    void setPosition(float x, float y);     // Bottom middle of the frame, in view units
+    void setHeight(float height);           // In view units
+    void setOpacity(float opacity);         // 0 to 1
+    void draw(sf::RenderTarget& target);
+    sf::FloatRect getGlobalBounds() const;
+
+private:
+    void updateScale();
+
+    CharacterSheet sheet;
+    sf::Sprite sprite;
+    std::shared_ptr<const sf::Texture> texture;     // Fitted, and maybe at a reduced tier
+    sf::Vector2f texelScale = sf::Vector2f(1.0f, 1.0f);  // Texture pixels per image pixel
+    std::string expression;
+    float height = 0.0f;
+};
+
 #endif // CHARACTER_PORTRAIT_H
\ No newline at end of file
@@ -1,32 +1,39 @@
-#pragma once
-#include <SFML/Graphics.hpp>
-#include <vector>
-#include <functional>
-#include <string>
-
-struct Choice {
-    std::string text;
-    std::function<void()> action;
-};
-
-class ChoiceBox {
-public:
-    ChoiceBox(sf::RenderWindow& win, sf::Font& fnt);
-
-    void startChoices(const std::vector<Choice>& choices);
-    void handleEvent(const sf::Event& event);
-    void update();  // <--- NEW: handles hover
-    void draw(sf::RenderWindow& targetWindow);
-    bool isVisible() const;
-
-private:
-    sf::RenderWindow& window;
-    sf::Font& font;
-    bool active;
-
-    std::vector<Choice> currentChoices;
-    std::vector<sf::RectangleShape> boxes;
-    std::vector<sf::Text> texts;
-
-    void layoutChoices();
-};
\ No newline at end of file
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <functional>
+#include <string>
+#include "Widget.h"
+#include "WidgetLayer.h"
+
+struct Choice {
+    std::string text;
+    std::function<void()> action;
+};
+
+// The options at the end of a node, as a ListBox on the screen's WidgetLayer. While
+// they're up nothing else on the layer can be clicked.
+class ChoiceBox {
+public:
+    ChoiceBox(sf::RenderTarget& target, sf::Font& fnt, WidgetLayer& ui);
+
+    void startChoices(const std::vector<Choice>& choices);
+    void draw(sf::RenderTarget& targetWindow);
+    bool isVisible() const;
+    void hide();
+
+    std::size_t getChoiceCount() const;
+    void select(std::size_t index);     // Same as clicking the option
+
+private:
+    sf::RenderTarget& target;
+    sf::Font& font;
+    WidgetLayer& ui;
+    bool active;
+
+    std::vector<Choice> currentChoices;
+    std::vector<sf::String> labels;     // Reused for every menu
+    ListBox list;
+
+    void layoutChoices();
+};
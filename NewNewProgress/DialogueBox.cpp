@@ -1,242 +1,345 @@
-﻿#include "DialogueBox.h"
-#include <iostream>
-
-DialogueBox::DialogueBox(sf::RenderWindow& win, sf::Font& fnt)
-    : window(win), font(fnt), currentCharIndex(0), visible(false),
-    finishedTyping(false), typeSpeed(50.0f), hasBackgroundImage(false),
-    autoForwardEnabled(false), backPressed(false)
-{
-    sf::Vector2u windowSize = window.getSize();
-
-    float boxWidth = 900.0f;
-    float boxHeight = 150.0f;
-    background.setSize(sf::Vector2f(boxWidth, boxHeight));
-    background.setFillColor(sf::Color(0, 0, 0, 180));
-    background.setOutlineColor(sf::Color::White);
-    background.setOutlineThickness(2);
-
-    float boxX = (windowSize.x - boxWidth) / 2.0f;
-    float boxY = windowSize.y - boxHeight - 30.0f;
-    background.setPosition(boxX, boxY);
-
-    textDisplay.setFont(font);
-    textDisplay.setCharacterSize(22);
-    textDisplay.setFillColor(sf::Color::White);
-    textDisplay.setPosition(boxX + 20.0f, boxY + 20.0f);
-
-    // Speaker box
-    float speakerBoxWidth = 220.0f;
-    float speakerBoxHeight = 45.0f;
-    speakerBackground.setSize(sf::Vector2f(speakerBoxWidth, speakerBoxHeight));
-    speakerBackground.setFillColor(sf::Color(0, 0, 0, 200));
-    speakerBackground.setOutlineColor(sf::Color::White);
-    speakerBackground.setOutlineThickness(2);
-    speakerBackground.setPosition(boxX, boxY - speakerBoxHeight - 10.0f);
-
-    speakerText.setFont(font);
-    speakerText.setCharacterSize(20);
-    speakerText.setFillColor(sf::Color::White);
-    speakerText.setPosition(speakerBackground.getPosition().x + 10.0f, speakerBackground.getPosition().y + 8.0f);
-
-    // Right panel
-    float panelWidth = 80.0f;
-    float panelHeight = boxHeight;
-    rightPanel.setSize(sf::Vector2f(panelWidth, panelHeight));
-    rightPanel.setFillColor(sf::Color(0, 0, 0, 150));
-    rightPanel.setOutlineColor(sf::Color::White);
-    rightPanel.setOutlineThickness(2);
-    rightPanel.setPosition(boxX + boxWidth + 10.0f, boxY);
-
-    // Forward button
-    forwardButton.setSize(sf::Vector2f(60.0f, 30.0f));
-    forwardButton.setOutlineColor(sf::Color::White);
-    forwardButton.setOutlineThickness(1);
-    forwardButton.setPosition(rightPanel.getPosition().x + 10.0f, rightPanel.getPosition().y + 10.0f);
-
-    forwardText.setFont(font);
-    forwardText.setCharacterSize(14);
-    forwardText.setString("Auto");
-    forwardText.setFillColor(sf::Color::White);
-    forwardText.setPosition(forwardButton.getPosition().x + 10.0f, forwardButton.getPosition().y + 5.0f);
-
-    // Back button
-    backButton.setSize(sf::Vector2f(60.0f, 30.0f));
-    backButton.setOutlineColor(sf::Color::White);
-    backButton.setOutlineThickness(1);
-    backButton.setPosition(rightPanel.getPosition().x + 10.0f, forwardButton.getPosition().y + 40.0f);
-
-    backText.setFont(font);
-    backText.setCharacterSize(14);
-    backText.setString("Back");
-    backText.setFillColor(sf::Color::White);
-    sf::FloatRect backBounds = backText.getLocalBounds();
-    backText.setOrigin(backBounds.left + backBounds.width / 2.0f, backBounds.top + backBounds.height / 2.0f);
-    backText.setPosition(
-        backButton.getPosition().x + backButton.getSize().x / 2.0f,
-        backButton.getPosition().y + backButton.getSize().y / 2.0f
-    );
-}
-
-void DialogueBox::startDialogue(const std::vector<DialogueEntry>& entries) {
-    dialogues = std::queue<DialogueEntry>();
-    for (const auto& entry : entries)
-        dialogues.push(entry);
-    nextDialogue();
-    visible = true;
-    backPressed = false;
-}
-
-void DialogueBox::nextDialogue() {
-    if (dialogues.empty()) {
-        visible = false;
-        return;
-    }
-
-    DialogueEntry entry = dialogues.front();
-    dialogues.pop();
-    fullText = entry.text;
-    speakerName = entry.speaker;
-    currentCharIndex = 0;
-    textDisplay.setString("");
-    speakerText.setString(speakerName);
-    typeClock.restart();
-    advanceClock.restart();
-    finishedTyping = false;
-}
-
-void DialogueBox::update() {
-    if (!visible) return;
-
-    float elapsed = typeClock.getElapsedTime().asSeconds();
-    std::size_t targetCharIndex = static_cast<std::size_t>(elapsed * typeSpeed);
-
-    if (!finishedTyping && targetCharIndex > currentCharIndex) {
-        currentCharIndex = std::min(targetCharIndex, fullText.size());
-        textDisplay.setString(fullText.substr(0, currentCharIndex));
-
-        if (currentCharIndex >= fullText.size()) {
-            finishedTyping = true;
-            advanceClock.restart();  // Delay before auto-forward
-        }
-    }
-
-    if (autoForwardEnabled && finishedTyping && advanceClock.getElapsedTime().asSeconds() >= 1.0f) {
-        nextDialogue();
-    }
-
-    // Hover highlight + persistent state
-    sf::Vector2f mousePos = window.mapPixelToCoords(sf::Mouse::getPosition(window));
-
-    // Forward button
-    if (forwardButton.getGlobalBounds().contains(mousePos)) {
-        forwardButton.setFillColor(sf::Color(130, 130, 255)); // Hover blue
-    }
-    else {
-        forwardButton.setFillColor(autoForwardEnabled ? sf::Color(100, 100, 255) : sf::Color(50, 50, 50));
-    }
-
-    // Back button
-    if (backButton.getGlobalBounds().contains(mousePos)) {
-        backButton.setFillColor(sf::Color(255, 130, 130)); // Hover red
-    }
-    else {
-        backButton.setFillColor(backPressed ? sf::Color(200, 50, 50) : sf::Color(50, 50, 50));
-    }
-}
-
-void DialogueBox::draw() {
-    if (!visible) return;
-
-    window.draw(background);
-    window.draw(textDisplay);
-
-    if (!speakerName.empty()) {
-        window.draw(speakerBackground);
-        window.draw(speakerText);
-    }
-
-    window.draw(rightPanel);
-    window.draw(forwardButton);
-    window.draw(forwardText);
-    window.draw(backButton);
-    window.draw(backText);
-}
-
-void DialogueBox::handleInput(const sf::Event& event) {
-    if (!visible) return;
-
-    if (event.type == sf::Event::MouseButtonPressed) {
-        sf::Vector2f mousePos = window.mapPixelToCoords(sf::Mouse::getPosition(window));
-
-        if (forwardButton.getGlobalBounds().contains(mousePos)) {
-            autoForwardEnabled = !autoForwardEnabled;
-            return;
-        }
-
-        if (backButton.getGlobalBounds().contains(mousePos)) {
-            backPressed = true;
-            visible = false;
-            return;
-        }
-
-        if (!finishedTyping) {
-            textDisplay.setString(fullText);
-            currentCharIndex = fullText.size();
-            finishedTyping = true;
-        }
-        else {
-            nextDialogue();
-        }
-    }
-
-    if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Space) {
-        if (!finishedTyping) {
-            textDisplay.setString(fullText);
-            currentCharIndex = fullText.size();
-            finishedTyping = true;
-        }
-        else {
-            nextDialogue();
-        }
-    }
-}
-
-void DialogueBox::setBackground(const std::string& imagePath) {
-    if (backgroundTexture.loadFromFile(imagePath)) {
-        backgroundSprite.setTexture(backgroundTexture);
-        float scaleX = static_cast<float>(window.getSize().x) / backgroundTexture.getSize().x;
-        float scaleY = static_cast<float>(window.getSize().y) / backgroundTexture.getSize().y;
-        backgroundSprite.setScale(scaleX, scaleY);
-        hasBackgroundImage = true;
-    }
-    else {
-        std::cerr << "Failed to load image: " << imagePath << std::endl;
-        hasBackgroundImage = false;
-    }
-}
-
-void DialogueBox::drawBackground() {
-    if (hasBackgroundImage) {
-        window.draw(backgroundSprite);
-    }
-}
-
-bool DialogueBox::isVisible() const {
-    return visible;
-}
-
-bool DialogueBox::wasBackPressed() const {
-    return backPressed;
-}
-
-void DialogueBox::resetBackPressed() {
-    backPressed = false;
-}
-
-std::string DialogueBox::getCurrentDialogue() const {
-    return fullText;
-}
-
-std::string DialogueBox::getCurrentSpeaker() const {
-    return speakerName;
+﻿#include "DialogueBox.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <iostream>
+#include <set>
+
+DialogueBox::DialogueBox(sf::RenderTarget& target, sf::Font& fnt, WidgetLayer& ui)
+    : target(target), font(fnt), currentCharIndex(0), visible(false),
+    finishedTyping(false), typeSpeed(50.0f), hasBackgroundImage(false),
+    autoForwardEnabled(false), backPressed(false)
+{
+    sf::Vector2f windowSize = target.getDefaultView().getSize();
+
+    float boxWidth = 900.0f;
+    float boxHeight = 150.0f;
+    float boxX = (windowSize.x - boxWidth) / 2.0f;
+    float boxY = windowSize.y - boxHeight - 30.0f;
+    background.setup(sf::FloatRect(boxX, boxY, boxWidth, boxHeight), sf::Color(0, 0, 0, 180), sf::Color::White, 2);
+
+    textDisplay.setup(font, "", 22, sf::Color::White);
+    textDisplay.setPosition(boxX + 20.0f, boxY + 20.0f);
+
+    // Speaker box
+    float speakerBoxWidth = 220.0f;
+    float speakerBoxHeight = 45.0f;
+    float speakerY = boxY - speakerBoxHeight - 10.0f;
+    speakerBackground.setup(sf::FloatRect(boxX, speakerY, speakerBoxWidth, speakerBoxHeight),
+        sf::Color(0, 0, 0, 200), sf::Color::White, 2);
+
+    speakerText.setup(font, "", 20, sf::Color::White);
+    speakerText.setPosition(boxX + 10.0f, speakerY + 8.0f);
+
+    // Right panel
+    float panelWidth = 80.0f;
+    float panelHeight = boxHeight;
+    float panelX = boxX + boxWidth + 10.0f;
+    rightPanel.setup(sf::FloatRect(panelX, boxY, panelWidth, panelHeight), sf::Color(0, 0, 0, 150), sf::Color::White, 2);
+
+    // Forward button: blue while auto-forward is on
+    ButtonStyle off;
+    off.fill = sf::Color(50, 50, 50);
+    off.outline = sf::Color::White;
+    ButtonStyle forwardHover = off;
+    forwardHover.fill = sf::Color(130, 130, 255);
+    ButtonStyle forwardOn = off;
+    forwardOn.fill = sf::Color(100, 100, 255);
+    forwardButton.setup(font, "Auto", 14);
+    forwardButton.setBox(sf::FloatRect(panelX + 10.0f, boxY + 10.0f, 60.0f, 30.0f), 1);
+    forwardButton.setStyles(off, forwardHover, forwardOn);
+    forwardButton.onClick = [this]() { setAutoForward(!autoForwardEnabled); };
+
+    // Back button: stays red once pressed
+    ButtonStyle backHover = off;
+    backHover.fill = sf::Color(255, 130, 130);
+    ButtonStyle backOn = off;
+    backOn.fill = sf::Color(200, 50, 50);
+    backButton.setup(font, "Back", 14);
+    backButton.setBox(sf::FloatRect(panelX + 10.0f, boxY + 50.0f, 60.0f, 30.0f), 1);
+    backButton.setStyles(off, backHover, backOn);
+    backButton.onClick = [this]() {
+        backPressed = true;
+        backButton.setSelected(true);
+        setShown(false);
+    };
+
+    ui.add(background);
+    ui.add(textDisplay);
+    ui.add(speakerBackground);
+    ui.add(speakerText);
+    // Skip button: green while skipping read lines
+    ButtonStyle skipHover = off;
+    skipHover.fill = sf::Color(130, 200, 130);
+    ButtonStyle skipOn = off;
+    skipOn.fill = sf::Color(60, 160, 60);
+    skipButton.setup(font, "Skip", 14);
+    skipButton.setBox(sf::FloatRect(panelX + 10.0f, boxY + 90.0f, 60.0f, 30.0f), 1);
+    skipButton.setStyles(off, skipHover, skipOn);
+    skipButton.onClick = [this]() { if (onSkip) onSkip(); };
+
+    ui.add(rightPanel);
+    ui.add(forwardButton);
+    ui.add(backButton);
+    ui.add(skipButton);
+    setShown(false);
+}
+
+void DialogueBox::startDialogue(const DialogueLine* first, std::size_t count) {
+    lines = first;
+    lineCount = count;
+    nextLine = 0;
+    linesStarted = 0;
+    // Points into the chapter arena; a node with no lines mustn't keep the last chapter's
+    scriptText = "";
+    backPressed = false;
+    backButton.setSelected(false);
+    setShown(true);
+    nextDialogue();
+}
+
+void DialogueBox::prewarmGlyphs(const DialogueEntry& entry) {
+    // The glyphs of the line as it will be shown, names and all
+    const std::string* shown = &entry.text;
+    if (entry.text.find('[') != std::string::npos) {
+        TextVariables& variables = TextVariables::getInstance();
+        variables.expand(entry.text, variables.getSnapshot(), expandScratch);
+        shown = &expandScratch;
+    }
+
+    // Convert exactly the way sf::Text::setString will, so the same glyphs get cached
+    sf::String text(*shown);
+    for (std::size_t i = 0; i < text.getSize(); ++i)
+        font.getGlyph(text[i], textDisplay.getText().getCharacterSize(), false);
+
+    sf::String speaker(entry.speaker);
+    for (std::size_t i = 0; i < speaker.getSize(); ++i)
+        font.getGlyph(speaker[i], speakerText.getText().getCharacterSize(), false);
+}
+
+JobHandle DialogueBox::prewarmGlyphsAsync(const std::vector<DialogueEntry>& entries) {
+    auto textGlyphs = std::make_shared<std::set<sf::Uint32>>();
+    auto speakerGlyphs = std::make_shared<std::set<sf::Uint32>>();
+
+    // Whatever the placeholders will turn into; the brackets' own glyphs are harmless extras
+    TextVariables& variables = TextVariables::getInstance();
+    std::string names = variables.get(TextVariable::NAME) + variables.get(TextVariable::NICKNAME);
+
+    JobHandle collect = JobSystem::getInstance().submit("collect glyphs", [entries, names, textGlyphs, speakerGlyphs]() {
+        sf::String nameText(names);
+        textGlyphs->insert(nameText.begin(), nameText.end());
+        for (const DialogueEntry& entry : entries) {
+            sf::String text(entry.text);
+            textGlyphs->insert(text.begin(), text.end());
+            sf::String speaker(entry.speaker);
+            speakerGlyphs->insert(speaker.begin(), speaker.end());
+        }
+    });
+
+    return JobSystem::getInstance().submitMain("rasterize glyphs", [this, textGlyphs, speakerGlyphs]() {
+        for (sf::Uint32 codePoint : *textGlyphs)
+            font.getGlyph(codePoint, textDisplay.getText().getCharacterSize(), false);
+        for (sf::Uint32 codePoint : *speakerGlyphs)
+            font.getGlyph(codePoint, speakerText.getText().getCharacterSize(), false);
+    }, { collect });
+}
+
+void DialogueBox::nextDialogue() {
+    if (nextLine >= lineCount) {
+        setShown(false);
+        return;
+    }
+
+    // Assigning into the existing strings reuses their buffers
+    const DialogueLine& line = lines[nextLine++];
+    scriptText = line.text;
+    if (line.spanCount > 0)
+        TextVariables::getInstance().expand(line.spans, line.spanCount, fullText);
+    else
+        fullText = line.text;
+    speakerName = line.speaker;
+    currentCharIndex = 0;
+    speakerText.setString(speakerName);
+    speakerBackground.setVisible(visible && !speakerName.empty());
+    speakerText.setVisible(visible && !speakerName.empty());
+
+    // Lay the whole line out once so the text's string and vertex buffers are already
+    // big enough; typing it out then never allocates
+    fullString = fullText;
+    textDisplay.setString(fullString);
+    textDisplay.getText().getLocalBounds();
+    revealedText = fullString;
+    revealedText.clear();
+    textDisplay.setString(revealedText);
+    typeElapsed = 0.0f;
+    advanceElapsed = 0.0f;
+    finishedTyping = false;
+    ++linesStarted;
+}
+
+void DialogueBox::update(float deltaTime) {
+    if (!visible) return;
+    PROFILE_SCOPE(DialogueUpdate);
+
+    typeElapsed += deltaTime;
+    advanceElapsed += deltaTime;
+    std::size_t targetCharIndex = static_cast<std::size_t>(typeElapsed * typeSpeed);
+
+    if (!finishedTyping && targetCharIndex > currentCharIndex) {
+        targetCharIndex = std::min(targetCharIndex, fullString.getSize());
+        for (; currentCharIndex < targetCharIndex; ++currentCharIndex)
+            revealedText += fullString[currentCharIndex];
+        textDisplay.setString(revealedText);
+
+        if (currentCharIndex >= fullString.getSize()) {
+            finishedTyping = true;
+            advanceElapsed = 0.0f;  // Delay before auto-forward
+        }
+    }
+
+    if (autoForwardEnabled && finishedTyping && advanceElapsed >= 1.0f) {
+        nextDialogue();
+    }
+}
+
+void DialogueBox::draw() {
+    if (!visible) return;
+    PROFILE_SCOPE(TextDraw);
+
+    background.draw(target);
+    textDisplay.draw(target);
+
+    if (!speakerName.empty()) {
+        speakerBackground.draw(target);
+        speakerText.draw(target);
+    }
+
+    rightPanel.draw(target);
+    forwardButton.draw(target);
+    backButton.draw(target);
+    skipButton.draw(target);
+}
+
+void DialogueBox::handleInput(const sf::Event& event) {
+    if (!visible) return;
+
+    if (event.type == sf::Event::MouseButtonPressed) {
+        if (!finishedTyping) {
+            textDisplay.setString(fullString);
+            currentCharIndex = fullString.getSize();
+            finishedTyping = true;
+        }
+        else {
+            nextDialogue();
+        }
+    }
+
+    if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Space) {
+        if (!finishedTyping) {
+            textDisplay.setString(fullString);
+            currentCharIndex = fullString.getSize();
+            finishedTyping = true;
+        }
+        else {
+            nextDialogue();
+        }
+    }
+}
+
+void DialogueBox::setBackground(const std::string& imagePath) {
+    PROFILE_SCOPE(IO);
+    PROFILE_COUNT(TextureUploads);
+    if (backgroundTexture.loadFromFile(imagePath)) {
+        backgroundSprite.setTexture(backgroundTexture);
+        float scaleX = static_cast<float>(target.getSize().x) / backgroundTexture.getSize().x;
+        float scaleY = static_cast<float>(target.getSize().y) / backgroundTexture.getSize().y;
+        backgroundSprite.setScale(scaleX, scaleY);
+        hasBackgroundImage = true;
+    }
+    else {
+        std::cerr << "Failed to load image: " << imagePath << std::endl;
+        hasBackgroundImage = false;
+    }
+}
+
+void DialogueBox::drawBackground() {
+    if (hasBackgroundImage) {
+        target.draw(backgroundSprite);
+        PROFILE_DRAW(backgroundSprite);
+    }
+}
+
+bool DialogueBox::isVisible() const {
+    return visible;
+}
+
+bool DialogueBox::isTyping() const {
+    return visible && !finishedTyping;
+}
+
+std::size_t DialogueBox::getLinesStarted() const {
+    return linesStarted;
+}
+
+void DialogueBox::setAutoForward(bool enabled) {
+    autoForwardEnabled = enabled;
+    forwardButton.setSelected(enabled);
+}
+
+void DialogueBox::skipLines(std::size_t count) {
+    count = std::min(count, getLinesLeft());
+    if (count == 0) return;
+
+    nextLine += count - 1;
+    linesStarted += count - 1;
+    nextDialogue();
+    textDisplay.setString(fullString);
+    currentCharIndex = fullString.getSize();
+    finishedTyping = true;
+    advanceElapsed = 0.0f;
+}
+
+void DialogueBox::passLine() {
+    nextDialogue();
+}
+
+std::size_t DialogueBox::getLinesLeft() const {
+    return lineCount - nextLine;
+}
+
+void DialogueBox::setSkipping(bool skipping) {
+    skipButton.setSelected(skipping);
+}
+
+bool DialogueBox::wasBackPressed() const {
+    return backPressed;
+}
+
+void DialogueBox::resetBackPressed() {
+    backPressed = false;
+    backButton.setSelected(false);
+}
+
+// Hidden widgets can't be hovered or clicked either
+void DialogueBox::setShown(bool shown) {
+    visible = shown;
+    background.setVisible(shown);
+    textDisplay.setVisible(shown);
+    speakerBackground.setVisible(shown && !speakerName.empty());
+    speakerText.setVisible(shown && !speakerName.empty());
+    rightPanel.setVisible(shown);
+    forwardButton.setVisible(shown);
+    backButton.setVisible(shown);
+    skipButton.setVisible(shown);
+}
+
+const std::string& DialogueBox::getCurrentDialogue() const {
+    return fullText;
+}
+
+const char* DialogueBox::getCurrentScriptText() const {
+    return scriptText;
+}
+
+const std::string& DialogueBox::getCurrentSpeaker() const {
+    return speakerName;
 }
\ No newline at end of file
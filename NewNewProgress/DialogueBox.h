@@ -1,75 +1,118 @@
-#ifndef DIALOGUEBOX_HPP
-#define DIALOGUEBOX_HPP
-
-#include <SFML/Graphics.hpp>
-#include <string>
-#include <queue>
-#include <vector>
-
-struct DialogueEntry {
-    std::string text;
-    std::string speaker;
-
-    DialogueEntry(const std::string& t, const std::string& s) : text(t), speaker(s) {}
-};
-
-class DialogueBox {
-public:
-    DialogueBox(sf::RenderWindow& window, sf::Font& font);
-
-    void startDialogue(const std::vector<DialogueEntry>& entries);
-    void update();
-    void draw();
-    void handleInput(const sf::Event& event);
-    bool isVisible() const;
-
-    void setBackground(const std::string& imagePath);
-    void drawBackground();
-
-    std::string getCurrentSpeaker() const;
-
-    std::string getCurrentDialogue() const;  
-    bool wasBackPressed() const;
-    void resetBackPressed();
-
-private:
-    void nextDialogue();
-
-    sf::RenderWindow& window;
-    sf::Font& font;
-
-    sf::RectangleShape background;
-    sf::Text textDisplay;
-
-    sf::RectangleShape speakerBackground;
-    sf::Text speakerText;
-
-    std::string fullText;
-    std::string speakerName;
-    std::size_t currentCharIndex;
-    sf::Clock typeClock;
-    sf::RectangleShape sidePanel; //New shape for the ICONS Needed to be place
-    sf::RectangleShape rightPanel; 
-    bool visible;
-    bool finishedTyping;
-    float typeSpeed;
-
-    std::queue<DialogueEntry> dialogues;
-
-    sf::Texture backgroundTexture;
-    sf::Sprite backgroundSprite;
-    bool hasBackgroundImage = false;
-
-    sf::RectangleShape forwardButton;
-    sf::Text forwardText;
-    bool autoForwardEnabled;
-    sf::Clock advanceClock;
-
-    sf::RectangleShape backButton;
-    sf::Text backText;
-    bool backToTitleRequested = false;
-
-    bool backPressed;
-};
-
+#ifndef DIALOGUEBOX_HPP
+#define DIALOGUEBOX_HPP
+
+#include <SFML/Graphics.hpp>
+#include <functional>
+#include <string>
+#include <vector>
+#include "JobSystem.h"
+#include "TextVariables.h"
+#include "Widget.h"
+#include "WidgetLayer.h"
+
+struct DialogueEntry {
+    std::string text;
+    std::string speaker;
+    std::string condition;      // Left out unless this holds (see StoryCode); empty = always shown
+
+    DialogueEntry(const std::string& t, const std::string& s, const std::string& c = "")
+        : text(t), speaker(s), condition(c) {}
+};
+
+// A line as the box plays it. Doesn't own the text (StoryPlayer keeps it in its
+// chapter arena).
+struct DialogueLine {
+    const char* text;
+    const char* speaker;
+    const TextSpan* spans;      // text split at its placeholders; none if it has none
+    std::size_t spanCount;
+};
+
+// The box the lines type out in, with its speaker tag and the Auto, Back and Skip buttons.
+// Its widgets live on the screen's WidgetLayer; clicks that miss them advance the text.
+class DialogueBox {
+public:
+    DialogueBox(sf::RenderTarget& target, sf::Font& font, WidgetLayer& ui);
+
+    // The lines aren't copied: they have to stay alive until the next startDialogue
+    void startDialogue(const DialogueLine* lines, std::size_t count);
+    // Rasterize the glyphs an entry will need ahead of time (avoids a hitch on first draw)
+    void prewarmGlyphs(const DialogueEntry& entry);
+    // Same, for a whole script: the text is decoded and deduplicated on a worker,
+    // leaving only the rasterizing (which touches the font's texture) for the main thread
+    JobHandle prewarmGlyphsAsync(const std::vector<DialogueEntry>& entries);
+    void update(float deltaTime);
+    void draw();
+    void handleInput(const sf::Event& event);   // Whatever the WidgetLayer didn't take
+    bool isVisible() const;
+    bool isTyping() const;
+    std::size_t getLinesStarted() const;    // Lines shown since startDialogue, counting the current one
+    void setAutoForward(bool enabled);
+    // Jumps count lines ahead (at most to the last), laying out only the line it
+    // lands on, shown whole. Lines passed over still count as started.
+    void skipLines(std::size_t count);
+    std::size_t getLinesLeft() const;       // After the one on screen
+    // Straight on from the line on screen, as if it had been clicked through;
+    // e.g. for a line the story leaves out
+    void passLine();
+    void setSkipping(bool skipping);        // Lights the Skip button
+
+    std::function<void()> onSkip;           // Skip button clicked
+
+    void setBackground(const std::string& imagePath);
+    void drawBackground();
+
+    const std::string& getCurrentSpeaker() const;
+    const std::string& getCurrentDialogue() const;     // With the names filled in
+    const char* getCurrentScriptText() const;           // As the script has it
+    bool wasBackPressed() const;
+    void resetBackPressed();
+
+private:
+    void nextDialogue();
+    void setShown(bool shown);
+
+    sf::RenderTarget& target;
+    sf::Font& font;
+
+    Panel background;
+    Label textDisplay;
+
+    Panel speakerBackground;
+    Label speakerText;
+
+    std::string fullText;
+    const char* scriptText = "";
+    std::string expandScratch;  // For prewarming lines with names in them
+    std::string speakerName;
+    sf::String fullString;      // fullText, converted once per line
+    sf::String revealedText;    // Typed so far; sized for the whole line up front
+    std::size_t currentCharIndex;
+    std::size_t linesStarted = 0;
+    float typeElapsed = 0.0f;
+    sf::RectangleShape sidePanel; //New shape for the ICONS Needed to be place
+    Panel rightPanel;
+    bool visible;
+    bool finishedTyping;
+    float typeSpeed;
+
+    const DialogueLine* lines = nullptr;
+    std::size_t lineCount = 0;
+    std::size_t nextLine = 0;
+
+    sf::Texture backgroundTexture;
+    sf::Sprite backgroundSprite;
+    bool hasBackgroundImage = false;
+
+    TextButton forwardButton;   // Selected while auto-forward is on
+    bool autoForwardEnabled;
+    float advanceElapsed = 0.0f;
+
+    TextButton backButton;      // Selected once pressed
+    TextButton skipButton;      // Selected while skipping
+    bool backToTitleRequested = false;
+
+    bool backPressed;
+};
+
 #endif // DIALOGUEBOX_HPP
\ No newline at end of file
@@ -0,0 +1,238 @@
+#include "Game.h"
+#include <iostream>
+
+#include "TitleScreen.h"
+#include "AboutScreen.h"
+#include "LoadScreen.h"
+#include "PlayIntro.h"
+#include "NameEntryScreen.h"
+#include "GameplayScreen.h"
+#include "chapterManager.h"
+#include "InspectScreen.h"
+#include "PauseScreen.h"
+#include "BacklogScreen.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include "ProfilerOverlay.h"
+#include "ReadLog.h"
+#include "TextureCache.h"
+#include "Tracer.h"
+
+Game::Game()
+    : soundManager(SoundManager::getInstance())
+{
+}
+
+Game::~Game() = default;
+
+bool Game::init() {
+    window.create(sf::VideoMode(1600, 900), "Escape from Biringan");
+    window.setVerticalSyncEnabled(true);
+    TRACE_THREAD_NAME("Main");
+
+    JobSystem::getInstance().start();
+
+    // Load fonts
+    if (!titleFont.loadFromFile("BlackDahlia.ttf")) {
+        std::cerr << "Failed to load BlackDahlia.ttf\n";
+        return false;
+    }
+
+    if (!bodyFont.loadFromFile("Railway.ttf")) {
+        std::cerr << "Failed to load Railway.ttf\n";
+        return false;
+    }
+
+    // What's been read, from every earlier session; none on a first run
+    ReadLog::getInstance().load("readlines.dat");
+
+    // Load sound effects
+    if (!soundManager.loadSound("ECH1", "ECH1.ogg")) {
+        std::cerr << "Failed to load ECH sound effect.\n";
+    }
+
+    // Play background music for the title screen
+    if (!soundManager.playMusic("BeginM.ogg", true)) {
+        std::cerr << "Failed to load background music.\n";
+        return false;
+    }
+
+    // Every screen is built exactly once here and reused for the rest of the run
+    titleScreen = std::make_unique<TitleScreen>(window, titleFont, bodyFont, soundManager, *this);
+    aboutScreen = std::make_unique<AboutScreen>(window, titleFont, bodyFont, *this);
+    loadScreen = std::make_unique<LoadScreen>(window, titleFont, bodyFont, *this);
+    introScreen = std::make_unique<PlayIntroScreen>(window, titleFont, bodyFont, *this);
+    nameEntryScreen = std::make_unique<NameEntryScreen>(window, titleFont, bodyFont, *this);
+    chapterManager = std::make_unique<ChapterManager>(window, bodyFont, *this);
+    inspectScreen = std::make_unique<InspectScreen>(window, bodyFont, *this);
+    pauseScreen = std::make_unique<PauseScreen>(window, titleFont, bodyFont, soundManager, *this);
+    backlogScreen = std::make_unique<BacklogScreen>(window, bodyFont, *this);
+    gameplayScreen = std::make_unique<GameplayScreen>(window, bodyFont, soundManager, *this);
+
+    screens.add(GameState::TITLE, *titleScreen);
+    screens.add(GameState::ABOUT, *aboutScreen);
+    screens.add(GameState::LOAD, *loadScreen);
+    screens.add(GameState::INTRO, *introScreen);
+    screens.add(GameState::NAME_ENTRY, *nameEntryScreen);
+    screens.add(GameState::CHAPTER, *chapterManager);
+    screens.add(GameState::INSPECT, *inspectScreen);
+    screens.add(GameState::PAUSE, *pauseScreen);
+    screens.add(GameState::BACKLOG, *backlogScreen);
+    screens.add(GameState::GAMEPLAY, *gameplayScreen);
+
+    profilerOverlay = std::make_unique<ProfilerOverlay>(bodyFont);
+
+    screens.switchTo(GameState::TITLE);
+    screens.applyPendingChanges();
+    return true;
+}
+
+void Game::run() {
+    float accumulator = 0.0f;
+    clock.tick();   // Don't count the time spent loading
+
+    while (window.isOpen() && !screens.isEmpty()) {
+        Profiler::getInstance().beginFrame();
+        processEvents();
+
+        accumulator += clock.tick();
+
+        while (accumulator >= timeStep) {
+            PROFILE_SCOPE(Update);
+            screens.update(timeStep);
+            screens.applyPendingChanges();
+            accumulator -= timeStep;
+        }
+
+        {
+            PROFILE_SCOPE(MainJobs);
+            JobSystem::getInstance().runMainThreadJobs(mainJobBudget);
+            screens.applyPendingChanges();
+        }
+
+        render();
+        screens.applyPendingChanges();
+        Profiler::getInstance().endFrame();
+    }
+
+    // Let queued saves finish before the process goes away
+    JobSystem::getInstance().shutdown();
+
+#if BIRINGAN_PROFILE
+    soundManager.stopMusic();
+    Tracer::getInstance().writeChromeTrace("trace.json");
+#endif
+}
+
+void Game::processEvents() {
+    PROFILE_SCOPE(Events);
+    sf::Event event;
+    while (window.pollEvent(event)) {
+        if (event.type == sf::Event::Closed) {
+            window.close();
+            return;
+        }
+        // SFML has no minimize event, but a minimized window always loses focus first.
+        // Whatever the current screen isn't holding can be reloaded when needed.
+        if (event.type == sf::Event::LostFocus) {
+            TextureCache::getInstance().trim();
+        }
+        if (event.type == sf::Event::Resized) {
+            resizePending = true;
+            resizeTimer.restart();
+        }
+        if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F3) {
+            profilerOverlay->toggle();
+            continue;
+        }
+#if BIRINGAN_PROFILE
+        if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F4) {
+            Tracer::getInstance().writeChromeTrace("trace.json");
+            continue;
+        }
+        // F5 pauses the game clock, F6 cycles it through 1x, 4x and 16x
+        if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F5) {
+            clock.setPaused(clock.getMode() != ClockMode::PAUSED);
+            continue;
+        }
+        if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F6) {
+            float scale = clock.getScale() >= 16.0f ? 1.0f : clock.getScale() * 4.0f;
+            if (scale == 1.0f) clock.setRealTime();
+            else clock.setScale(scale);
+            continue;
+        }
+#endif
+        screens.handleEvent(event);
+    }
+    if (resizePending && resizeTimer.getElapsedTime() > sf::seconds(0.25f)) {
+        resizePending = false;
+        screens.resize();
+    }
+    screens.applyPendingChanges();
+}
+
+void Game::render() {
+    {
+        PROFILE_SCOPE(Render);
+        window.clear(sf::Color::Black);
+        screens.draw(window);
+        profilerOverlay->draw(window);
+    }
+
+    PROFILE_SCOPE(Display);
+    window.display();
+}
+
+void Game::changeState(GameState next) {
+    switch (next) {
+    case GameState::GAMEPLAY:
+        std::cout << "Starting gameplay...\n";
+        gameplayScreen->startNewGame();
+        screens.switchTo(GameState::GAMEPLAY);
+        break;
+    case GameState::RESUME:
+        // Falls back to the title screen if the save can't be read
+        gameplayScreen->queueResume("savegame.dat");
+        screens.switchTo(GameState::GAMEPLAY);
+        break;
+    case GameState::CHAPTER:
+        screens.push(GameState::CHAPTER);
+        break;
+    case GameState::INSPECT:
+        screens.push(GameState::INSPECT);
+        break;
+    case GameState::PAUSE:
+        screens.push(GameState::PAUSE);
+        break;
+    case GameState::BACKLOG:
+        screens.push(GameState::BACKLOG);
+        break;
+    case GameState::QUIT:
+        std::cout << "Quitting the game...\n";
+        window.close();
+        break;
+    default:
+        screens.switchTo(next);
+        break;
+    }
+}
+
+ScreenStack& Game::getScreens() {
+    return screens;
+}
+
+ChapterManager& Game::getChapterManager() {
+    return *chapterManager;
+}
+
+InspectScreen& Game::getInspectScreen() {
+    return *inspectScreen;
+}
+
+GameplayScreen& Game::getGameplayScreen() {
+    return *gameplayScreen;
+}
+
+GameClock& Game::getClock() {
+    return clock;
+}
@@ -0,0 +1,76 @@
+#ifndef GAME_HPP
+#define GAME_HPP
+
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include "GameClock.h"
+#include "GameState.h"
+#include "ScreenStack.h"
+#include "SoundManager.h"
+
+class TitleScreen;
+class AboutScreen;
+class LoadScreen;
+class PlayIntroScreen;
+class GameplayScreen;
+class ChapterManager;
+class InspectScreen;
+class PauseScreen;
+class BacklogScreen;
+class NameEntryScreen;
+class ProfilerOverlay;
+
+// Owns the window, fonts and every screen, and runs the one and only game loop:
+// events are polled once, update runs at a fixed timestep and rendering runs
+// once per displayed frame.
+class Game {
+public:
+    Game();
+    ~Game();
+
+    bool init();    // Window, fonts, sounds and screens; false if a required asset is missing
+    void run();
+
+    // Screens call this to move the game somewhere else (what main()'s state switch used to do)
+    void changeState(GameState next);
+
+    ScreenStack& getScreens();
+    ChapterManager& getChapterManager();
+    InspectScreen& getInspectScreen();
+    GameplayScreen& getGameplayScreen();
+    GameClock& getClock();      // Set its mode to run faster, slower or frame-stepped
+
+private:
+    void processEvents();
+    void render();
+
+    sf::RenderWindow window;
+    sf::Font titleFont;
+    sf::Font bodyFont;
+    SoundManager& soundManager;
+
+    ScreenStack screens;
+    GameClock clock;
+    // Dragging the window edge sends a stream of Resized events; screens refit their
+    // textures once it has stopped for a moment
+    sf::Clock resizeTimer;
+    bool resizePending = false;
+
+    std::unique_ptr<TitleScreen> titleScreen;
+    std::unique_ptr<AboutScreen> aboutScreen;
+    std::unique_ptr<LoadScreen> loadScreen;
+    std::unique_ptr<PlayIntroScreen> introScreen;
+    std::unique_ptr<GameplayScreen> gameplayScreen;
+    std::unique_ptr<ChapterManager> chapterManager;
+    std::unique_ptr<InspectScreen> inspectScreen;
+    std::unique_ptr<PauseScreen> pauseScreen;
+    std::unique_ptr<BacklogScreen> backlogScreen;
+    std::unique_ptr<NameEntryScreen> nameEntryScreen;
+
+    std::unique_ptr<ProfilerOverlay> profilerOverlay;   // F3
+
+    const float timeStep = 1.0f / 60.0f;
+    const float mainJobBudget = 0.004f; // Seconds per frame for uploads and other main-thread jobs
+};
+
+#endif // GAME_HPP
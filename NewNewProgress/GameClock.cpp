@@ -0,0 +1,64 @@
+#include "GameClock.h"
+#include <algorithm>
+
+void GameClock::setRealTime() {
+    mode = ClockMode::REAL;
+    wallClock.restart();
+}
+
+void GameClock::setPaused(bool paused) {
+    if (paused && mode != ClockMode::PAUSED) {
+        resumeMode = mode;
+        mode = ClockMode::PAUSED;
+    }
+    else if (!paused && mode == ClockMode::PAUSED) {
+        mode = resumeMode;
+        wallClock.restart();    // Don't count the time spent paused
+    }
+}
+
+void GameClock::setScale(float newScale) {
+    scale = std::max(newScale, 0.0f);
+    mode = ClockMode::SCALED;
+    wallClock.restart();
+}
+
+void GameClock::setFixedStep(float step, unsigned steps) {
+    fixedStep = step;
+    stepsPerTick = std::max(steps, 1u);
+    mode = ClockMode::FIXED_STEP;
+}
+
+ClockMode GameClock::getMode() const {
+    return mode;
+}
+
+float GameClock::getScale() const {
+    return mode == ClockMode::SCALED ? scale : 1.0f;
+}
+
+float GameClock::tick() {
+    float real = std::min(wallClock.restart().asSeconds(), maxRealDelta);
+    float elapsed = 0.0f;
+
+    switch (mode) {
+    case ClockMode::REAL:
+        elapsed = real;
+        break;
+    case ClockMode::PAUSED:
+        break;
+    case ClockMode::SCALED:
+        elapsed = real * scale;
+        break;
+    case ClockMode::FIXED_STEP:
+        elapsed = fixedStep * stepsPerTick;
+        break;
+    }
+
+    time += elapsed;
+    return elapsed;
+}
+
+double GameClock::getTime() const {
+    return time;
+}
@@ -0,0 +1,45 @@
+#ifndef GAMECLOCK_HPP
+#define GAMECLOCK_HPP
+
+#include <SFML/System.hpp>
+
+enum class ClockMode {
+    REAL,           // Wall-clock time
+    PAUSED,         // No time passes
+    SCALED,         // Wall-clock time times a factor
+    FIXED_STEP      // A set amount per tick, however long the tick really took
+};
+
+// The game's one source of time. The loop asks it how much time passed each frame
+// and feeds that to the fixed-timestep updates, so every animation, typewriter and
+// fade follows it. Fixed-step mode makes a run deterministic and lets tools step
+// the story much faster than real time.
+class GameClock {
+public:
+    void setRealTime();
+    void setPaused(bool paused);        // Resumes whichever mode was active
+    void setScale(float scale);         // Switches to SCALED
+    // stepsPerTick > 1 runs several updates per rendered frame
+    void setFixedStep(float step, unsigned stepsPerTick = 1);
+
+    ClockMode getMode() const;
+    float getScale() const;
+
+    // Call once per frame; returns the simulated seconds since the last call
+    float tick();
+    double getTime() const;     // Simulated seconds since the clock was created
+
+private:
+    ClockMode mode = ClockMode::REAL;
+    ClockMode resumeMode = ClockMode::REAL;     // Mode to go back to when unpaused
+    float scale = 1.0f;
+    float fixedStep = 1.0f / 60.0f;
+    unsigned stepsPerTick = 1;
+
+    sf::Clock wallClock;
+    double time = 0.0;
+
+    const float maxRealDelta = 0.25f;   // Avoid a spiral of catch-up updates after a stall
+};
+
+#endif // GAMECLOCK_HPP
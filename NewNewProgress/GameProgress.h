@@ -1,12 +1,17 @@
-#ifndef GAMEPROGRESS_HPP
-#define GAMEPROGRESS_HPP
-
-#include <string>
-
-struct GameProgress {
-    std::string backgroundImage;
-    std::string speaker;
-    std::string dialogue;
-};
-
+#ifndef GAMEPROGRESS_HPP
+#define GAMEPROGRESS_HPP
+
+#include <string>
+
+struct GameProgress {
+    std::string backgroundImage;
+    std::string speaker;
+    std::string dialogue;
+    std::string timeline;       // Running when the save was made, if any
+    float timelineTime = 0.0f;  // Seconds into it
+    std::string playerName;     // What [Name] and [Nickname] stand for
+    std::string nickname;
+    std::string storyVariables; // StoryVariables::save()
+};
+
 #endif //
\ No newline at end of file
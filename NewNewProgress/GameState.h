@@ -1,9 +1,16 @@
-#pragma once
-
-enum class GameState {
-    TITLE,
-    ABOUT,
-    GAMEPLAY,
-    QUIT,
-    LOAD
+#pragma once
+
+enum class GameState {
+    TITLE,
+    ABOUT,
+    GAMEPLAY,
+    QUIT,
+    LOAD,
+    INTRO,      // Notice/disclaimer cards before a new game
+    RESUME,     // Gameplay restored from the save file
+    CHAPTER,    // Chapter title card overlay
+    INSPECT,    // Panning around a large image, pushed over gameplay
+    PAUSE,      // System menu over the frozen game
+    BACKLOG,    // Lines read so far, over the frozen game
+    NAME_ENTRY  // The player's name and nickname, before a new game
 };
\ No newline at end of file
@@ -0,0 +1,288 @@
+﻿#include "GameplayScreen.h"
+#include "Game.h"
+#include "chapterManager.h"
+#include "InspectScreen.h"
+#include "SaveManager.h"
+#include "ReadLog.h"
+#include "StoryVariables.h"
+#include "GameProgress.h"
+#include "TextureCache.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include <iostream>
+
+GameplayScreen::GameplayScreen(sf::RenderWindow& win, sf::Font& font, SoundManager& soundManager, Game& game)
+    : window(win), bodyFont(font), soundManager(soundManager), game(game),
+    bgManager(win), ui(win), dialogueBox(win, font, ui), choiceBox(win, font, ui), stage(win), camera(sf::Vector2f(win.getSize())),
+    timelines(win, font, bgManager, stage, camera, soundManager),
+    story(bgManager, dialogueBox, choiceBox, stage, camera, timelines, particles, soundManager)
+{
+    // Shown once the dialogue box has been closed
+    gameplayText.setFont(bodyFont);
+    gameplayText.setString("Gameplay is running...\nPress ESC for the menu.");
+    gameplayText.setCharacterSize(30);
+    gameplayText.setFillColor(sf::Color::White);
+    gameplayText.setPosition(50, 200);
+
+    // The cards sit on top of gameplay and load the next chapter while they are shown,
+    // so dismissing the last one reveals a scene that is already decoded.
+    story.onChapter = [this](const ScriptCue& cue) {
+        this->game.getChapterManager().transitionToChapter(cue.titles, [this]() {
+            story.startChapter(pendingNode);
+            // The scene holds what it uses now
+            TextureCache::getInstance().unpinAll();
+        });
+        preloadNode(cue.argument);
+    };
+
+    dialogueBox.onSkip = [this]() { story.setSkipping(!story.isSkipping()); };
+
+    // Gameplay stays frozen underneath until the player is done looking
+    story.onInspect = [this](const ScriptCue& cue) {
+        this->game.getInspectScreen().inspect(cue.argument);
+    };
+}
+
+void GameplayScreen::resetProgressFlags() {
+    showDialogue = true;
+    choiceBox.hide();
+    stage.clear();
+    story.getBacklog().clear();
+    StoryVariables::getInstance().reset();
+    dialogueBox.resetBackPressed();
+}
+
+void GameplayScreen::startNewGame() {
+    resetProgressFlags();
+    lastSaved = GameProgress();
+
+    ScriptNode first;
+    StoryScript::loadNode(StoryScript::firstNode, first);
+    story.startChapter(first);
+}
+
+bool GameplayScreen::resumeFromSave(const std::string& filename) {
+    SaveManager::waitForSaves();
+    GameProgress progress;
+    {
+        PROFILE_SCOPE(IO);
+        if (!SaveManager::loadProgress(filename, progress))
+            return false;
+    }
+
+    resetProgressFlags();
+    // Now what's on disk; the last session's state must not be written over it
+    lastSaved = progress;
+    // Saves from before names were asked for keep the placeholders
+    TextVariables::getInstance().set(TextVariable::NAME, progress.playerName);
+    TextVariables::getInstance().set(TextVariable::NICKNAME, progress.nickname);
+    // Before the node starts, so the saved line's conditions see them
+    StoryVariables& variables = StoryVariables::getInstance();
+    if (!variables.load(progress.storyVariables))
+        std::cerr << "Story variables in " << filename << " are unreadable; starting them over\n";
+
+    // Pick the story up at the saved line so its cues and choices still work
+    std::string nodeId;
+    std::size_t lineIndex = 0;
+    ScriptNode node;
+    if (StoryScript::findLine(progress.dialogue, nodeId, lineIndex) && StoryScript::loadNode(nodeId, node)) {
+        node.background.clear();
+        story.startChapter(node, lineIndex);
+        // The saved variables already have that line's effects in them; don't count them twice
+        story.setFirstLineApplied();
+    }
+    else {
+        node.lines = { {progress.dialogue, progress.speaker} };
+        story.startChapter(node);
+    }
+    bgManager.setBackground(progress.backgroundImage);
+    if (!progress.timeline.empty())
+        story.resumeTimeline(progress.timeline, progress.timelineTime);
+    return true;
+}
+
+// Load everything the next node needs in the background while its chapter card is
+// on screen: the script itself, then its backgrounds, sounds and glyphs.
+void GameplayScreen::preloadNode(const std::string& nodeId) {
+    JobSystem& jobs = JobSystem::getInstance();
+    auto node = std::make_shared<ScriptNode>();
+    auto found = std::make_shared<bool>(false);
+
+    JobHandle script = jobs.submit("script " + nodeId, [node, found, nodeId]() {
+        *found = StoryScript::loadNode(nodeId, *node);
+    });
+
+    // Caches and the font are main-thread state, so fan out from there
+    JobHandle assets = jobs.submitMain("preload " + nodeId, [this, node, found, nodeId]() {
+        if (!*found) {
+            std::cerr << "Unknown script node: " << nodeId << "\n";
+            return;
+        }
+        pendingNode = std::move(*node);
+
+        ChapterManager& cards = game.getChapterManager();
+        // At the size they'll be drawn, so the cards wait on the textures actually used.
+        // Pinned, so losing focus while the card is up doesn't throw them away again.
+        TextureCache& cache = TextureCache::getInstance();
+        auto preload = [&cache, &cards](const std::string& key) {
+            cache.pin(key);
+            cards.waitFor(cache.loadAsync(key));
+        };
+        preload(bgManager.getTextureKey(pendingNode.background));
+        for (const std::string& background : pendingNode.preloadBackgrounds)
+            preload(bgManager.getTextureKey(background));
+        for (const auto& character : pendingNode.characters)
+            preload(stage.getTextureKey(character.second));
+        for (const auto& sound : pendingNode.sounds) {
+            if (!soundManager.hasSound(sound.first))
+                cards.waitFor(soundManager.loadSoundAsync(sound.first, sound.second));
+        }
+        cards.waitFor(dialogueBox.prewarmGlyphsAsync(pendingNode.lines));
+    }, { script });
+
+    game.getChapterManager().waitFor(assets);
+}
+
+void GameplayScreen::queueResume(const std::string& filename) {
+    resumeFile = filename;
+}
+
+void GameplayScreen::onEnter() {
+    if (!resumeFile.empty()) {
+        std::string filename;
+        filename.swap(resumeFile);
+        if (!resumeFromSave(filename)) {
+            std::cerr << "Failed to load saved game progress.\n";
+            game.changeState(GameState::TITLE);
+            return;
+        }
+    }
+    ui.syncPointer(sf::Mouse::getPosition(window));
+}
+
+// Back from the pause menu or an inspected image; the cursor has probably moved
+void GameplayScreen::onReveal() {
+    ui.syncPointer(sf::Mouse::getPosition(window));
+}
+
+const Backlog& GameplayScreen::getBacklog() {
+    return story.getBacklog();
+}
+
+// Same as the autosave, with the timeline's progress right now
+void GameplayScreen::saveProgress() {
+    lastSaved.timeline = timelines.isPlaying() ? timelines.getId() : std::string();
+    lastSaved.timelineTime = timelines.isPlaying() ? timelines.getTime() : 0.0f;
+    SaveManager::saveProgressAsync("savegame.dat", lastSaved);
+}
+
+void GameplayScreen::onExit() {
+    story.setSkipping(false);
+    TextureCache::getInstance().unpinAll();     // Left mid-card: that chapter isn't coming
+    ReadLog::getInstance().saveAsync("readlines.dat");
+    // Leaving mid-timeline: note how far it got, then silence it
+    if (timelines.isPlaying()) {
+        lastSaved.timeline = timelines.getId();
+        lastSaved.timelineTime = timelines.getTime();
+        SaveManager::saveProgressAsync("savegame.dat", lastSaved);
+        timelines.stop();
+    }
+    soundManager.stopMusic();
+}
+
+void GameplayScreen::onResize() {
+    bgManager.refit();
+    stage.refit();
+}
+
+void GameplayScreen::handleEvent(const sf::Event& event) {
+    // Pauses over the scene; everything here stays loaded until the player leaves for good
+    if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape) {
+        game.changeState(GameState::PAUSE);
+        return;
+    }
+    // Scrolling up reads back through the lines so far
+    if (event.type == sf::Event::MouseWheelScrolled && event.mouseWheelScroll.wheel == sf::Mouse::VerticalWheel &&
+        event.mouseWheelScroll.delta > 0.0f && story.getBacklog().getCount() > 0) {
+        game.changeState(GameState::BACKLOG);
+        return;
+    }
+    // Holding Ctrl skips too, until it's let go
+    if ((event.type == sf::Event::KeyPressed || event.type == sf::Event::KeyReleased) &&
+        (event.key.code == sf::Keyboard::LControl || event.key.code == sf::Keyboard::RControl)) {
+        story.setSkipping(event.type == sf::Event::KeyPressed);
+        return;
+    }
+    if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Tab && timelines.isPlaying()) {
+        timelines.skip();
+        return;
+    }
+    if (ui.handleEvent(event))
+        return;
+    // A choice has to be made before the text moves on
+    if (!choiceBox.isVisible())
+        dialogueBox.handleInput(event);
+}
+
+void GameplayScreen::update(float deltaTime) {
+    bgManager.update(deltaTime);
+    timelines.update(deltaTime);
+    camera.update(deltaTime);
+    stage.update(deltaTime);
+    // The smoke lives in the camera's space, so the cursor has to be too
+    particles.setPointer(window.mapPixelToCoords(sf::Mouse::getPosition(window), camera.getView()));
+    particles.update(deltaTime);
+    dialogueBox.update(deltaTime);
+    ui.update();
+
+    if (!showDialogue)
+        return;
+
+    story.update();
+
+    if (!dialogueBox.isVisible() && !choiceBox.isVisible()) {
+        showDialogue = false;
+    }
+
+    // Save progress whenever the line or background changes; the write happens on a worker.
+    // Compared in place, so a frame where nothing changed copies no strings. Skipping
+    // saves once it stops, not for every batch.
+    if (story.isSkipping())
+        return;
+    const std::string& background = bgManager.getCurrentBackground();
+    const std::string& speaker = dialogueBox.getCurrentSpeaker();
+    // The script's text, not what was shown, so findLine can find it again
+    const char* dialogue = dialogueBox.getCurrentScriptText();
+    if (background != lastSaved.backgroundImage || speaker != lastSaved.speaker || dialogue != lastSaved.dialogue) {
+        lastSaved.backgroundImage = background;
+        lastSaved.speaker = speaker;
+        lastSaved.dialogue = dialogue;
+        lastSaved.timeline = timelines.isPlaying() ? timelines.getId() : std::string();
+        lastSaved.timelineTime = timelines.isPlaying() ? timelines.getTime() : 0.0f;
+        lastSaved.playerName = TextVariables::getInstance().get(TextVariable::NAME);
+        lastSaved.nickname = TextVariables::getInstance().get(TextVariable::NICKNAME);
+        lastSaved.storyVariables = StoryVariables::getInstance().save();
+        SaveManager::saveProgressAsync("savegame.dat", lastSaved);
+        ReadLog::getInstance().saveAsync("readlines.dat");
+    }
+}
+
+void GameplayScreen::draw(sf::RenderTarget& target) {
+    bgManager.draw(camera.getView());
+
+    if (showDialogue) {
+        sf::View screenView = target.getView();
+        target.setView(camera.getView());
+        stage.draw(target);
+        particles.draw(target);
+        target.setView(screenView);
+
+        dialogueBox.draw();
+        choiceBox.draw(window);
+    }
+    else {
+        target.draw(gameplayText);
+        PROFILE_DRAW(gameplayText);
+    }
+    timelines.draw();
+}
@@ -0,0 +1,70 @@
+#ifndef GAMEPLAYSCREEN_HPP
+#define GAMEPLAYSCREEN_HPP
+
+#include <SFML/Graphics.hpp>
+#include <string>
+#include "Screen.h"
+#include "BackgroundManager.h"
+#include "WidgetLayer.h"
+#include "DialogueBox.h"
+#include "ChoiceBox.h"
+#include "PortraitStage.h"
+#include "Camera.h"
+#include "TimelinePlayer.h"
+#include "ParticleSystem.h"
+#include "SoundManager.h"
+#include "StoryScript.h"
+#include "StoryPlayer.h"
+#include "GameProgress.h"
+
+class Game;
+
+// The story itself. Built once; starting a new game or loading a save resets it in place.
+class GameplayScreen : public Screen {
+public:
+    GameplayScreen(sf::RenderWindow& window, sf::Font& font, SoundManager& soundManager, Game& game);
+
+    void startNewGame();
+    bool resumeFromSave(const std::string& filename);
+    // Resumes from onEnter instead, once switching here has cleared the stack: gameplay
+    // still underneath (loading from the pause menu) has to exit, saving and stopping
+    // its timeline and music, before the save is read and the story restarted
+    void queueResume(const std::string& filename);
+    void saveProgress();        // From the pause menu
+    const Backlog& getBacklog();
+
+    void onEnter() override;                            // Hover picks up wherever the cursor is now
+    void onExit() override;
+    void onReveal() override;
+    void onResize() override;
+    void handleEvent(const sf::Event& event) override;
+    void update(float deltaTime) override;
+    void draw(sf::RenderTarget& target) override;
+
+private:
+    void resetProgressFlags();
+    void preloadNode(const std::string& nodeId);
+
+    sf::RenderWindow& window;
+    sf::Font& bodyFont;
+    SoundManager& soundManager;
+    Game& game;
+
+    BackgroundManager bgManager;
+    WidgetLayer ui;             // The dialogue box's and the choices' widgets
+    DialogueBox dialogueBox;
+    ChoiceBox choiceBox;
+    PortraitStage stage;
+    Camera camera;              // Background and characters only; the boxes stay put
+    TimelinePlayer timelines;
+    ParticleSystem particles;   // Drawn through the camera, over the characters
+    sf::Text gameplayText;
+    StoryPlayer story;
+    ScriptNode pendingNode;     // Next node, filled in while a chapter card is up
+    GameProgress lastSaved;     // What's on disk, so unchanged frames don't rewrite it
+    std::string resumeFile;     // Set by queueResume until onEnter gets to it
+
+    bool showDialogue = true;
+};
+
+#endif // GAMEPLAYSCREEN_HPP
@@ -0,0 +1,225 @@
+#include "ImageFilter.h"
+#include "PixelKernels.h"
+#include "Tracer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+namespace {
+    // out = r * column[0] + g * column[1] + b * column[2] + a * column[3] + column[4],
+    // each column being the RGBA it contributes, on the 0-255 scale
+    struct ColorMatrix {
+        float column[5][4];
+
+        static ColorMatrix identity() {
+            ColorMatrix m = {};
+            for (int i = 0; i < 4; ++i)
+                m.column[i][i] = 1.0f;
+            return m;
+        }
+
+        static ColorMatrix rows(const float (&rgb)[3][3]) {
+            ColorMatrix m = identity();
+            for (int out = 0; out < 3; ++out) {
+                for (int in = 0; in < 3; ++in)
+                    m.column[in][out] = rgb[out][in];
+            }
+            return m;
+        }
+
+        // This one applied after first
+        ColorMatrix after(const ColorMatrix& first) const {
+            ColorMatrix m = {};
+            for (int i = 0; i < 5; ++i) {
+                for (int out = 0; out < 4; ++out) {
+                    float sum = i == 4 ? column[4][out] : 0.0f;
+                    for (int j = 0; j < 4; ++j)
+                        sum += column[j][out] * first.column[i][j];
+                    m.column[i][out] = sum;
+                }
+            }
+            return m;
+        }
+    };
+
+    const float grayscaleRows[3][3] = {
+        { 0.299f, 0.587f, 0.114f },
+        { 0.299f, 0.587f, 0.114f },
+        { 0.299f, 0.587f, 0.114f }
+    };
+    const float sepiaRows[3][3] = {
+        { 0.393f, 0.769f, 0.189f },
+        { 0.349f, 0.686f, 0.168f },
+        { 0.272f, 0.534f, 0.131f }
+    };
+
+    struct Step {
+        enum Kind { BLUR, COLOR, VIGNETTE } kind;
+        float amount;
+        ColorMatrix matrix;
+    };
+
+    // Splits "name(value)" into its parts; value stays as given if there isn't one
+    bool parseToken(const std::string& token, std::string& name, float& value) {
+        std::size_t open = token.find('(');
+        if (open == std::string::npos) {
+            name = token;
+            return true;
+        }
+        if (token.back() != ')')
+            return false;
+        name = token.substr(0, open);
+        std::string number = token.substr(open + 1, token.size() - open - 2);
+        char* end = nullptr;
+        value = std::strtof(number.c_str(), &end);
+        return !number.empty() && *end == '\0';
+    }
+
+    // Adjacent colour steps are folded into a single matrix, so a grade followed by a
+    // darken is still one pass over the pixels
+    bool parseChain(const std::string& chain, std::vector<Step>& steps) {
+        std::istringstream in(chain);
+        std::string token;
+        while (in >> token) {
+            std::string name;
+            float value = 1.0f;
+            if (!parseToken(token, name, value))
+                return false;
+
+            Step step;
+            step.amount = value;
+            step.matrix = ColorMatrix::identity();
+            if (name == "blur") {
+                step.kind = Step::BLUR;
+            }
+            else if (name == "vignette") {
+                step.kind = Step::VIGNETTE;
+            }
+            else if (name == "grayscale" || name == "sepia" || name == "desaturate") {
+                step.kind = Step::COLOR;
+                ColorMatrix graded = ColorMatrix::rows(name == "sepia" ? sepiaRows : grayscaleRows);
+                float amount = name == "desaturate" ? std::min(std::max(value, 0.0f), 1.0f) : 1.0f;
+                for (int i = 0; i < 5; ++i) {
+                    for (int c = 0; c < 4; ++c)
+                        step.matrix.column[i][c] += (graded.column[i][c] - step.matrix.column[i][c]) * amount;
+                }
+            }
+            else if (name == "darken") {
+                step.kind = Step::COLOR;
+                float keep = 1.0f - std::min(std::max(value, 0.0f), 1.0f);
+                for (int c = 0; c < 3; ++c)
+                    step.matrix.column[c][c] = keep;
+            }
+            else {
+                return false;
+            }
+
+            if (step.kind == Step::COLOR && !steps.empty() && steps.back().kind == Step::COLOR)
+                steps.back().matrix = step.matrix.after(steps.back().matrix);
+            else
+                steps.push_back(step);
+        }
+        return true;
+    }
+
+    // Separable Gaussian: a horizontal pass into scratch, then a vertical one back
+    void blur(std::vector<sf::Uint8>& pixels, unsigned width, unsigned height, float sigma) {
+        if (sigma < 0.3f || width == 0 || height == 0)
+            return;
+        unsigned radius = static_cast<unsigned>(std::ceil(sigma * 3.0f));
+        unsigned taps = radius * 2 + 1;
+        std::vector<float> weights(taps);
+        float total = 0.0f;
+        for (unsigned k = 0; k < taps; ++k) {
+            float d = static_cast<float>(k) - radius;
+            weights[k] = std::exp(-d * d / (2.0f * sigma * sigma));
+            total += weights[k];
+        }
+        for (float& weight : weights)
+            weight /= total;
+
+        const PixelKernels& kernel = PixelKernels::get();
+        std::size_t rowBytes = static_cast<std::size_t>(width) * 4;
+        std::vector<sf::Uint8> across(pixels.size());
+        std::vector<sf::Uint8> padded((width + radius * 2) * 4);
+        for (unsigned y = 0; y < height; ++y) {
+            // Edge pixels repeated out to the radius
+            const sf::Uint8* row = pixels.data() + y * rowBytes;
+            for (unsigned i = 0; i < radius; ++i) {
+                std::memcpy(padded.data() + i * 4, row, 4);
+                std::memcpy(padded.data() + (radius + width + i) * 4, row + rowBytes - 4, 4);
+            }
+            std::memcpy(padded.data() + radius * 4, row, rowBytes);
+            kernel.horizontal(padded.data(), across.data() + y * rowBytes, width, weights.data(), taps);
+        }
+
+        std::vector<const sf::Uint8*> rows(taps);
+        for (unsigned y = 0; y < height; ++y) {
+            for (unsigned k = 0; k < taps; ++k) {
+                int source = std::min(std::max(static_cast<int>(y + k) - static_cast<int>(radius), 0), static_cast<int>(height) - 1);
+                rows[k] = across.data() + source * rowBytes;
+            }
+            kernel.vertical(rows.data(), pixels.data() + y * rowBytes, width, weights.data(), taps);
+        }
+    }
+
+    // Full strength at the corners, none inside the middle ellipse
+    void vignette(std::vector<sf::Uint8>& pixels, unsigned width, unsigned height, float strength) {
+        const PixelKernels& kernel = PixelKernels::get();
+        std::vector<float> factors(width);
+        float cx = width / 2.0f;
+        float cy = height / 2.0f;
+        for (unsigned y = 0; y < height; ++y) {
+            float dy = (y + 0.5f - cy) / cy;
+            for (unsigned x = 0; x < width; ++x) {
+                float dx = (x + 0.5f - cx) / cx;
+                float d = std::sqrt((dx * dx + dy * dy) / 2.0f);
+                float t = std::min(std::max((d - 0.35f) / 0.6f, 0.0f), 1.0f);
+                factors[x] = 1.0f - strength * t * t * (3.0f - 2.0f * t);
+            }
+            kernel.scale(pixels.data() + static_cast<std::size_t>(y) * width * 4, width, factors.data());
+        }
+    }
+}
+
+bool ImageFilter::apply(sf::Image& image, const std::string& chain, float scale) {
+    TRACE_SCOPE("ImageFilter::apply");
+    std::vector<Step> steps;
+    if (!parseChain(chain, steps)) {
+        std::cerr << "Bad image filter chain: " << chain << "\n";
+        return false;
+    }
+    if (steps.empty())
+        return true;
+
+    sf::Vector2u size = image.getSize();
+    const sf::Uint8* source = image.getPixelsPtr();
+    if (!source)
+        return true;
+    std::vector<sf::Uint8> pixels(source, source + static_cast<std::size_t>(size.x) * size.y * 4);
+
+    for (const Step& step : steps) {
+        switch (step.kind) {
+        case Step::BLUR:
+            blur(pixels, size.x, size.y, step.amount * scale);
+            break;
+        case Step::COLOR:
+            PixelKernels::get().color(pixels.data(), static_cast<std::size_t>(size.x) * size.y, step.matrix.column);
+            break;
+        case Step::VIGNETTE:
+            vignette(pixels, size.x, size.y, std::min(std::max(step.amount, 0.0f), 1.0f));
+            break;
+        }
+    }
+
+    image.create(size.x, size.y, pixels.data());
+    return true;
+}
+
+const char* ImageFilter::getInstructionSet() {
+    return PixelKernels::get().name;
+}
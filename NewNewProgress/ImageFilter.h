@@ -0,0 +1,29 @@
+#ifndef IMAGEFILTER_HPP
+#define IMAGEFILTER_HPP
+
+#include <SFML/Graphics.hpp>
+#include <string>
+
+// Makes processed variants of an image on the CPU (blurred, graded, darkened), so
+// effects that are fixed for a scene cost nothing per frame and need no shaders.
+// TextureCache runs these on its loader workers for keys like
+// "Biringan2.jpg|blur(6) vignette(0.8)", and caches the result like any texture.
+//
+// The kernels use AVX2 or SSE4.1 when the CPU has them, picked once at startup,
+// and plain C++ otherwise; all three give byte-identical images (KernelTest checks).
+class ImageFilter {
+public:
+    // chain: steps run left to right, separated by spaces
+    //   blur(sigma)          Gaussian blur; sigma in full-resolution pixels
+    //   grayscale, sepia     colour grades
+    //   desaturate(amount)   0 keeps the colour, 1 is grayscale
+    //   darken(amount)       0 unchanged, 1 black
+    //   vignette(strength)   darkens towards the corners; 1 takes them to black
+    // scale: image pixels per full-resolution pixel, below 1 for a reduced texture tier
+    // False (image untouched) if the chain doesn't parse.
+    static bool apply(sf::Image& image, const std::string& chain, float scale = 1.0f);
+
+    static const char* getInstructionSet();     // "AVX2", "SSE4.1" or "scalar"
+};
+
+#endif // IMAGEFILTER_HPP
@@ -0,0 +1,160 @@
+#include "ImageResample.h"
+#include "PixelKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace {
+    float lanczos3(float x) {
+        x = std::fabs(x);
+        if (x < 1e-5f) return 1.0f;
+        if (x >= 3.0f) return 0.0f;
+        const float pi = 3.14159265f;
+        float px = pi * x;
+        return 3.0f * std::sin(px) * std::sin(px / 3.0f) / (px * px);
+    }
+
+    // Which source pixels each output pixel along one axis reads, and how much of each
+    struct Contributions {
+        unsigned taps = 0;
+        std::vector<int> first;         // May run off either end of the image
+        std::vector<float> weights;     // taps per output pixel, summing to 1
+    };
+
+    Contributions contributions(float start, float length, unsigned outSize) {
+        Contributions result;
+        float ratio = length / outSize;
+        float filterScale = std::max(ratio, 1.0f);
+        float support = 3.0f * filterScale;
+        result.taps = static_cast<unsigned>(std::ceil(support * 2.0f)) + 1;
+        result.first.resize(outSize);
+        result.weights.resize(static_cast<std::size_t>(outSize) * result.taps);
+
+        for (unsigned i = 0; i < outSize; ++i) {
+            float centre = start + (i + 0.5f) * ratio;
+            int first = static_cast<int>(std::floor(centre - support));
+            float* weights = &result.weights[static_cast<std::size_t>(i) * result.taps];
+            float total = 0.0f;
+            for (unsigned k = 0; k < result.taps; ++k) {
+                weights[k] = lanczos3((first + static_cast<int>(k) + 0.5f - centre) / filterScale);
+                total += weights[k];
+            }
+            for (unsigned k = 0; k < result.taps; ++k)
+                weights[k] /= total;
+            result.first[i] = first;
+        }
+        return result;
+    }
+}
+
+void ImageResample::halve(sf::Image& image) {
+    sf::Vector2u size = image.getSize();
+    unsigned width = std::max(1u, size.x / 2);
+    unsigned height = std::max(1u, size.y / 2);
+    const sf::Uint8* source = image.getPixelsPtr();
+    std::vector<sf::Uint8> pixels(static_cast<std::size_t>(width) * height * 4);
+
+    for (unsigned y = 0; y < height; ++y) {
+        const sf::Uint8* row0 = source + static_cast<std::size_t>(std::min(y * 2, size.y - 1)) * size.x * 4;
+        const sf::Uint8* row1 = source + static_cast<std::size_t>(std::min(y * 2 + 1, size.y - 1)) * size.x * 4;
+        sf::Uint8* out = &pixels[static_cast<std::size_t>(y) * width * 4];
+        for (unsigned x = 0; x < width; ++x) {
+            std::size_t x0 = static_cast<std::size_t>(std::min(x * 2, size.x - 1)) * 4;
+            std::size_t x1 = static_cast<std::size_t>(std::min(x * 2 + 1, size.x - 1)) * 4;
+            for (std::size_t c = 0; c < 4; ++c)
+                out[x * 4 + c] = static_cast<sf::Uint8>((row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c] + 2) / 4);
+        }
+    }
+    image.create(width, height, pixels.data());
+}
+
+void ImageResample::resize(sf::Image& image, sf::Vector2u size, const sf::FloatRect& area) {
+    sf::Vector2u source = image.getSize();
+    if (size.x == 0 || size.y == 0 || source.x == 0 || source.y == 0)
+        return;
+
+    const PixelKernels& kernel = PixelKernels::get();
+    Contributions across = contributions(area.left, area.width, size.x);
+    Contributions down = contributions(area.top, area.height, size.y);
+
+    // Horizontal pass over only the rows the vertical pass reads, each row padded
+    // with copies of its edge pixels so no tap needs clamping
+    int firstRow = std::max(down.first.front(), 0);
+    int lastRow = std::min(down.first.back() + static_cast<int>(down.taps) - 1, static_cast<int>(source.y) - 1);
+    unsigned padLeft = static_cast<unsigned>(std::max(0, -across.first.front()));
+    unsigned padRight = static_cast<unsigned>(std::max(0, across.first.back() + static_cast<int>(across.taps) - static_cast<int>(source.x)));
+    std::vector<unsigned> starts(size.x);
+    for (unsigned x = 0; x < size.x; ++x)
+        starts[x] = static_cast<unsigned>(across.first[x] + static_cast<int>(padLeft));
+
+    std::size_t sourceRow = static_cast<std::size_t>(source.x) * 4;
+    std::size_t outRow = static_cast<std::size_t>(size.x) * 4;
+    const sf::Uint8* pixels = image.getPixelsPtr();
+    std::vector<sf::Uint8> padded((padLeft + source.x + padRight) * 4);
+    std::vector<sf::Uint8> narrowed((lastRow - firstRow + 1) * outRow);
+    for (int y = firstRow; y <= lastRow; ++y) {
+        const sf::Uint8* row = pixels + y * sourceRow;
+        for (unsigned i = 0; i < padLeft; ++i)
+            std::memcpy(&padded[i * 4], row, 4);
+        std::memcpy(&padded[padLeft * 4], row, sourceRow);
+        for (unsigned i = 0; i < padRight; ++i)
+            std::memcpy(&padded[(padLeft + source.x + i) * 4], row + sourceRow - 4, 4);
+        kernel.resampleRow(padded.data(), &narrowed[(y - firstRow) * outRow], size.x,
+            starts.data(), across.weights.data(), across.taps);
+    }
+
+    std::vector<sf::Uint8> result(size.y * outRow);
+    std::vector<const sf::Uint8*> rows(down.taps);
+    for (unsigned y = 0; y < size.y; ++y) {
+        for (unsigned k = 0; k < down.taps; ++k) {
+            int row = std::min(std::max(down.first[y] + static_cast<int>(k), firstRow), lastRow);
+            rows[k] = &narrowed[(row - firstRow) * outRow];
+        }
+        kernel.vertical(rows.data(), &result[y * outRow], size.x, &down.weights[static_cast<std::size_t>(y) * down.taps], down.taps);
+    }
+    image.create(size.x, size.y, result.data());
+}
+
+sf::Vector2u ImageResample::fittedSize(sf::Vector2u imageSize, sf::Vector2u footprint, FitMode mode) {
+    if (mode != FitMode::LETTERBOX || imageSize.x == 0 || imageSize.y == 0)
+        return footprint;
+    float scale = std::min(static_cast<float>(footprint.x) / imageSize.x, static_cast<float>(footprint.y) / imageSize.y);
+    return sf::Vector2u(std::max(1u, static_cast<unsigned>(imageSize.x * scale + 0.5f)),
+        std::max(1u, static_cast<unsigned>(imageSize.y * scale + 0.5f)));
+}
+
+sf::Vector2u ImageResample::fitResult(sf::Vector2u imageSize, sf::Vector2u footprint, FitMode mode) {
+    if (imageSize.x == 0 || imageSize.y == 0 || footprint.x == 0 || footprint.y == 0)
+        return imageSize;
+
+    // Leave enlarging to the GPU; a bigger texture would only cost memory
+    float scaleX = static_cast<float>(footprint.x) / imageSize.x;
+    float scaleY = static_cast<float>(footprint.y) / imageSize.y;
+    float scale = mode == FitMode::LETTERBOX ? std::min(scaleX, scaleY) : std::max(scaleX, scaleY);
+    if (scale > 1.0f)
+        return imageSize;
+    return fittedSize(imageSize, footprint, mode);
+}
+
+float ImageResample::fit(sf::Image& image, sf::Vector2u footprint, FitMode mode) {
+    sf::Vector2u size = image.getSize();
+    sf::Vector2u fitted = fitResult(size, footprint, mode);
+    if (fitted == size)
+        return 1.0f;
+
+    float scaleX = static_cast<float>(footprint.x) / size.x;
+    float scaleY = static_cast<float>(footprint.y) / size.y;
+    float scale = std::min(scaleX, scaleY);
+    sf::FloatRect area(0.0f, 0.0f, static_cast<float>(size.x), static_cast<float>(size.y));
+    if (mode == FitMode::COVER) {
+        // Only the middle of the image shows; the rest would be off screen
+        scale = std::max(scaleX, scaleY);
+        area.width = footprint.x / scale;
+        area.height = footprint.y / scale;
+        area.left = (size.x - area.width) / 2.0f;
+        area.top = (size.y - area.height) / 2.0f;
+    }
+    resize(image, fitted, area);
+    return scale;
+}
@@ -0,0 +1,39 @@
+#ifndef IMAGERESAMPLE_HPP
+#define IMAGERESAMPLE_HPP
+
+#include <SFML/Graphics.hpp>
+
+// How an image is laid over an area of the screen
+enum class FitMode {
+    COVER,      // Fills it, keeping the aspect ratio; the overflow is cropped
+    LETTERBOX,  // Fits inside it, keeping the aspect ratio
+    STRETCH     // Fills it exactly
+};
+
+// CPU-side image scaling shared by the texture cache and the asset cooker. Plain
+// pixel loops with no GL, so safe on worker threads.
+class ImageResample {
+public:
+    // 2x2 box filter: half the width and height (rounded down, at least 1), each
+    // pixel the average of the four it replaces
+    static void halve(sf::Image& image);
+
+    // Lanczos-3 resample of area (in image pixels) to size. When shrinking, the
+    // kernel widens with the ratio so every source pixel is averaged in and fine
+    // detail doesn't alias. Runs through PixelKernels, so uses AVX2/SSE4.1 if it can.
+    static void resize(sf::Image& image, sf::Vector2u size, const sf::FloatRect& area);
+
+    // Size in pixels the image covers when laid over footprint
+    static sf::Vector2u fittedSize(sf::Vector2u imageSize, sf::Vector2u footprint, FitMode mode);
+
+    // Size fit() leaves the image at: fittedSize, or the image's own size where that
+    // would mean enlarging it
+    static sf::Vector2u fitResult(sf::Vector2u imageSize, sf::Vector2u footprint, FitMode mode);
+
+    // Resamples (and for COVER, crops) the image to exactly what it covers on screen.
+    // Only ever shrinks: an image already no bigger than that is left alone. Returns
+    // the scale applied, image pixels per source pixel (1 if untouched).
+    static float fit(sf::Image& image, sf::Vector2u footprint, FitMode mode);
+};
+
+#endif // IMAGERESAMPLE_HPP
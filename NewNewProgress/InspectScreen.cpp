@@ -0,0 +1,102 @@
+#include "InspectScreen.h"
+#include "Game.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cmath>
+
+InspectScreen::InspectScreen(sf::RenderWindow& win, sf::Font& font, Game& game)
+    : window(win), game(game)
+{
+    hint.setFont(font);
+    hint.setString("Drag to look around, scroll to zoom, Esc to go back");
+    hint.setCharacterSize(22);
+    hint.setFillColor(sf::Color(230, 230, 230));
+    hint.setOutlineColor(sf::Color::Black);
+    hint.setOutlineThickness(2.0f);
+    sf::FloatRect bounds = hint.getLocalBounds();
+    hint.setOrigin(bounds.left + bounds.width / 2.0f, bounds.top + bounds.height);
+    hint.setPosition(window.getSize().x / 2.0f, window.getSize().y - 20.0f);
+}
+
+bool InspectScreen::inspect(const std::string& tiledImage) {
+    if (!view.open(tiledImage))
+        return false;
+
+    // Start on the whole image
+    minZoom = std::min(view.getFitZoom(window.getSize()), maxZoom);
+    zoom = minZoom;
+    sf::Vector2f size = view.getImageSize();
+    center = sf::Vector2f(size.x / 2.0f, size.y / 2.0f);
+    view.setCamera(center, zoom);
+    dragging = false;
+
+    game.changeState(GameState::INSPECT);
+    return true;
+}
+
+// Tiles are only worth keeping while the image is up
+void InspectScreen::onExit() {
+    view.close();
+}
+
+void InspectScreen::handleEvent(const sf::Event& event) {
+    if ((event.type == sf::Event::KeyPressed &&
+        (event.key.code == sf::Keyboard::Escape || event.key.code == sf::Keyboard::Space)) ||
+        (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Right)) {
+        game.getScreens().pop();
+        return;
+    }
+
+    if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
+        dragging = true;
+        lastMouse = sf::Vector2i(event.mouseButton.x, event.mouseButton.y);
+    }
+    else if (event.type == sf::Event::MouseButtonReleased && event.mouseButton.button == sf::Mouse::Left) {
+        dragging = false;
+    }
+    else if (event.type == sf::Event::MouseMoved && dragging) {
+        // The image follows the cursor one for one
+        sf::Vector2i mouse(event.mouseMove.x, event.mouseMove.y);
+        center -= sf::Vector2f(mouse - lastMouse) / view.getZoom();
+        lastMouse = mouse;
+        clampCenter();
+    }
+    else if (event.type == sf::Event::MouseWheelScrolled) {
+        zoomAt(sf::Vector2i(event.mouseWheelScroll.x, event.mouseWheelScroll.y),
+            std::pow(1.25f, event.mouseWheelScroll.delta));
+    }
+}
+
+// Keeps the image point under the cursor where it is
+void InspectScreen::zoomAt(const sf::Vector2i& pixel, float factor) {
+    float next = std::min(std::max(zoom * factor, minZoom), maxZoom);
+    sf::Vector2f fromMiddle = sf::Vector2f(pixel) - sf::Vector2f(window.getSize()) / 2.0f;
+    sf::Vector2f point = center + fromMiddle / zoom;
+    center = point - fromMiddle / next;
+    zoom = next;
+    clampCenter();
+}
+
+// The image can't be dragged off screen; along an axis where it's smaller than the
+// window it stays centred
+void InspectScreen::clampCenter() {
+    sf::Vector2f size = view.getImageSize();
+    sf::Vector2f half = sf::Vector2f(window.getSize()) / (2.0f * zoom);
+    center.x = size.x <= half.x * 2.0f ? size.x / 2.0f : std::min(std::max(center.x, half.x), size.x - half.x);
+    center.y = size.y <= half.y * 2.0f ? size.y / 2.0f : std::min(std::max(center.y, half.y), size.y - half.y);
+}
+
+void InspectScreen::update(float deltaTime) {
+    // Ease zoom in log space and the centre linearly, so a burst of scrolling glides
+    float t = std::min(1.0f, deltaTime * easeRate);
+    float currentZoom = std::exp(std::log(view.getZoom()) + (std::log(zoom) - std::log(view.getZoom())) * t);
+    sf::Vector2f currentCenter = dragging ? center : view.getCenter() + (center - view.getCenter()) * t;
+    view.setCamera(currentCenter, currentZoom);
+    view.update(window.getSize());
+}
+
+void InspectScreen::draw(sf::RenderTarget& target) {
+    view.draw(target);
+    target.draw(hint);
+    PROFILE_DRAW(hint);
+}
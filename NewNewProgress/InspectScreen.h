@@ -0,0 +1,47 @@
+#ifndef INSPECTSCREEN_HPP
+#define INSPECTSCREEN_HPP
+
+#include <SFML/Graphics.hpp>
+#include <string>
+#include "Screen.h"
+#include "TiledImageView.h"
+
+class Game;
+
+// Full-screen look at a large cooked image (the Biringan panorama, the map of the
+// lagusan), pushed over gameplay by an INSPECT cue. Drag to pan, scroll to zoom
+// towards the cursor; Escape, Space or a right-click goes back to the story.
+class InspectScreen : public Screen {
+public:
+    InspectScreen(sf::RenderWindow& window, sf::Font& font, Game& game);
+
+    // Opens the .tiles file and pushes the screen; false (and nothing pushed) if it
+    // can't be read, so the story just carries on
+    bool inspect(const std::string& tiledImage);
+
+    void onExit() override;
+    void handleEvent(const sf::Event& event) override;
+    void update(float deltaTime) override;
+    void draw(sf::RenderTarget& target) override;
+
+private:
+    void zoomAt(const sf::Vector2i& pixel, float factor);
+    void clampCenter();
+
+    sf::RenderWindow& window;
+    Game& game;
+
+    TiledImageView view;
+    sf::Text hint;
+
+    sf::Vector2f center;            // Where the camera is headed; the view eases towards it
+    float zoom = 1.0f;
+    float minZoom = 1.0f;           // Whole image on screen
+    bool dragging = false;
+    sf::Vector2i lastMouse;
+
+    const float maxZoom = 2.0f;     // Screen pixels per image pixel
+    const float easeRate = 12.0f;   // Per second
+};
+
+#endif // INSPECTSCREEN_HPP
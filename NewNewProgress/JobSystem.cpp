@@ -0,0 +1,255 @@
+#include "JobSystem.h"
+#include "Tracer.h"
+#include <algorithm>
+
+namespace {
+    // Index of the worker running on this thread, -1 on the main thread
+    thread_local int currentWorker = -1;
+}
+
+JobSystem::~JobSystem() {
+    shutdown();
+}
+
+void JobSystem::start(unsigned workerCount) {
+    if (running) return;
+
+    if (workerCount == 0) {
+        unsigned cores = std::thread::hardware_concurrency();
+        workerCount = cores > 1 ? cores - 1 : 1;
+    }
+
+    mainThreadId = std::this_thread::get_id();
+    queues.clear();
+    for (unsigned i = 0; i < workerCount; ++i)
+        queues.push_back(std::make_unique<WorkerQueue>());
+
+    running = true;
+    for (unsigned i = 0; i < workerCount; ++i)
+        workers.emplace_back(&JobSystem::workerLoop, this, i);
+}
+
+void JobSystem::shutdown() {
+    if (!running) return;
+
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        running = false;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers)
+        worker.join();
+    workers.clear();
+
+    // Anything left (pending saves in particular) still has to run
+    bool ranSomething = true;
+    while (ranSomething) {
+        ranSomething = runOneMainJob();
+        JobHandle job = stealAny();
+        if (job) {
+            --queuedJobs;
+            execute(job, 0);
+            ranSomething = true;
+        }
+    }
+}
+
+unsigned JobSystem::getWorkerCount() const {
+    return static_cast<unsigned>(workers.size());
+}
+
+JobHandle JobSystem::submit(const std::string& name, std::function<void()> work,
+    const std::vector<JobHandle>& dependencies, JobThread thread) {
+    JobHandle job = std::make_shared<Job>();
+    job->name = name;
+    job->work = std::move(work);
+    job->mainThread = (thread == JobThread::MAIN);
+
+    for (const JobHandle& dependency : dependencies) {
+        if (!dependency) continue;
+        std::lock_guard<std::mutex> lock(dependency->mutex);
+        if (!dependency->done) {
+            dependency->dependents.push_back(job);
+            ++job->unfinished;
+        }
+    }
+
+    // Drop the submission guard; schedule now if nothing is left to wait for
+    if (--job->unfinished == 0)
+        schedule(job);
+    return job;
+}
+
+JobHandle JobSystem::submitMain(const std::string& name, std::function<void()> work,
+    const std::vector<JobHandle>& dependencies) {
+    return submit(name, std::move(work), dependencies, JobThread::MAIN);
+}
+
+bool JobSystem::isDone(const JobHandle& job) {
+    return !job || job->done;
+}
+
+void JobSystem::schedule(const JobHandle& job) {
+    if (job->mainThread) {
+        std::lock_guard<std::mutex> lock(mainMutex);
+        mainJobs.push_back(job);
+        return;
+    }
+
+    // Without workers (not started, or shutting down) just run it here
+    if (!running || queues.empty()) {
+        execute(job, currentWorker >= 0 ? currentWorker + 1 : 0);
+        return;
+    }
+
+    // Workers keep what they spawn (good locality); the main thread deals round-robin
+    unsigned index = currentWorker >= 0
+        ? static_cast<unsigned>(currentWorker)
+        : nextQueue++ % static_cast<unsigned>(queues.size());
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->jobs.push_back(job);
+    }
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        ++queuedJobs;
+    }
+    wake.notify_one();
+}
+
+void JobSystem::execute(const JobHandle& job, unsigned thread) {
+    double start = now();
+#if BIRINGAN_PROFILE
+    std::int64_t traceStart = Tracer::getInstance().now();
+#endif
+    if (job->work)
+        job->work();
+    job->work = nullptr;    // Release captured data right away
+    double duration = now() - start;
+#if BIRINGAN_PROFILE
+    Tracer::getInstance().record(job->name.c_str(), "job", traceStart, Tracer::getInstance().now() - traceStart);
+#endif
+
+    {
+        std::lock_guard<std::mutex> lock(timingMutex);
+        JobTiming timing{ job->name, thread, start, duration };
+        if (timings.size() < maxTimings)
+            timings.push_back(timing);
+        else
+            timings[timingHead] = timing;
+        timingHead = (timingHead + 1) % maxTimings;
+    }
+
+    std::vector<JobHandle> ready;
+    {
+        std::lock_guard<std::mutex> lock(job->mutex);
+        job->done = true;
+        ready.swap(job->dependents);
+    }
+    for (const JobHandle& dependent : ready) {
+        if (--dependent->unfinished == 0)
+            schedule(dependent);
+    }
+}
+
+JobHandle JobSystem::popOrSteal(unsigned index) {
+    {
+        // Own queue: newest first
+        WorkerQueue& own = *queues[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            JobHandle job = own.jobs.back();
+            own.jobs.pop_back();
+            return job;
+        }
+    }
+
+    // Steal the oldest job from someone else
+    for (std::size_t i = 1; i < queues.size(); ++i) {
+        WorkerQueue& victim = *queues[(index + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            JobHandle job = victim.jobs.front();
+            victim.jobs.pop_front();
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+JobHandle JobSystem::stealAny() {
+    for (auto& queue : queues) {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        if (!queue->jobs.empty()) {
+            JobHandle job = queue->jobs.front();
+            queue->jobs.pop_front();
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+void JobSystem::workerLoop(unsigned index) {
+    currentWorker = static_cast<int>(index);
+    TRACE_THREAD_NAME("Worker " + std::to_string(index + 1));
+
+    while (running) {
+        JobHandle job = popOrSteal(index);
+        if (job) {
+            --queuedJobs;
+            execute(job, index + 1);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wake.wait(lock, [this]() { return !running || queuedJobs > 0; });
+    }
+}
+
+bool JobSystem::runOneMainJob() {
+    JobHandle job;
+    {
+        std::lock_guard<std::mutex> lock(mainMutex);
+        if (mainJobs.empty()) return false;
+        job = mainJobs.front();
+        mainJobs.pop_front();
+    }
+    execute(job, 0);
+    return true;
+}
+
+void JobSystem::wait(const JobHandle& job) {
+    while (!isDone(job)) {
+        if (std::this_thread::get_id() == mainThreadId && runOneMainJob())
+            continue;
+
+        JobHandle other = stealAny();
+        if (other) {
+            --queuedJobs;
+            execute(other, currentWorker >= 0 ? currentWorker + 1 : 0);
+            continue;
+        }
+        std::this_thread::yield();
+    }
+}
+
+void JobSystem::runMainThreadJobs(float budgetSeconds) {
+    double deadline = now() + budgetSeconds;
+    do {
+        if (!runOneMainJob()) break;
+    } while (now() < deadline);
+}
+
+std::vector<JobTiming> JobSystem::getRecentTimings() const {
+    std::lock_guard<std::mutex> lock(timingMutex);
+    if (timings.size() < maxTimings)
+        return timings;
+
+    std::vector<JobTiming> ordered(timings.begin() + timingHead, timings.end());
+    ordered.insert(ordered.end(), timings.begin(), timings.begin() + timingHead);
+    return ordered;
+}
+
+double JobSystem::now() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+}
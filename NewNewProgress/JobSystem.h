@@ -0,0 +1,112 @@
+#ifndef JOBSYSTEM_HPP
+#define JOBSYSTEM_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// A unit of work. Jobs start once every job they depend on has finished.
+struct Job {
+    std::string name;
+    std::function<void()> work;
+    bool mainThread = false;            // GL uploads and other main-thread-only work
+
+    std::atomic<int> unfinished{ 1 };   // Dependencies still running (+1 while submitting)
+    std::atomic<bool> done{ false };
+    std::mutex mutex;                   // Guards dependents against a finishing job
+    std::vector<std::shared_ptr<Job>> dependents;
+};
+
+using JobHandle = std::shared_ptr<Job>;
+
+enum class JobThread { WORKER, MAIN };
+
+// Per-job timing, for the profiler
+struct JobTiming {
+    std::string name;
+    unsigned thread;    // 0 = main thread, 1..n = workers
+    double start;       // Seconds since the job system started
+    double duration;
+};
+
+// Small work-stealing scheduler. Every worker owns a deque: it pops its own newest
+// job and steals the oldest job from the others when it runs dry. Main-thread jobs
+// are held until the game loop runs them with runMainThreadJobs().
+class JobSystem {
+public:
+    static JobSystem& getInstance() {
+        static JobSystem instance;
+        return instance;
+    }
+
+    // workerCount 0 = one per core, leaving a core for the main thread
+    void start(unsigned workerCount = 0);
+    void shutdown();    // Finishes everything still queued, then joins the workers
+    unsigned getWorkerCount() const;
+
+    JobHandle submit(const std::string& name, std::function<void()> work,
+        const std::vector<JobHandle>& dependencies = {}, JobThread thread = JobThread::WORKER);
+    JobHandle submitMain(const std::string& name, std::function<void()> work,
+        const std::vector<JobHandle>& dependencies = {});
+
+    // An empty handle counts as done
+    static bool isDone(const JobHandle& job);
+
+    // Main thread only: runs other jobs (including main-thread ones) while it waits
+    void wait(const JobHandle& job);
+
+    // Called once per frame by the game loop; always runs at least one ready job
+    void runMainThreadJobs(float budgetSeconds);
+
+    std::vector<JobTiming> getRecentTimings() const;   // Oldest first
+
+    // Prevent copying
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+private:
+    JobSystem() = default;
+    ~JobSystem();
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<JobHandle> jobs;
+    };
+
+    void workerLoop(unsigned index);
+    void schedule(const JobHandle& job);
+    void execute(const JobHandle& job, unsigned thread);
+    JobHandle popOrSteal(unsigned index);
+    JobHandle stealAny();
+    bool runOneMainJob();
+    double now() const;
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<bool> running{ false };
+    std::atomic<unsigned> nextQueue{ 0 };
+
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    std::atomic<int> queuedJobs{ 0 };
+
+    std::mutex mainMutex;
+    std::deque<JobHandle> mainJobs;
+    std::thread::id mainThreadId;
+
+    mutable std::mutex timingMutex;
+    std::vector<JobTiming> timings;     // Ring buffer
+    std::size_t timingHead = 0;
+    static const std::size_t maxTimings = 512;
+
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+};
+
+#endif // JOBSYSTEM_HPP
@@ -0,0 +1,169 @@
+// Checks that every PixelKernels version this CPU can run gives exactly the same bytes
+// as the plain C++ one, so a filtered or resampled texture doesn't depend on the
+// machine it was made on.
+//
+//   KernelTest [--rounds N]
+//
+// Feeds each kernel random rows (fixed seed) of every width up to a few vectors'
+// worth, blur-like, resample-like and out-of-range weights, and compares the
+// output byte for byte. Exit status is 1 on the first mismatch.
+
+#include <SFML/Graphics.hpp>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "PixelKernels.h"
+
+namespace {
+    std::mt19937 generator(20240611);
+
+    std::vector<sf::Uint8> randomBytes(std::size_t count) {
+        std::uniform_int_distribution<int> byte(0, 255);
+        std::vector<sf::Uint8> bytes(count);
+        for (sf::Uint8& value : bytes)
+            value = static_cast<sf::Uint8>(byte(generator));
+        return bytes;
+    }
+
+    // Weights the way the filters make them: a normalised blur, a resampling filter
+    // with negative lobes, or anything at all so the clamping gets tried too, with
+    // sums well past the int range
+    std::vector<float> randomWeights(std::size_t count, int kind) {
+        std::uniform_real_distribution<float> positive(0.0f, 1.0f);
+        std::uniform_real_distribution<float> any(kind == 3 ? -1.0e8f : -1.5f, kind == 3 ? 1.0e8f : 1.5f);
+        std::vector<float> weights(count);
+        float sum = 0.0f;
+        for (std::size_t i = 0; i < count; ++i) {
+            weights[i] = kind == 0 ? positive(generator) : any(generator);
+            sum += weights[i];
+        }
+        if (kind < 2 && std::fabs(sum) > 0.25f) {
+            for (float& weight : weights)
+                weight /= sum;
+        }
+        return weights;
+    }
+
+    bool same(const std::vector<sf::Uint8>& expected, const std::vector<sf::Uint8>& actual,
+        const PixelKernels& kernels, const char* kernel, unsigned width, unsigned taps) {
+        if (expected == actual)
+            return true;
+        std::size_t i = 0;
+        while (expected[i] == actual[i])
+            ++i;
+        std::cerr << kernels.name << " " << kernel << " differs from scalar (width " << width
+            << ", taps " << taps << "): byte " << i << " is " << int(actual[i])
+            << ", expected " << int(expected[i]) << "\n";
+        return false;
+    }
+
+    bool compare(const PixelKernels& scalar, const PixelKernels& kernels, unsigned width, unsigned taps, int kind) {
+        // horizontal: a row padded by taps - 1 pixels
+        std::vector<sf::Uint8> in = randomBytes((width + taps - 1) * 4);
+        std::vector<float> weights = randomWeights(taps, kind);
+        std::vector<sf::Uint8> expected(width * 4), actual(width * 4);
+        scalar.horizontal(in.data(), expected.data(), width, weights.data(), taps);
+        kernels.horizontal(in.data(), actual.data(), width, weights.data(), taps);
+        if (!same(expected, actual, kernels, "horizontal", width, taps))
+            return false;
+
+        // resampleRow: each output pixel starts somewhere in a row twice as wide
+        unsigned inWidth = width * 2 + taps;
+        in = randomBytes(inWidth * 4);
+        std::uniform_int_distribution<unsigned> start(0, inWidth - taps);
+        std::vector<unsigned> starts(width);
+        for (unsigned& first : starts)
+            first = start(generator);
+        std::vector<float> rowWeights;
+        for (unsigned x = 0; x < width; ++x) {
+            std::vector<float> own = randomWeights(taps, kind);
+            rowWeights.insert(rowWeights.end(), own.begin(), own.end());
+        }
+        scalar.resampleRow(in.data(), expected.data(), width, starts.data(), rowWeights.data(), taps);
+        kernels.resampleRow(in.data(), actual.data(), width, starts.data(), rowWeights.data(), taps);
+        if (!same(expected, actual, kernels, "resampleRow", width, taps))
+            return false;
+
+        // vertical: taps separate rows
+        std::vector<std::vector<sf::Uint8>> rows;
+        std::vector<const sf::Uint8*> rowPointers;
+        for (unsigned k = 0; k < taps; ++k)
+            rows.push_back(randomBytes(width * 4));
+        for (const auto& row : rows)
+            rowPointers.push_back(row.data());
+        scalar.vertical(rowPointers.data(), expected.data(), width, weights.data(), taps);
+        kernels.vertical(rowPointers.data(), actual.data(), width, weights.data(), taps);
+        if (!same(expected, actual, kernels, "vertical", width, taps))
+            return false;
+
+        // color: in place, a random matrix with an offset
+        std::uniform_real_distribution<float> factor(kind == 0 ? 0.0f : -1.5f, 1.5f);
+        std::uniform_real_distribution<float> offset(-64.0f, 64.0f);
+        float column[5][4];
+        for (int j = 0; j < 4; ++j) {
+            for (int c = 0; c < 4; ++c)
+                column[j][c] = factor(generator);
+        }
+        for (int c = 0; c < 4; ++c)
+            column[4][c] = offset(generator);
+        expected = randomBytes(width * 4);
+        actual = expected;
+        scalar.color(expected.data(), width, column);
+        kernels.color(actual.data(), width, column);
+        if (!same(expected, actual, kernels, "color", width, 0))
+            return false;
+
+        // scale: in place, one factor per pixel
+        std::uniform_real_distribution<float> scaleFactor(0.0f, 2.0f);
+        std::vector<float> factors(width);
+        for (float& value : factors)
+            value = scaleFactor(generator);
+        expected = randomBytes(width * 4);
+        actual = expected;
+        scalar.scale(expected.data(), width, factors.data());
+        kernels.scale(actual.data(), width, factors.data());
+        return same(expected, actual, kernels, "scale", width, 0);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int rounds = 20;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--rounds") == 0 && i + 1 < argc) rounds = std::atoi(argv[++i]);
+        else {
+            std::cerr << "usage: KernelTest [--rounds N]\n";
+            return 2;
+        }
+    }
+
+    std::vector<const PixelKernels*> supported = PixelKernels::getSupported();
+    const PixelKernels& scalar = *supported.back();
+    if (supported.size() == 1) {
+        std::cout << "Only the scalar kernels run on this CPU; nothing to compare\n";
+        return 0;
+    }
+
+    for (const PixelKernels* kernels : supported) {
+        if (kernels == &scalar)
+            continue;
+        std::size_t checks = 0;
+        for (int round = 0; round < rounds; ++round) {
+            for (unsigned width = 1; width <= 67; ++width) {
+                for (unsigned taps = 1; taps <= 13; taps += 3) {
+                    for (int kind = 0; kind < 4; ++kind) {
+                        if (!compare(scalar, *kernels, width, taps, kind))
+                            return 1;
+                        ++checks;
+                    }
+                }
+            }
+        }
+        std::cout << kernels->name << ": " << checks << " rows match scalar byte for byte\n";
+    }
+    return 0;
+}
@@ -1,110 +1,189 @@
-#include "LoadScreen.h"
-#include <iostream>
-
-LoadScreen::LoadScreen(sf::RenderWindow& window, sf::Font& titleFont, sf::Font& bodyFont)
-    : window(window), titleFont(titleFont), bodyFont(bodyFont), animationClock() {
-    if (loadScreenTexture.loadFromFile("TitleSC.png")) {
-        background.setTexture(loadScreenTexture);
-    
-
-        // Scale the background to fill the window while keeping the aspect ratio
-        float windowWidth = static_cast<float>(window.getSize().x);
-        float windowHeight = static_cast<float>(window.getSize().y);
-        float textureWidth = static_cast<float>(loadScreenTexture.getSize().x);
-        float textureHeight = static_cast<float>(loadScreenTexture.getSize().y);
-
-        float scale = std::max(windowWidth / textureWidth, windowHeight / textureHeight);
-        background.setScale(scale, scale);
-
-        //center if overflow
-        float offsetX = (textureWidth * scale - windowWidth) / 2.0f;
-        float offsetY = (textureHeight * scale - windowHeight) / 2.0f;
-        background.setPosition(-offsetX, -offsetY);
-    }
-    else {
-        std::cerr << "Failed to load simba.png\n";
-    }
-
-    // Title
-    //title.setFont(titleFont);
-    //title.setString("Load");
-    //title.setCharacterSize(64);
-   // title.setFillColor(sf::Color::White);
-    //title.setPosition(220, 80);
-
-    // Load button
-    loadButton.setFont(bodyFont);
-    loadButton.setString("Load Saved Game");
-    loadButton.setCharacterSize(50);
-    loadButton.setFillColor(sf::Color::Black);
-    loadButton.setPosition(50, 70);
-    // Back button
-    backButton.setFont(bodyFont);
-    backButton.setString("Back");
-    backButton.setCharacterSize(40);
-    backButton.setFillColor(sf::Color::Black);
-    backButton.setPosition(80, 700);
-}
-
-LoadScreen::LoadState LoadScreen::run() {
-    while (window.isOpen()) {
-        sf::Time elapsed = animationClock.getElapsedTime();
-        animateTitle(elapsed.asSeconds());
-
-        sf::Vector2f mousePos = window.mapPixelToCoords(sf::Mouse::getPosition(window));
-        handleMouseHover(mousePos);
-
-        LoadState state = handleEvents(mousePos);
-        if (state != LoadState::LOAD_SUCCESS) return state;
-
-        draw();
-    }
-    return LoadState::BACK;
-}
-
-LoadScreen::LoadState LoadScreen::handleEvents(const sf::Vector2f& mousePos) {
-    sf::Event event;
-    while (window.pollEvent(event)) {
-        if (event.type == sf::Event::Closed) {
-            window.close();
-            return LoadState::BACK;
-        }
-
-        if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
-            if (loadButton.getGlobalBounds().contains(mousePos)) {
-                std::cout << "Loading saved game...\n";
-                return LoadState::LOAD_SUCCESS;
-            }
-            if (backButton.getGlobalBounds().contains(mousePos)) {
-                return LoadState::BACK;
-            }
-        }
-    }
-    return LoadState::LOAD_SUCCESS;
-}
-
-void LoadScreen::handleMouseHover(const sf::Vector2f& mousePos) {
-    if (loadButton.getGlobalBounds().contains(mousePos))
-        loadButton.setFillColor(sf::Color::Red);
-    else
-        loadButton.setFillColor(sf::Color::Black);  // Restore to black
-
-    if (backButton.getGlobalBounds().contains(mousePos))
-        backButton.setFillColor(sf::Color::Red);
-    else
-        backButton.setFillColor(sf::Color::Black);  // Restore to black
-}
-
-void LoadScreen::animateTitle(float time) {
-    float offset = std::sin(time * 2) * 5; // Sine wave for smooth bobbing
-    title.setPosition(220, 80 + offset);
-}
-
-void LoadScreen::draw() {
-    window.clear();
-    window.draw(background);
-    window.draw(title);
-    window.draw(loadButton);
-    window.draw(backButton);
-    window.display();
+#include "LoadScreen.h"
+#include "Game.h"
+#include "SaveManager.h"
+#include "JobSystem.h"
+#include "ImageFilter.h"
+#include "Profiler.h"
+#include "TextureCache.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+
+namespace {
+    const unsigned thumbnailWidth = 320;
+
+    // Box filter: every output pixel is the average of the source pixels it covers
+    bool makeThumbnail(const sf::Image& source, unsigned width, sf::Image& result) {
+        sf::Vector2u size = source.getSize();
+        if (size.x == 0 || size.y == 0)
+            return false;
+
+        unsigned height = std::max(1u, size.y * width / size.x);
+        result.create(width, height);
+        for (unsigned y = 0; y < height; ++y) {
+            unsigned y0 = y * size.y / height;
+            unsigned y1 = std::max(y0 + 1, (y + 1) * size.y / height);
+            for (unsigned x = 0; x < width; ++x) {
+                unsigned x0 = x * size.x / width;
+                unsigned x1 = std::max(x0 + 1, (x + 1) * size.x / width);
+
+                unsigned r = 0, g = 0, b = 0, count = 0;
+                for (unsigned sy = y0; sy < y1; ++sy) {
+                    for (unsigned sx = x0; sx < x1; ++sx) {
+                        sf::Color c = source.getPixel(sx, sy);
+                        r += c.r;
+                        g += c.g;
+                        b += c.b;
+                        ++count;
+                    }
+                }
+                result.setPixel(x, y, sf::Color(static_cast<sf::Uint8>(r / count),
+                    static_cast<sf::Uint8>(g / count), static_cast<sf::Uint8>(b / count)));
+            }
+        }
+        return true;
+    }
+}
+
+LoadScreen::LoadScreen(sf::RenderWindow& window, sf::Font& titleFont, sf::Font& bodyFont, Game& game)
+    : window(window), titleFont(titleFont), bodyFont(bodyFont), game(game), ui(window) {
+
+    // Title
+    //title.setFont(titleFont);
+    //title.setString("Load");
+    //title.setCharacterSize(64);
+   // title.setFillColor(sf::Color::White);
+    //title.setPosition(220, 80);
+
+    // Black, red on hover
+    ButtonStyle normal;
+    normal.content = sf::Color::Black;
+    ButtonStyle hover;
+    hover.content = sf::Color::Red;
+
+    // Load button
+    loadButton.setup(bodyFont, "Load Saved Game", 50);
+    loadButton.setPosition(50, 70);
+    loadButton.setStyles(normal, hover);
+    loadButton.onClick = [this]() {
+        std::cout << "Loading saved game...\n";
+        this->game.changeState(GameState::RESUME);
+    };
+    // Back button
+    backButton.setup(bodyFont, "Back", 40);
+    backButton.setPosition(80, 700);
+    backButton.setStyles(normal, hover);
+    backButton.onClick = [this]() {
+        if (overGame) this->game.getScreens().pop();
+        else this->game.changeState(GameState::TITLE);
+    };
+
+    ui.add(loadButton);
+    ui.add(backButton);
+}
+
+void LoadScreen::onEnter() {
+    overGame = game.getScreens().getDepth() > 1;
+    animationTime = 0.0f;
+    loadBackground();
+    requestThumbnail();
+    ui.syncPointer(sf::Mouse::getPosition(window));
+}
+
+// Not drawn anywhere else, so the cache is free to evict it until we come back
+void LoadScreen::onExit() {
+    loadScreenTexture.reset();
+}
+
+void LoadScreen::onResize() {
+    loadBackground();
+}
+
+// Same key as AboutScreen, so the two share one texture
+void LoadScreen::loadBackground() {
+    loadScreenTexture = TextureCache::getInstance().get(
+        TextureCache::fittedKey("TitleSC.png", window.getSize(), FitMode::COVER));
+    if (loadScreenTexture) {
+        background.setTexture(*loadScreenTexture, true);
+
+        // Scale the background to fill the window while keeping the aspect ratio
+        float windowWidth = window.getDefaultView().getSize().x;
+        float windowHeight = window.getDefaultView().getSize().y;
+        float textureWidth = static_cast<float>(loadScreenTexture->getSize().x);
+        float textureHeight = static_cast<float>(loadScreenTexture->getSize().y);
+
+        float scale = std::max(windowWidth / textureWidth, windowHeight / textureHeight);
+        background.setScale(scale, scale);
+
+        //center if overflow
+        float offsetX = (textureWidth * scale - windowWidth) / 2.0f;
+        float offsetY = (textureHeight * scale - windowHeight) / 2.0f;
+        background.setPosition(-offsetX, -offsetY);
+    }
+    else {
+        std::cerr << "Failed to load TitleSC.png\n";
+    }
+}
+
+void LoadScreen::requestThumbnail() {
+    hasThumbnail = false;
+    unsigned generation = ++thumbnailGeneration;
+
+    SaveManager::waitForSaves();
+    auto image = std::make_shared<sf::Image>();
+    auto ready = std::make_shared<bool>(false);
+
+    JobHandle scale = JobSystem::getInstance().submit("save thumbnail", [image, ready]() {
+        GameProgress progress;
+        sf::Image full;
+        if (!SaveManager::loadProgress("savegame.dat", progress))
+            return;
+        // A filtered background ("path|filters") is filtered again at thumbnail size
+        const std::string& key = progress.backgroundImage;
+        std::size_t bar = key.find('|');
+        if (!full.loadFromFile(key.substr(0, bar)) || !makeThumbnail(full, thumbnailWidth, *image))
+            return;
+        if (bar != std::string::npos)
+            ImageFilter::apply(*image, key.substr(bar + 1), static_cast<float>(thumbnailWidth) / full.getSize().x);
+        *ready = true;
+    });
+
+    JobSystem::getInstance().submitMain("upload thumbnail", [this, image, ready, generation]() {
+        if (!*ready || generation != thumbnailGeneration)
+            return;
+        PROFILE_COUNT(TextureUploads);
+        if (thumbnailTexture.loadFromImage(*image)) {
+            thumbnail.setTexture(thumbnailTexture, true);
+            thumbnail.setPosition(60, 150);
+            hasThumbnail = true;
+        }
+    }, { scale });
+}
+
+void LoadScreen::update(float deltaTime) {
+    animationTime += deltaTime;
+    animateTitle(animationTime);
+    ui.update();
+}
+
+void LoadScreen::handleEvent(const sf::Event& event) {
+    ui.handleEvent(event);
+}
+
+void LoadScreen::animateTitle(float time) {
+    float offset = std::sin(time * 2) * 5; // Sine wave for smooth bobbing
+    title.setPosition(220, 80 + offset);
+}
+
+void LoadScreen::draw(sf::RenderTarget& target) {
+    target.draw(background);
+    PROFILE_DRAW(background);
+    target.draw(title);
+    PROFILE_DRAW(title);
+    if (hasThumbnail) {
+        target.draw(thumbnail);
+        PROFILE_DRAW(thumbnail);
+    }
+    ui.draw(target);
 }
\ No newline at end of file
@@ -1,33 +1,51 @@
-#ifndef LOADSCREEN_HPP
-#define LOADSCREEN_HPP
-
-#include <SFML/Graphics.hpp>
-
-class LoadScreen {
-public:
-    enum class LoadState { LOAD_SUCCESS, BACK };
-
-    LoadScreen(sf::RenderWindow& window, sf::Font& titleFont, sf::Font& bodyFont);
-    LoadState run();
-
-private:
-    sf::RenderWindow& window;
-    sf::Font& titleFont;
-    sf::Font& bodyFont;
-
-    sf::Sprite background;              // Show the background image
-    sf::Texture loadScreenTexture;      
-
-    sf::Text title;
-    sf::Text loadButton;
-    sf::Text backButton;
-
-    sf::Clock animationClock;
-
-    LoadState handleEvents(const sf::Vector2f& mousePos);
-    void handleMouseHover(const sf::Vector2f& mousePos);
-    void animateTitle(float time);
-    void draw();
-};
-
+#ifndef LOADSCREEN_HPP
+#define LOADSCREEN_HPP
+
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include "Screen.h"
+#include "Widget.h"
+#include "WidgetLayer.h"
+
+class Game;
+
+class LoadScreen : public Screen {
+public:
+    LoadScreen(sf::RenderWindow& window, sf::Font& titleFont, sf::Font& bodyFont, Game& game);
+
+    void onEnter() override;
+    void onExit() override;
+    void onResize() override;
+    void handleEvent(const sf::Event& event) override;
+    void update(float deltaTime) override;
+    void draw(sf::RenderTarget& target) override;
+
+private:
+    sf::RenderWindow& window;
+    sf::Font& titleFont;
+    sf::Font& bodyFont;
+    Game& game;
+
+    sf::Sprite background;              // Show the background image
+    std::shared_ptr<const sf::Texture> loadScreenTexture;   // Shared with AboutScreen via TextureCache
+
+    // Preview of the saved scene, scaled down on a worker when the screen opens
+    sf::Texture thumbnailTexture;
+    sf::Sprite thumbnail;
+    bool hasThumbnail = false;
+    unsigned thumbnailGeneration = 0;   // Ignores results from an earlier visit
+
+    sf::Text title;
+    WidgetLayer ui;
+    TextButton loadButton;
+    TextButton backButton;
+
+    float animationTime = 0.0f;
+    bool overGame = false;      // Opened from the pause menu; Back goes back to it
+
+    void loadBackground();
+    void requestThumbnail();
+    void animateTitle(float time);
+};
+
 #endif // LOADSCREEN_HPP
\ No newline at end of file
@@ -0,0 +1,93 @@
+#include "NameEntryScreen.h"
+#include "Game.h"
+#include "TextVariables.h"
+
+NameEntryScreen::NameEntryScreen(sf::RenderWindow& win, sf::Font& titleFont, sf::Font& bodyFont, Game& game)
+    : window(win), game(game), ui(win)
+{
+    float centerX = window.getDefaultView().getSize().x / 2.0f;
+
+    nameLabel.setup(bodyFont, "What's your name?", 32, sf::Color::White);
+    nameLabel.setPosition(centerX - 300.0f, 250.0f);
+    nameField.setup(bodyFont, 30, sf::FloatRect(centerX - 300.0f, 300.0f, 600.0f, 60.0f), maxLength);
+    nameField.onFocus = [this]() { focus(nameField); };
+
+    nicknameLabel.setup(bodyFont, "What do they call you?", 32, sf::Color::White);
+    nicknameLabel.setPosition(centerX - 300.0f, 420.0f);
+    nicknameField.setup(bodyFont, 30, sf::FloatRect(centerX - 300.0f, 470.0f, 600.0f, 60.0f), maxLength);
+    nicknameField.onFocus = [this]() { focus(nicknameField); };
+
+    ButtonStyle normal;
+    normal.outline = sf::Color::White;
+    ButtonStyle hover = normal;
+    hover.fill = sf::Color(255, 255, 255, 60);
+    startButton.setup(titleFont, "Start", 36);
+    startButton.setBox(sf::FloatRect(centerX - 120.0f, 620.0f, 240.0f, 70.0f), 2.0f);
+    startButton.setStyles(normal, hover);
+    startButton.onClick = [this]() { confirm(); };
+
+    ui.add(nameLabel);
+    ui.add(nameField);
+    ui.add(nicknameLabel);
+    ui.add(nicknameField);
+    ui.add(startButton);
+}
+
+void NameEntryScreen::onEnter() {
+    nameField.setString("");
+    nicknameField.setString("");
+    focus(nameField);
+    ui.syncPointer(sf::Mouse::getPosition(window));
+}
+
+void NameEntryScreen::focus(TextField& field) {
+    nameField.setFocused(&field == &nameField);
+    nicknameField.setFocused(&field == &nicknameField);
+}
+
+void NameEntryScreen::handleEvent(const sf::Event& event) {
+    if (event.type == sf::Event::TextEntered) {
+        // Tab and Enter come through as text too; they're handled as keys below
+        if (event.text.unicode == '\t' || event.text.unicode == '\r') return;
+        TextField& field = nicknameField.isFocused() ? nicknameField : nameField;
+        field.type(event.text.unicode);
+        return;
+    }
+    if (event.type == sf::Event::KeyPressed) {
+        if (event.key.code == sf::Keyboard::Tab) {
+            focus(nameField.isFocused() ? nicknameField : nameField);
+            return;
+        }
+        if (event.key.code == sf::Keyboard::Enter) {
+            // Enter on the name moves on to the nickname first
+            if (nameField.isFocused()) focus(nicknameField);
+            else confirm();
+            return;
+        }
+    }
+    ui.handleEvent(event);
+}
+
+// Can't start without a name
+void NameEntryScreen::confirm() {
+    if (nameField.getString().isEmpty()) {
+        focus(nameField);
+        return;
+    }
+
+    std::string name = nameField.getString().toAnsiString();
+    std::string nickname = nicknameField.getString().toAnsiString();
+    if (nickname.empty()) nickname = name;
+
+    TextVariables::getInstance().set(TextVariable::NAME, name);
+    TextVariables::getInstance().set(TextVariable::NICKNAME, nickname);
+    game.changeState(GameState::GAMEPLAY);
+}
+
+void NameEntryScreen::update(float deltaTime) {
+    ui.update();
+}
+
+void NameEntryScreen::draw(sf::RenderTarget& target) {
+    ui.draw(target);
+}
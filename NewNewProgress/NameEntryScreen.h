@@ -0,0 +1,40 @@
+#ifndef NAMEENTRYSCREEN_HPP
+#define NAMEENTRYSCREEN_HPP
+
+#include <SFML/Graphics.hpp>
+#include "Screen.h"
+#include "Widget.h"
+#include "WidgetLayer.h"
+
+class Game;
+
+// Asks for the player's name and nickname before a new game starts; the script's
+// [Name] and [Nickname] are filled in with them. Tab moves between the fields and
+// Enter starts. No nickname means the name is used for both.
+class NameEntryScreen : public Screen {
+public:
+    NameEntryScreen(sf::RenderWindow& window, sf::Font& titleFont, sf::Font& bodyFont, Game& game);
+
+    void onEnter() override;                            // Empty fields, name focused
+    void handleEvent(const sf::Event& event) override;
+    void update(float deltaTime) override;
+    void draw(sf::RenderTarget& target) override;
+
+private:
+    void focus(TextField& field);
+    void confirm();
+
+    sf::RenderWindow& window;
+    Game& game;
+
+    WidgetLayer ui;
+    Label nameLabel;
+    TextField nameField;
+    Label nicknameLabel;
+    TextField nicknameField;
+    TextButton startButton;
+
+    const std::size_t maxLength = 16;
+};
+
+#endif // NAMEENTRYSCREEN_HPP
@@ -0,0 +1,337 @@
+#include "ParticleSystem.h"
+#include "TextureCache.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PARTICLES_SSE2 1
+#include <emmintrin.h>
+#else
+#define PARTICLES_SSE2 0
+#endif
+
+namespace {
+    const float pushRadius = 140.0f;    // View units around the cursor that feel its movement
+    const float pushStrength = 5.0f;    // Per second: how quickly they pick up the cursor's speed
+
+    // White, fading out from the middle; made on first use since it needs a GL context
+    const sf::Texture* getSoftDot() {
+        static sf::Texture dot;
+        static bool made = false;
+        if (!made) {
+            made = true;
+            const unsigned size = 64;
+            sf::Image image;
+            image.create(size, size, sf::Color::Transparent);
+            for (unsigned y = 0; y < size; ++y) {
+                for (unsigned x = 0; x < size; ++x) {
+                    float dx = (x + 0.5f) / size * 2.0f - 1.0f;
+                    float dy = (y + 0.5f) / size * 2.0f - 1.0f;
+                    float fade = std::max(0.0f, 1.0f - std::sqrt(dx * dx + dy * dy));
+                    image.setPixel(x, y, sf::Color(255, 255, 255, static_cast<sf::Uint8>(fade * fade * 255.0f)));
+                }
+            }
+            if (!dot.loadFromImage(image))
+                std::cerr << "Failed to make the particle texture\n";
+            dot.setSmooth(true);
+        }
+        return &dot;
+    }
+
+    sf::Uint8 mix(sf::Uint8 from, sf::Uint8 to, float t) {
+        return static_cast<sf::Uint8>(from + (to - from) * t);
+    }
+}
+
+ParticleSystem::ParticleSystem()
+    : positionX(capacity), positionY(capacity), velocityX(capacity), velocityY(capacity),
+    accelerationX(capacity), accelerationY(capacity), drag(capacity), response(capacity),
+    age(capacity), inverseLife(capacity), emitterOf(capacity) {
+    batches.reserve(maxEmitters);
+}
+
+void ParticleSystem::start(const std::string& name, const ParticleEffect& effect) {
+    // Same name: take over its slot so its particles keep their look until they die
+    std::size_t slot = maxEmitters;
+    for (std::size_t i = 0; i < maxEmitters; ++i) {
+        if (emitters[i].name == name && (emitters[i].emitting || emitters[i].live > 0)) {
+            slot = i;
+            break;
+        }
+    }
+    if (slot == maxEmitters) {
+        for (std::size_t i = 0; i < maxEmitters; ++i) {
+            if (!emitters[i].emitting && emitters[i].live == 0) {
+                slot = i;
+                break;
+            }
+        }
+    }
+    if (slot == maxEmitters) {
+        std::cerr << "Too many particle emitters; not starting " << name << "\n";
+        return;
+    }
+
+    Emitter& emitter = emitters[slot];
+    emitter.name = name;
+    emitter.effect = effect;
+    emitter.texture.reset();
+    if (!effect.texture.empty()) {
+        emitter.texture = TextureCache::getInstance().get(effect.texture);
+        if (!emitter.texture)
+            std::cerr << "Failed to load particle texture: " << effect.texture << "\n";
+    }
+    emitter.elapsed = 0.0f;
+    emitter.owed = 0.0f;
+    emitter.emitting = true;
+    assignBatch(emitter);
+    spawn(slot, effect.burst);
+}
+
+void ParticleSystem::stop(const std::string& name) {
+    for (Emitter& emitter : emitters) {
+        if (emitter.name == name)
+            emitter.emitting = false;
+    }
+}
+
+void ParticleSystem::stopAll() {
+    for (Emitter& emitter : emitters)
+        emitter.emitting = false;
+}
+
+void ParticleSystem::clear() {
+    for (Emitter& emitter : emitters) {
+        emitter.emitting = false;
+        emitter.live = 0;
+        emitter.texture.reset();
+    }
+    count = 0;
+}
+
+void ParticleSystem::setPointer(const sf::Vector2f& position) {
+    if (!hasPointer)
+        lastPointer = position;
+    pointer = position;
+    hasPointer = true;
+}
+
+void ParticleSystem::update(float deltaTime) {
+    PROFILE_SCOPE(ParticleUpdate);
+    if (deltaTime <= 0.0f)
+        return;
+
+    for (std::size_t i = 0; i < maxEmitters; ++i) {
+        Emitter& emitter = emitters[i];
+        if (!emitter.emitting)
+            continue;
+        emitter.elapsed += deltaTime;
+        emitter.owed += emitter.effect.rate * deltaTime;
+        unsigned amount = static_cast<unsigned>(emitter.owed);
+        emitter.owed -= amount;
+        spawn(i, amount);
+        if (emitter.effect.duration > 0.0f && emitter.elapsed >= emitter.effect.duration)
+            emitter.emitting = false;
+    }
+
+    if (hasPointer) {
+        pointerVelocity = (pointer - lastPointer) / deltaTime;
+        lastPointer = pointer;
+    }
+    float pushX = pointerVelocity.x * pushStrength;
+    float pushY = pointerVelocity.y * pushStrength;
+    float inverseRadius2 = 1.0f / (pushRadius * pushRadius);
+
+    // Particles past count are dead slots; running the last group of four over a few
+    // of them is harmless and saves a scalar tail
+    std::size_t i = 0;
+#if PARTICLES_SSE2
+    const __m128 dt = _mm_set1_ps(deltaTime);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 cursorX = _mm_set1_ps(pointer.x);
+    const __m128 cursorY = _mm_set1_ps(pointer.y);
+    const __m128 cursorPushX = _mm_set1_ps(pushX);
+    const __m128 cursorPushY = _mm_set1_ps(pushY);
+    const __m128 falloffScale = _mm_set1_ps(inverseRadius2);
+    for (; i < count; i += 4) {
+        __m128 x = _mm_loadu_ps(&positionX[i]);
+        __m128 y = _mm_loadu_ps(&positionY[i]);
+        __m128 vx = _mm_loadu_ps(&velocityX[i]);
+        __m128 vy = _mm_loadu_ps(&velocityY[i]);
+
+        // Full push at the cursor, none from pushRadius out
+        __m128 dx = _mm_sub_ps(x, cursorX);
+        __m128 dy = _mm_sub_ps(y, cursorY);
+        __m128 distance2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        __m128 falloff = _mm_max_ps(zero, _mm_sub_ps(one, _mm_mul_ps(distance2, falloffScale)));
+        falloff = _mm_mul_ps(falloff, _mm_loadu_ps(&response[i]));
+
+        __m128 ax = _mm_add_ps(_mm_loadu_ps(&accelerationX[i]), _mm_mul_ps(falloff, cursorPushX));
+        __m128 ay = _mm_add_ps(_mm_loadu_ps(&accelerationY[i]), _mm_mul_ps(falloff, cursorPushY));
+        __m128 damping = _mm_max_ps(zero, _mm_sub_ps(one, _mm_mul_ps(_mm_loadu_ps(&drag[i]), dt)));
+        vx = _mm_mul_ps(_mm_add_ps(vx, _mm_mul_ps(ax, dt)), damping);
+        vy = _mm_mul_ps(_mm_add_ps(vy, _mm_mul_ps(ay, dt)), damping);
+
+        _mm_storeu_ps(&velocityX[i], vx);
+        _mm_storeu_ps(&velocityY[i], vy);
+        _mm_storeu_ps(&positionX[i], _mm_add_ps(x, _mm_mul_ps(vx, dt)));
+        _mm_storeu_ps(&positionY[i], _mm_add_ps(y, _mm_mul_ps(vy, dt)));
+        _mm_storeu_ps(&age[i], _mm_add_ps(_mm_loadu_ps(&age[i]), dt));
+    }
+#else
+    for (; i < count; ++i) {
+        float dx = positionX[i] - pointer.x;
+        float dy = positionY[i] - pointer.y;
+        float falloff = std::max(0.0f, 1.0f - (dx * dx + dy * dy) * inverseRadius2) * response[i];
+        float damping = std::max(0.0f, 1.0f - drag[i] * deltaTime);
+        velocityX[i] = (velocityX[i] + (accelerationX[i] + falloff * pushX) * deltaTime) * damping;
+        velocityY[i] = (velocityY[i] + (accelerationY[i] + falloff * pushY) * deltaTime) * damping;
+        positionX[i] += velocityX[i] * deltaTime;
+        positionY[i] += velocityY[i] * deltaTime;
+        age[i] += deltaTime;
+    }
+#endif
+
+    removeDead();
+}
+
+void ParticleSystem::draw(sf::RenderTarget& target) {
+    PROFILE_SCOPE(ParticleDraw);
+    if (count == 0)
+        return;
+
+    // Size each batch's quad list, then fill them all in one pass over the pool
+    for (Batch& batch : batches)
+        batch.count = 0;
+    for (std::size_t i = 0; i < count; ++i)
+        ++batches[emitters[emitterOf[i]].batch].count;
+    for (Batch& batch : batches) {
+        batch.vertices.resize(batch.count * 4);
+        batch.count = 0;
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const Emitter& emitter = emitters[emitterOf[i]];
+        const ParticleEffect& effect = emitter.effect;
+        Batch& batch = batches[emitter.batch];
+        float t = std::min(age[i] * inverseLife[i], 1.0f);
+        float half = (effect.sizeStart + (effect.sizeEnd - effect.sizeStart) * t) / 2.0f;
+        sf::Color color(mix(effect.colorStart.r, effect.colorEnd.r, t), mix(effect.colorStart.g, effect.colorEnd.g, t),
+            mix(effect.colorStart.b, effect.colorEnd.b, t), mix(effect.colorStart.a, effect.colorEnd.a, t));
+        sf::Vector2f size(batch.texture->getSize());
+
+        sf::Vertex* quad = &batch.vertices[batch.count++ * 4];
+        quad[0] = sf::Vertex(sf::Vector2f(positionX[i] - half, positionY[i] - half), color, sf::Vector2f(0.0f, 0.0f));
+        quad[1] = sf::Vertex(sf::Vector2f(positionX[i] + half, positionY[i] - half), color, sf::Vector2f(size.x, 0.0f));
+        quad[2] = sf::Vertex(sf::Vector2f(positionX[i] + half, positionY[i] + half), color, size);
+        quad[3] = sf::Vertex(sf::Vector2f(positionX[i] - half, positionY[i] + half), color, sf::Vector2f(0.0f, size.y));
+    }
+
+    for (Batch& batch : batches) {
+        if (batch.count == 0)
+            continue;
+        sf::RenderStates states(batch.additive ? sf::BlendAdd : sf::BlendAlpha);
+        states.texture = batch.texture;
+        target.draw(batch.vertices, states);
+        PROFILE_DRAW(batch.texture);
+    }
+}
+
+std::size_t ParticleSystem::getCount() const {
+    return count;
+}
+
+bool ParticleSystem::isEmitting(const std::string& name) const {
+    for (const Emitter& emitter : emitters) {
+        if (emitter.name == name && emitter.emitting)
+            return true;
+    }
+    return false;
+}
+
+void ParticleSystem::spawn(std::size_t index, unsigned amount) {
+    Emitter& emitter = emitters[index];
+    const ParticleEffect& effect = emitter.effect;
+    amount = static_cast<unsigned>(std::min<std::size_t>(amount, capacity - count));
+    for (unsigned n = 0; n < amount; ++n, ++count) {
+        positionX[count] = effect.area.left + random() * effect.area.width;
+        positionY[count] = effect.area.top + random() * effect.area.height;
+        velocityX[count] = effect.velocityMin.x + random() * (effect.velocityMax.x - effect.velocityMin.x);
+        velocityY[count] = effect.velocityMin.y + random() * (effect.velocityMax.y - effect.velocityMin.y);
+        accelerationX[count] = effect.acceleration.x;
+        accelerationY[count] = effect.acceleration.y;
+        drag[count] = effect.drag;
+        response[count] = effect.mouseResponse;
+        age[count] = 0.0f;
+        float life = effect.lifeMin + random() * (effect.lifeMax - effect.lifeMin);
+        inverseLife[count] = 1.0f / std::max(life, 0.01f);
+        emitterOf[count] = static_cast<std::uint8_t>(index);
+    }
+    emitter.live += amount;
+}
+
+void ParticleSystem::removeDead() {
+    std::size_t i = 0;
+    while (i < count) {
+        if (age[i] * inverseLife[i] < 1.0f) {
+            ++i;
+            continue;
+        }
+        --emitters[emitterOf[i]].live;
+        --count;
+        positionX[i] = positionX[count];
+        positionY[i] = positionY[count];
+        velocityX[i] = velocityX[count];
+        velocityY[i] = velocityY[count];
+        accelerationX[i] = accelerationX[count];
+        accelerationY[i] = accelerationY[count];
+        drag[i] = drag[count];
+        response[i] = response[count];
+        age[i] = age[count];
+        inverseLife[i] = inverseLife[count];
+        emitterOf[i] = emitterOf[count];
+    }
+}
+
+void ParticleSystem::assignBatch(Emitter& emitter) {
+    const sf::Texture* texture = emitter.texture ? emitter.texture.get() : getSoftDot();
+    for (std::size_t i = 0; i < batches.size(); ++i) {
+        if (batches[i].texture == texture && batches[i].additive == emitter.effect.additive) {
+            emitter.batch = i;
+            return;
+        }
+    }
+
+    // A batch no other emitter is using can be taken over, so the list stays short
+    for (std::size_t i = 0; i < batches.size(); ++i) {
+        bool used = false;
+        for (const Emitter& other : emitters) {
+            if (&other != &emitter && other.batch == i && (other.emitting || other.live > 0))
+                used = true;
+        }
+        if (!used) {
+            batches[i].texture = texture;
+            batches[i].additive = emitter.effect.additive;
+            emitter.batch = i;
+            return;
+        }
+    }
+
+    Batch batch;
+    batch.texture = texture;
+    batch.additive = emitter.effect.additive;
+    batch.vertices.setPrimitiveType(sf::Quads);
+    emitter.batch = batches.size();
+    batches.push_back(batch);
+}
+
+// xorshift32: cheap, and the same sequence every run so the benchmark is repeatable
+float ParticleSystem::random() {
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return (seed >> 8) * (1.0f / 16777216.0f);
+}
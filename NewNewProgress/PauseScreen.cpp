@@ -0,0 +1,168 @@
+#include "PauseScreen.h"
+#include "Game.h"
+#include "GameplayScreen.h"
+#include <string>
+
+namespace {
+    const float buttonWidth = 300.0f;
+    const float buttonHeight = 50.0f;
+    const float buttonGap = 15.0f;
+
+    // 100, 75, 50, 25, off, then back to 100
+    float nextVolume(float volume) {
+        return volume <= 0.0f ? 100.0f : volume - 25.0f;
+    }
+
+    std::string volumeText(const char* name, float volume) {
+        return std::string(name) + ": " + (volume <= 0.0f ? std::string("Off") : std::to_string(static_cast<int>(volume)) + "%");
+    }
+}
+
+PauseScreen::PauseScreen(sf::RenderWindow& win, sf::Font& titleFont, sf::Font& bodyFont, SoundManager& soundManager, Game& game)
+    : window(win), bodyFont(bodyFont), soundManager(soundManager), game(game), snapshot(win), ui(win)
+{
+    title.setup(titleFont, "Paused", 56, sf::Color::White);
+    status.setup(bodyFont, "Game saved", 20, sf::Color(180, 255, 180));
+
+    // Same look as the dialogue box's buttons
+    ButtonStyle normal;
+    normal.fill = sf::Color(50, 50, 50);
+    normal.outline = sf::Color::White;
+    ButtonStyle hover = normal;
+    hover.fill = sf::Color(130, 130, 255);
+
+    resumeButton.setup(bodyFont, "Resume", 24);
+    saveButton.setup(bodyFont, "Save", 24);
+    loadButton.setup(bodyFont, "Load", 24);
+    settingsButton.setup(bodyFont, "Settings", 24);
+    titleButton.setup(bodyFont, "Return to Title", 24);
+    musicButton.setup(bodyFont, "", 24);
+    soundButton.setup(bodyFont, "", 24);
+    backButton.setup(bodyFont, "Back", 24);
+
+    ui.add(panel);
+    ui.add(title);
+    ui.add(status);
+    for (TextButton* button : { &resumeButton, &saveButton, &loadButton, &settingsButton, &titleButton,
+        &musicButton, &soundButton, &backButton }) {
+        button->setStyles(normal, hover);
+        ui.add(*button);
+    }
+
+    resumeButton.onClick = [this]() { resume(); };
+    saveButton.onClick = [this]() {
+        this->game.getGameplayScreen().saveProgress();
+        status.setVisible(true);
+    };
+    // The save file is what gets loaded, so this is the load screen with its preview.
+    // Pushed on top, so backing out of it comes back here with the game still running.
+    loadButton.onClick = [this]() { this->game.getScreens().push(GameState::LOAD); };
+    settingsButton.onClick = [this]() { showSettings(true); };
+    titleButton.onClick = [this]() { this->game.changeState(GameState::TITLE); };
+
+    musicButton.onClick = [this]() {
+        this->soundManager.setMusicVolume(nextVolume(this->soundManager.getMusicVolume()));
+        updateVolumeLabels();
+    };
+    soundButton.onClick = [this]() {
+        this->soundManager.setSoundVolume(nextVolume(this->soundManager.getSoundVolume()));
+        updateVolumeLabels();
+    };
+    backButton.onClick = [this]() { showSettings(false); };
+
+    updateVolumeLabels();
+    showSettings(false);
+}
+
+void PauseScreen::onEnter() {
+    snapshot.invalidate();
+    status.setVisible(false);
+    showSettings(false);
+    soundManager.pauseMusic();
+    ui.syncPointer(sf::Mouse::getPosition(window));
+}
+
+// Back from the load screen
+void PauseScreen::onReveal() {
+    ui.syncPointer(sf::Mouse::getPosition(window));
+}
+
+void PauseScreen::onResize() {
+    snapshot.invalidate();
+}
+
+// Gameplay was only covered, so there's nothing to reload
+void PauseScreen::resume() {
+    soundManager.resumeMusic();
+    game.getScreens().pop();
+}
+
+void PauseScreen::showSettings(bool show) {
+    resumeButton.setVisible(!show);
+    saveButton.setVisible(!show);
+    loadButton.setVisible(!show);
+    settingsButton.setVisible(!show);
+    titleButton.setVisible(!show);
+    musicButton.setVisible(show);
+    soundButton.setVisible(show);
+    backButton.setVisible(show);
+    title.setString(show ? "Settings" : "Paused");
+    layout();
+}
+
+// Changing a button's text means centring it in its box again
+void PauseScreen::updateVolumeLabels() {
+    musicButton.setup(bodyFont, volumeText("Music", soundManager.getMusicVolume()), 24);
+    soundButton.setup(bodyFont, volumeText("Sound", soundManager.getSoundVolume()), 24);
+    layout();
+}
+
+// A column of whichever buttons are showing, centred on the view
+void PauseScreen::layout() {
+    sf::Vector2f size = window.getDefaultView().getSize();
+    const float panelWidth = buttonWidth + 120.0f;
+    const float panelHeight = 5 * (buttonHeight + buttonGap) + 170.0f;
+    float panelX = (size.x - panelWidth) / 2.0f;
+    float panelY = (size.y - panelHeight) / 2.0f;
+    panel.setup(sf::FloatRect(panelX, panelY, panelWidth, panelHeight), sf::Color(0, 0, 0, 200), sf::Color::White, 2);
+
+    sf::Text& titleText = title.getText();
+    sf::FloatRect titleBounds = titleText.getLocalBounds();
+    titleText.setOrigin(titleBounds.left + titleBounds.width / 2.0f, titleBounds.top);
+    title.setPosition(size.x / 2.0f, panelY + 25.0f);
+
+    float x = (size.x - buttonWidth) / 2.0f;
+    float y = panelY + 110.0f;
+    for (TextButton* button : { &resumeButton, &saveButton, &loadButton, &settingsButton, &titleButton,
+        &musicButton, &soundButton, &backButton }) {
+        if (!button->isVisible()) continue;
+        button->setBox(sf::FloatRect(x, y, buttonWidth, buttonHeight), 1);
+        y += buttonHeight + buttonGap;
+    }
+
+    sf::Text& statusText = status.getText();
+    sf::FloatRect statusBounds = statusText.getLocalBounds();
+    statusText.setOrigin(statusBounds.left + statusBounds.width / 2.0f, statusBounds.top);
+    status.setPosition(size.x / 2.0f, panelY + panelHeight - 40.0f);
+}
+
+void PauseScreen::handleEvent(const sf::Event& event) {
+    if (ui.handleEvent(event))
+        return;
+    if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape) {
+        if (backButton.isVisible())
+            showSettings(false);
+        else
+            resume();
+    }
+}
+
+// Gameplay underneath stays frozen: the stack only updates the top screen
+void PauseScreen::update(float deltaTime) {
+    ui.update();
+}
+
+void PauseScreen::draw(sf::RenderTarget& target) {
+    snapshot.draw(target, sf::Color(110, 110, 110));    // Dimmed behind the menu
+    ui.draw(target);
+}
@@ -0,0 +1,60 @@
+#ifndef PAUSESCREEN_HPP
+#define PAUSESCREEN_HPP
+
+#include <SFML/Graphics.hpp>
+#include "Screen.h"
+#include "SceneSnapshot.h"
+#include "SoundManager.h"
+#include "Widget.h"
+#include "WidgetLayer.h"
+
+class Game;
+
+// The system menu, pushed over gameplay with Escape. Gameplay isn't updated while
+// it's up and nothing is unloaded, so resuming just pops it.
+//
+// The scene underneath is kept as a SceneSnapshot, dimmed behind the menu.
+class PauseScreen : public Screen {
+public:
+    PauseScreen(sf::RenderWindow& window, sf::Font& titleFont, sf::Font& bodyFont, SoundManager& soundManager, Game& game);
+
+    void onEnter() override;
+    void onReveal() override;
+    void onResize() override;       // Takes a new snapshot at the new size
+    void handleEvent(const sf::Event& event) override;
+    void update(float deltaTime) override;
+    void draw(sf::RenderTarget& target) override;
+
+    // Only until the snapshot has been taken
+    bool isOverlay() const override { return !snapshot.isCaptured(); }
+
+private:
+    void resume();
+    void showSettings(bool show);
+    void updateVolumeLabels();
+    void layout();
+
+    sf::RenderWindow& window;
+    sf::Font& bodyFont;
+    SoundManager& soundManager;
+    Game& game;
+
+    SceneSnapshot snapshot;
+
+    WidgetLayer ui;
+    Panel panel;
+    Label title;
+    Label status;               // "Game saved"
+    TextButton resumeButton;
+    TextButton saveButton;
+    TextButton loadButton;
+    TextButton settingsButton;
+    TextButton titleButton;
+
+    // Settings page, in place of the menu
+    TextButton musicButton;
+    TextButton soundButton;
+    TextButton backButton;
+};
+
+#endif // PAUSESCREEN_HPP
@@ -0,0 +1,295 @@
+#include "PixelKernels.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define PIXELKERNELS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define PIXELKERNELS_SSE41
+#define PIXELKERNELS_AVX2
+#else
+#define PIXELKERNELS_SSE41 __attribute__((target("sse4.1")))
+#define PIXELKERNELS_AVX2 __attribute__((target("avx2")))
+#endif
+#else
+#define PIXELKERNELS_X86 0
+#endif
+
+namespace {
+    sf::Uint8 toByte(float value) {
+        return static_cast<sf::Uint8>(std::min(std::max(value + 0.5f, 0.0f), 255.0f));
+    }
+
+    void horizontalScalar(const sf::Uint8* in, sf::Uint8* out, unsigned width, const float* weights, unsigned taps) {
+        for (unsigned x = 0; x < width; ++x) {
+            float sum[4] = {};
+            const sf::Uint8* pixel = in + x * 4;
+            for (unsigned k = 0; k < taps; ++k) {
+                for (int c = 0; c < 4; ++c)
+                    sum[c] += weights[k] * pixel[k * 4 + c];
+            }
+            for (int c = 0; c < 4; ++c)
+                out[x * 4 + c] = toByte(sum[c]);
+        }
+    }
+
+    void resampleRowScalar(const sf::Uint8* in, sf::Uint8* out, unsigned width,
+        const unsigned* starts, const float* weights, unsigned taps) {
+        for (unsigned x = 0; x < width; ++x)
+            horizontalScalar(in + starts[x] * 4, out + x * 4, 1, weights + x * taps, taps);
+    }
+
+    void verticalScalar(const sf::Uint8* const* rows, sf::Uint8* out, unsigned width, const float* weights, unsigned taps) {
+        for (unsigned x = 0; x < width; ++x) {
+            float sum[4] = {};
+            for (unsigned k = 0; k < taps; ++k) {
+                for (int c = 0; c < 4; ++c)
+                    sum[c] += weights[k] * rows[k][x * 4 + c];
+            }
+            for (int c = 0; c < 4; ++c)
+                out[x * 4 + c] = toByte(sum[c]);
+        }
+    }
+
+    void colorScalar(sf::Uint8* pixels, std::size_t count, const float (*column)[4]) {
+        for (std::size_t i = 0; i < count; ++i) {
+            sf::Uint8* pixel = pixels + i * 4;
+            float in[4] = { float(pixel[0]), float(pixel[1]), float(pixel[2]), float(pixel[3]) };
+            for (int c = 0; c < 4; ++c) {
+                float sum = column[4][c];
+                for (int j = 0; j < 4; ++j)
+                    sum += column[j][c] * in[j];
+                pixel[c] = toByte(sum);
+            }
+        }
+    }
+
+    void scaleScalar(sf::Uint8* pixels, unsigned width, const float* factors) {
+        for (unsigned x = 0; x < width; ++x) {
+            for (int c = 0; c < 3; ++c)
+                pixels[x * 4 + c] = toByte(pixels[x * 4 + c] * factors[x]);
+        }
+    }
+
+    const PixelKernels scalarKernels = {
+        "scalar", horizontalScalar, resampleRowScalar, verticalScalar, colorScalar, scaleScalar
+    };
+
+#if PIXELKERNELS_X86
+    // One pixel as four floats, and back (rounded, clamped to 0-255). Both steps go
+    // exactly as in toByte: clamp after adding 0.5, then truncate. _mm_cvtps_epi32
+    // would round halves to even, and leaving the clamp to the saturating packs would
+    // turn sums past the int range into 0.
+    PIXELKERNELS_SSE41 inline __m128 loadPixel(const sf::Uint8* pixel) {
+        std::int32_t bytes;
+        std::memcpy(&bytes, pixel, 4);
+        return _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(bytes)));
+    }
+
+    PIXELKERNELS_SSE41 inline void storePixel(sf::Uint8* pixel, __m128 value) {
+        __m128 clamped = _mm_min_ps(_mm_max_ps(_mm_add_ps(value, _mm_set1_ps(0.5f)), _mm_setzero_ps()), _mm_set1_ps(255.0f));
+        __m128i words = _mm_packus_epi32(_mm_cvttps_epi32(clamped), _mm_setzero_si128());
+        std::int32_t bytes = _mm_cvtsi128_si32(_mm_packus_epi16(words, words));
+        std::memcpy(pixel, &bytes, 4);
+    }
+
+    PIXELKERNELS_SSE41 void horizontalSse41(const sf::Uint8* in, sf::Uint8* out, unsigned width, const float* weights, unsigned taps) {
+        for (unsigned x = 0; x < width; ++x) {
+            __m128 sum = _mm_setzero_ps();
+            const sf::Uint8* pixel = in + x * 4;
+            for (unsigned k = 0; k < taps; ++k)
+                sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[k]), loadPixel(pixel + k * 4)));
+            storePixel(out + x * 4, sum);
+        }
+    }
+
+    PIXELKERNELS_SSE41 void resampleRowSse41(const sf::Uint8* in, sf::Uint8* out, unsigned width,
+        const unsigned* starts, const float* weights, unsigned taps) {
+        for (unsigned x = 0; x < width; ++x) {
+            __m128 sum = _mm_setzero_ps();
+            const sf::Uint8* pixel = in + starts[x] * 4;
+            const float* weight = weights + x * taps;
+            for (unsigned k = 0; k < taps; ++k)
+                sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weight[k]), loadPixel(pixel + k * 4)));
+            storePixel(out + x * 4, sum);
+        }
+    }
+
+    PIXELKERNELS_SSE41 void verticalSse41(const sf::Uint8* const* rows, sf::Uint8* out, unsigned width, const float* weights, unsigned taps) {
+        for (unsigned x = 0; x < width; ++x) {
+            __m128 sum = _mm_setzero_ps();
+            for (unsigned k = 0; k < taps; ++k)
+                sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[k]), loadPixel(rows[k] + x * 4)));
+            storePixel(out + x * 4, sum);
+        }
+    }
+
+    PIXELKERNELS_SSE41 void colorSse41(sf::Uint8* pixels, std::size_t count, const float (*column)[4]) {
+        __m128 r = _mm_loadu_ps(column[0]);
+        __m128 g = _mm_loadu_ps(column[1]);
+        __m128 b = _mm_loadu_ps(column[2]);
+        __m128 a = _mm_loadu_ps(column[3]);
+        __m128 offset = _mm_loadu_ps(column[4]);
+        for (std::size_t i = 0; i < count; ++i) {
+            __m128 in = loadPixel(pixels + i * 4);
+            __m128 sum = _mm_add_ps(offset, _mm_mul_ps(r, _mm_shuffle_ps(in, in, 0x00)));
+            sum = _mm_add_ps(sum, _mm_mul_ps(g, _mm_shuffle_ps(in, in, 0x55)));
+            sum = _mm_add_ps(sum, _mm_mul_ps(b, _mm_shuffle_ps(in, in, 0xAA)));
+            sum = _mm_add_ps(sum, _mm_mul_ps(a, _mm_shuffle_ps(in, in, 0xFF)));
+            storePixel(pixels + i * 4, sum);
+        }
+    }
+
+    PIXELKERNELS_SSE41 void scaleSse41(sf::Uint8* pixels, unsigned width, const float* factors) {
+        for (unsigned x = 0; x < width; ++x) {
+            __m128 factor = _mm_set_ps(1.0f, factors[x], factors[x], factors[x]);
+            storePixel(pixels + x * 4, _mm_mul_ps(loadPixel(pixels + x * 4), factor));
+        }
+    }
+
+    const PixelKernels sse41Kernels = {
+        "SSE4.1", horizontalSse41, resampleRowSse41, verticalSse41, colorSse41, scaleSse41
+    };
+
+    // Two pixels at a time as eight floats; an odd last pixel goes through SSE
+    PIXELKERNELS_AVX2 inline __m256 loadPixels(const sf::Uint8* pixels) {
+        return _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(pixels))));
+    }
+
+    PIXELKERNELS_AVX2 inline void storePixels(sf::Uint8* pixels, __m256 value) {
+        __m256 clamped = _mm256_min_ps(_mm256_max_ps(_mm256_add_ps(value, _mm256_set1_ps(0.5f)), _mm256_setzero_ps()),
+            _mm256_set1_ps(255.0f));    // As storePixel
+        __m256i ints = _mm256_cvttps_epi32(clamped);
+        __m128i words = _mm_packus_epi32(_mm256_castsi256_si128(ints), _mm256_extracti128_si256(ints, 1));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(pixels), _mm_packus_epi16(words, words));
+    }
+
+    PIXELKERNELS_AVX2 void horizontalAvx2(const sf::Uint8* in, sf::Uint8* out, unsigned width, const float* weights, unsigned taps) {
+        unsigned x = 0;
+        for (; x + 2 <= width; x += 2) {
+            __m256 sum = _mm256_setzero_ps();
+            const sf::Uint8* pixel = in + x * 4;
+            for (unsigned k = 0; k < taps; ++k)
+                sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_set1_ps(weights[k]), loadPixels(pixel + k * 4)));
+            storePixels(out + x * 4, sum);
+        }
+        if (x < width)
+            horizontalSse41(in + x * 4, out + x * 4, 1, weights, taps);
+    }
+
+    // Two output pixels per step, each with its own source pixel and weight per tap
+    PIXELKERNELS_AVX2 void resampleRowAvx2(const sf::Uint8* in, sf::Uint8* out, unsigned width,
+        const unsigned* starts, const float* weights, unsigned taps) {
+        unsigned x = 0;
+        for (; x + 2 <= width; x += 2) {
+            __m256 sum = _mm256_setzero_ps();
+            const sf::Uint8* first = in + starts[x] * 4;
+            const sf::Uint8* second = in + starts[x + 1] * 4;
+            const float* firstWeights = weights + x * taps;
+            const float* secondWeights = firstWeights + taps;
+            for (unsigned k = 0; k < taps; ++k) {
+                std::int32_t a, b;
+                std::memcpy(&a, first + k * 4, 4);
+                std::memcpy(&b, second + k * 4, 4);
+                __m256 pixels = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_unpacklo_epi32(_mm_cvtsi32_si128(a), _mm_cvtsi32_si128(b))));
+                __m256 weight = _mm256_set_m128(_mm_set1_ps(secondWeights[k]), _mm_set1_ps(firstWeights[k]));
+                sum = _mm256_add_ps(sum, _mm256_mul_ps(weight, pixels));
+            }
+            storePixels(out + x * 4, sum);
+        }
+        if (x < width)
+            resampleRowSse41(in, out + x * 4, 1, starts + x, weights + x * taps, taps);
+    }
+
+    PIXELKERNELS_AVX2 void verticalAvx2(const sf::Uint8* const* rows, sf::Uint8* out, unsigned width, const float* weights, unsigned taps) {
+        unsigned x = 0;
+        for (; x + 2 <= width; x += 2) {
+            __m256 sum = _mm256_setzero_ps();
+            for (unsigned k = 0; k < taps; ++k)
+                sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_set1_ps(weights[k]), loadPixels(rows[k] + x * 4)));
+            storePixels(out + x * 4, sum);
+        }
+        for (; x < width; ++x) {
+            __m128 sum = _mm_setzero_ps();
+            for (unsigned k = 0; k < taps; ++k)
+                sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[k]), loadPixel(rows[k] + x * 4)));
+            storePixel(out + x * 4, sum);
+        }
+    }
+
+    PIXELKERNELS_AVX2 void colorAvx2(sf::Uint8* pixels, std::size_t count, const float (*column)[4]) {
+        __m256 r = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(column[0]));
+        __m256 g = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(column[1]));
+        __m256 b = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(column[2]));
+        __m256 a = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(column[3]));
+        __m256 offset = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(column[4]));
+        std::size_t i = 0;
+        for (; i + 2 <= count; i += 2) {
+            __m256 in = loadPixels(pixels + i * 4);
+            __m256 sum = _mm256_add_ps(offset, _mm256_mul_ps(r, _mm256_shuffle_ps(in, in, 0x00)));
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(g, _mm256_shuffle_ps(in, in, 0x55)));
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(b, _mm256_shuffle_ps(in, in, 0xAA)));
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(a, _mm256_shuffle_ps(in, in, 0xFF)));
+            storePixels(pixels + i * 4, sum);
+        }
+        if (i < count)
+            colorSse41(pixels + i * 4, count - i, column);
+    }
+
+    PIXELKERNELS_AVX2 void scaleAvx2(sf::Uint8* pixels, unsigned width, const float* factors) {
+        unsigned x = 0;
+        for (; x + 2 <= width; x += 2) {
+            __m256 factor = _mm256_set_ps(1.0f, factors[x + 1], factors[x + 1], factors[x + 1],
+                1.0f, factors[x], factors[x], factors[x]);
+            storePixels(pixels + x * 4, _mm256_mul_ps(loadPixels(pixels + x * 4), factor));
+        }
+        if (x < width)
+            scaleSse41(pixels + x * 4, 1, factors + x);
+    }
+
+    const PixelKernels avx2Kernels = {
+        "AVX2", horizontalAvx2, resampleRowAvx2, verticalAvx2, colorAvx2, scaleAvx2
+    };
+
+    std::vector<const PixelKernels*> detect() {
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        int maxLeaf = info[0];
+        __cpuid(info, 1);
+        bool sse41 = (info[2] & (1 << 19)) != 0;
+        bool osSavesAvx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 6) == 6;
+        bool avx2 = false;
+        if (maxLeaf >= 7 && osSavesAvx) {
+            __cpuidex(info, 7, 0);
+            avx2 = (info[1] & (1 << 5)) != 0;
+        }
+#else
+        __builtin_cpu_init();
+        bool sse41 = __builtin_cpu_supports("sse4.1");
+        bool avx2 = __builtin_cpu_supports("avx2");
+#endif
+        std::vector<const PixelKernels*> supported;
+        if (avx2) supported.push_back(&avx2Kernels);
+        if (sse41) supported.push_back(&sse41Kernels);
+        supported.push_back(&scalarKernels);
+        return supported;
+    }
+#else
+    std::vector<const PixelKernels*> detect() {
+        return { &scalarKernels };
+    }
+#endif
+}
+
+const PixelKernels& PixelKernels::get() {
+    static const PixelKernels& chosen = *detect().front();
+    return chosen;
+}
+
+std::vector<const PixelKernels*> PixelKernels::getSupported() {
+    return detect();
+}
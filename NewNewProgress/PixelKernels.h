@@ -0,0 +1,35 @@
+#ifndef PIXELKERNELS_HPP
+#define PIXELKERNELS_HPP
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <vector>
+
+// The inner loops behind ImageFilter and ImageResample, over rows of RGBA bytes.
+// There are AVX2, SSE4.1 and plain C++ versions of each; get() picks the best one
+// the CPU supports the first time it's called. All three give the same bytes, which
+// KernelTest checks.
+struct PixelKernels {
+    const char* name;   // "AVX2", "SSE4.1" or "scalar"
+
+    // One row of a convolution: out[x] is the sum of taps pixels starting at in[x]
+    // (in being a row padded at both ends) weighted by weights[0..taps)
+    void (*horizontal)(const sf::Uint8* in, sf::Uint8* out, unsigned width, const float* weights, unsigned taps);
+    // Resampling: as horizontal, but output x has its own first pixel starts[x] and
+    // its own weights[x * taps ..]
+    void (*resampleRow)(const sf::Uint8* in, sf::Uint8* out, unsigned width,
+        const unsigned* starts, const float* weights, unsigned taps);
+    // out[x] is the sum over k of rows[k][x] weighted by weights[k]
+    void (*vertical)(const sf::Uint8* const* rows, sf::Uint8* out, unsigned width, const float* weights, unsigned taps);
+    // Colour matrix: column[0..3] is the RGBA each input channel adds, column[4] the
+    // offset, all on the 0-255 scale
+    void (*color)(sf::Uint8* pixels, std::size_t count, const float (*column)[4]);
+    // Multiplies each pixel's RGB by factors[x], leaving alpha
+    void (*scale)(sf::Uint8* pixels, unsigned width, const float* factors);
+
+    static const PixelKernels& get();
+    // Every version this CPU can run, best first (so get() is the front); for KernelTest
+    static std::vector<const PixelKernels*> getSupported();
+};
+
+#endif // PIXELKERNELS_HPP
@@ -1,65 +1,60 @@
-#include "PlayIntro.h"
-
-PlayIntroScreen::PlayIntroScreen(sf::RenderWindow& win, sf::Font& tFont, sf::Font& bFont)
-    : window(win), titleFont(tFont), bodyFont(bFont), messageIndex(0)
-{
-    messages = {
-        "Notice: This game is still under development.\nYou may experience bugs or incomplete features.",
-        "Disclaimer: This game is for players 18 and older.\nIt may contain gore and disturbing imagery.",
-        "Chapter 1: Biringan"
-    };
-
-    // Configure SFML text object to display the first message
-    message.setFont(bodyFont);  // Start with body font
-    message.setCharacterSize(24);
-    message.setFillColor(sf::Color::White);
-    message.setString(messages[messageIndex]);
-
-    // Center the text in the window
-    sf::FloatRect bounds = message.getLocalBounds();
-    message.setOrigin(bounds.width / 2, bounds.height / 2);
-    message.setPosition(window.getSize().x / 2.f, window.getSize().y / 2.f);
-}
-
-// Main loop to run the intro screen
-PlayIntroScreen::IntroState PlayIntroScreen::run() {
-    while (window.isOpen()) {
-        sf::Event event;
-        while (window.pollEvent(event)) {
-            // If the window is closed, exit to TITLE screen
-            if (event.type == sf::Event::Closed)
-                return IntroState::QUIT;
-
-            // If left mouse button is clicked, advance message
-            if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
-                messageIndex++;
-
-                // If all messages have been shown, exit to gameplay
-                if (messageIndex >= messages.size())
-                    return IntroState::DONE;
-
-                // If it's the final message (chapter title), style it differently
-                if (messageIndex == messages.size() - 1) {
-                    message.setFont(bodyFont);
-                    message.setCharacterSize(48);
-                }
-                else {
-                    message.setFont(bodyFont);
-                    message.setCharacterSize(24);
-                }
-                // Update the message content
-                message.setString(messages[messageIndex]);
-                // Recenter the message after changing the text
-                sf::FloatRect bounds = message.getLocalBounds();
-                message.setOrigin(bounds.width / 2, bounds.height / 2);
-                message.setPosition(window.getSize().x / 2.f, window.getSize().y / 2.f);
-            }
-        }
-
-        window.clear();
-        window.draw(message);
-        window.display();
-    }
-
-    return IntroState::QUIT;
-}
\ No newline at end of file
+#include "PlayIntro.h"
+#include "Game.h"
+#include "Profiler.h"
+
+PlayIntroScreen::PlayIntroScreen(sf::RenderWindow& win, sf::Font& tFont, sf::Font& bFont, Game& game)
+    : window(win), titleFont(tFont), bodyFont(bFont), game(game), messageIndex(0)
+{
+    messages = {
+        "Notice: This game is still under development.\nYou may experience bugs or incomplete features.",
+        "Disclaimer: This game is for players 18 and older.\nIt may contain gore and disturbing imagery.",
+        "Chapter 1: Biringan"
+    };
+
+    // Configure the label to display the first message
+    message.setup(bodyFont, "", 24, sf::Color::White);  // Start with body font
+    showMessage(0);
+}
+
+// Every new game starts again from the first notice
+void PlayIntroScreen::onEnter() {
+    showMessage(0);
+}
+
+void PlayIntroScreen::handleEvent(const sf::Event& event) {
+    // If left mouse button is clicked, advance message
+    if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
+        // If all messages have been shown, ask for the player's name
+        if (messageIndex + 1 >= messages.size()) {
+            game.changeState(GameState::NAME_ENTRY);
+            return;
+        }
+        showMessage(messageIndex + 1);
+    }
+}
+
+void PlayIntroScreen::update(float deltaTime) {
+    // Nothing animates on the intro cards
+}
+
+void PlayIntroScreen::showMessage(std::size_t index) {
+    messageIndex = index;
+
+    // If it's the final message (chapter title), style it differently
+    sf::Text& text = message.getText();
+    if (messageIndex == messages.size() - 1)
+        text.setCharacterSize(48);
+    else
+        text.setCharacterSize(24);
+
+    // Update the message content
+    message.setString(messages[messageIndex]);
+    // Recenter the message after changing the text
+    sf::FloatRect bounds = text.getLocalBounds();
+    text.setOrigin(bounds.width / 2, bounds.height / 2);
+    message.setPosition(window.getDefaultView().getSize().x / 2.f, window.getDefaultView().getSize().y / 2.f);
+}
+
+void PlayIntroScreen::draw(sf::RenderTarget& target) {
+    message.draw(target);
+}
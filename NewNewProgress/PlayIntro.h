@@ -1,22 +1,34 @@
-#ifndef PLAYINTROSCREEN_HPP
-#define PLAYINTROSCREEN_HPP
-
-#include <SFML/Graphics.hpp>
-
-class PlayIntroScreen {
-public:
-    PlayIntroScreen(sf::RenderWindow& window, sf::Font& titleFont, sf::Font& bodyFont);
-    enum class IntroState { DONE, QUIT };
-    IntroState run();
-
-private:
-    sf::RenderWindow& window;
-    sf::Font& titleFont;
-    sf::Font& bodyFont;
-    sf::Text message;
-    int messageIndex;
-
-    std::vector<std::string> messages;
-};
-
+#ifndef PLAYINTROSCREEN_HPP
+#define PLAYINTROSCREEN_HPP
+
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+#include "Screen.h"
+#include "Widget.h"
+
+class Game;
+
+class PlayIntroScreen : public Screen {
+public:
+    PlayIntroScreen(sf::RenderWindow& window, sf::Font& titleFont, sf::Font& bodyFont, Game& game);
+
+    void onEnter() override;
+    void handleEvent(const sf::Event& event) override;
+    void update(float deltaTime) override;
+    void draw(sf::RenderTarget& target) override;
+
+private:
+    sf::RenderWindow& window;
+    sf::Font& titleFont;
+    sf::Font& bodyFont;
+    Game& game;
+    Label message;      // Nothing to click: any click moves on
+    std::size_t messageIndex;
+
+    std::vector<std::string> messages;
+
+    void showMessage(std::size_t index);
+};
+
 #endif // PLAYINTROSCREEN_HPP
\ No newline at end of file
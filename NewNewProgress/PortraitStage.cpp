@@ -0,0 +1,189 @@
+#include "PortraitStage.h"
+#include "TextureCache.h"
+#include "Tracer.h"
+#include <algorithm>
+#include <iostream>
+
+namespace {
+    const float motionTime = 0.35f;     // Seconds for every entrance, exit and slide
+
+    // Middle of each slot, as a share of the screen width
+    float slotX(StageSlot slot) {
+        switch (slot) {
+        case StageSlot::LEFT: return 0.22f;
+        case StageSlot::RIGHT: return 0.78f;
+        default: return 0.5f;
+        }
+    }
+
+    // Just past the nearer side; the middle comes in from the right
+    float offstageX(float x) {
+        return x < 0.5f ? -0.25f : 1.25f;
+    }
+
+    float smoothstep(float t) {
+        t = std::max(0.0f, std::min(1.0f, t));
+        return t * t * (3.0f - 2.0f * t);
+    }
+}
+
+PortraitStage::PortraitStage(sf::RenderTarget& target) : target(target) {
+}
+
+void PortraitStage::cast(const std::string& name, const CharacterSheet& sheet) {
+    auto known = std::find_if(sheets.begin(), sheets.end(),
+        [&name](const std::pair<std::string, CharacterSheet>& named) { return named.first == name; });
+    if (known != sheets.end())
+        known->second = sheet;
+    else
+        sheets.emplace_back(name, sheet);
+    TextureCache::getInstance().loadAsync(getTextureKey(sheet));
+}
+
+std::string PortraitStage::getTextureKey(const CharacterSheet& sheet) const {
+    return CharacterPortrait::getTextureKey(sheet, target.getSize());
+}
+
+bool PortraitStage::direct(const std::string& name, const StageDirection& direction) {
+    Actor* actor = findActor(name);
+    if (direction.exit) {
+        if (actor) leave(*actor, direction.motion);
+        return actor != nullptr;
+    }
+
+    const CharacterSheet* sheet = findSheet(name);
+    if (!sheet) {
+        std::cerr << "No character sheet for " << name << "\n";
+        return false;
+    }
+
+    // Whoever holds the slot makes way
+    for (Actor& other : actors) {
+        if (&other != actor && !other.leaving && other.slot == direction.slot)
+            leave(other, direction.motion);
+    }
+
+    if (!actor) {
+        TRACE_SCOPE("PortraitStage: enter");
+        Actor entering;
+        entering.name = name;
+        if (!entering.portrait.load(*sheet, target.getSize()))
+            return false;
+        entering.slot = direction.slot;
+        entering.height = sheet->height;
+        float x = slotX(direction.slot);
+        entering.fromX = entering.toX = direction.motion == StageMotion::SLIDE ? offstageX(x) : x;
+        entering.fromOpacity = entering.toOpacity = direction.motion == StageMotion::CUT ? 1.0f : 0.0f;
+        actors.push_back(std::move(entering));
+        actor = &actors.back();
+    }
+    else if (actor->leaving) {
+        actor->leaving = false;     // Called back before they were quite off
+    }
+
+    if (!direction.expression.empty() && !actor->portrait.setExpression(direction.expression))
+        std::cerr << name << " has no expression " << direction.expression << "\n";
+    actor->slot = direction.slot;
+    moveTo(*actor, slotX(direction.slot), 1.0f, direction.motion);
+    place(*actor);
+    return true;
+}
+
+void PortraitStage::exitAll(StageMotion motion) {
+    for (Actor& actor : actors) {
+        if (!actor.leaving)
+            leave(actor, motion);
+    }
+}
+
+void PortraitStage::clear() {
+    actors.clear();
+}
+
+void PortraitStage::refit() {
+    TRACE_SCOPE("PortraitStage::refit");
+    for (Actor& actor : actors) {
+        const CharacterSheet* sheet = findSheet(actor.name);
+        if (sheet)
+            actor.portrait.load(*sheet, target.getSize());
+    }
+}
+
+void PortraitStage::update(float deltaTime) {
+    for (Actor& actor : actors) {
+        actor.time = std::min(actor.time + deltaTime, actor.duration);
+        place(actor);
+    }
+
+    actors.erase(std::remove_if(actors.begin(), actors.end(),
+        [](const Actor& actor) { return actor.leaving && actor.time >= actor.duration; }), actors.end());
+}
+
+void PortraitStage::draw(sf::RenderTarget& renderTarget) {
+    for (Actor& actor : actors)
+        actor.portrait.draw(renderTarget);
+}
+
+bool PortraitStage::isOnStage(const std::string& name) const {
+    return std::any_of(actors.begin(), actors.end(),
+        [&name](const Actor& actor) { return actor.name == name && !actor.leaving; });
+}
+
+std::size_t PortraitStage::getCount() const {
+    return static_cast<std::size_t>(std::count_if(actors.begin(), actors.end(),
+        [](const Actor& actor) { return !actor.leaving; }));
+}
+
+const CharacterSheet* PortraitStage::findSheet(const std::string& name) const {
+    for (const auto& named : sheets) {
+        if (named.first == name)
+            return &named.second;
+    }
+    return nullptr;
+}
+
+PortraitStage::Actor* PortraitStage::findActor(const std::string& name) {
+    for (Actor& actor : actors) {
+        if (actor.name == name)
+            return &actor;
+    }
+    return nullptr;
+}
+
+// Eases from wherever the actor is now, so a change of mind mid-slide doesn't jump
+void PortraitStage::moveTo(Actor& actor, float x, float opacity, StageMotion motion) {
+    actor.fromX = currentX(actor);
+    actor.fromOpacity = currentOpacity(actor);
+    actor.toX = x;
+    actor.toOpacity = opacity;
+    actor.time = 0.0f;
+    actor.duration = motion == StageMotion::CUT ? 0.0f : motionTime;
+    if (motion == StageMotion::CUT) {
+        actor.fromX = x;
+        actor.fromOpacity = opacity;
+    }
+}
+
+void PortraitStage::leave(Actor& actor, StageMotion motion) {
+    float x = currentX(actor);
+    actor.leaving = true;
+    moveTo(actor, motion == StageMotion::SLIDE ? offstageX(x) : x, 0.0f, motion);
+}
+
+// Feet on the bottom of the screen, in view units so a resize doesn't move anyone
+void PortraitStage::place(Actor& actor) {
+    sf::Vector2f screen = target.getDefaultView().getSize();
+    actor.portrait.setHeight(screen.y * actor.height);
+    actor.portrait.setPosition(currentX(actor) * screen.x, screen.y);
+    actor.portrait.setOpacity(currentOpacity(actor));
+}
+
+float PortraitStage::currentX(const Actor& actor) const {
+    float t = actor.duration > 0.0f ? smoothstep(actor.time / actor.duration) : 1.0f;
+    return actor.fromX + (actor.toX - actor.fromX) * t;
+}
+
+float PortraitStage::currentOpacity(const Actor& actor) const {
+    float t = actor.duration > 0.0f ? actor.time / actor.duration : 1.0f;
+    return actor.fromOpacity + (actor.toOpacity - actor.fromOpacity) * t;
+}
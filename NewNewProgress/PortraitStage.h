@@ -0,0 +1,85 @@
+#ifndef PORTRAITSTAGE_HPP
+#define PORTRAITSTAGE_HPP
+
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+#include "CharacterPortrait.h"
+
+enum class StageSlot {
+    LEFT,
+    CENTER,
+    RIGHT
+};
+
+// How a character comes on, goes off or changes slot
+enum class StageMotion {
+    CUT,
+    FADE,
+    SLIDE       // From or to the nearer side of the screen, fading as well
+};
+
+// What a PORTRAIT cue does to one character
+struct StageDirection {
+    StageSlot slot = StageSlot::CENTER;
+    std::string expression;             // "" keeps the current one (the sheet's first on entering)
+    StageMotion motion = StageMotion::FADE;
+    bool exit = false;                  // Leaves instead; slot and expression are ignored
+};
+
+// The characters in front of the background, at up to three slots across the
+// screen. Sheets are registered by name with cast(), and each character on stage
+// holds its sheet's texture from TextureCache, so moving between slots or changing
+// expression never goes near the disk. Whoever is already in a slot steps out when
+// someone else is put there.
+//
+// Drawn in the view set on the target (the camera's, in game), laid out in view units.
+class PortraitStage {
+public:
+    explicit PortraitStage(sf::RenderTarget& target);
+
+    // Who can be put on stage, replacing an earlier sheet with that name. Starts the
+    // sheet loading in the background if it isn't already cached.
+    void cast(const std::string& name, const CharacterSheet& sheet);
+    std::string getTextureKey(const CharacterSheet& sheet) const;   // At the window's current size
+
+    // Brings the character on, or moves them and changes their expression if they're already on
+    bool direct(const std::string& name, const StageDirection& direction);
+    void exitAll(StageMotion motion);
+    void clear();       // Everyone off at once
+    void refit();       // Reloads the sheets on stage at the window's new size
+
+    void update(float deltaTime);
+    void draw(sf::RenderTarget& target);
+
+    bool isOnStage(const std::string& name) const;
+    std::size_t getCount() const;   // Not counting anyone on their way off
+
+private:
+    struct Actor {
+        std::string name;
+        CharacterPortrait portrait;
+        StageSlot slot = StageSlot::CENTER;
+        float height = 0.0f;                // Share of the screen height, from the sheet
+        float fromX = 0.0f, toX = 0.0f;     // Share of the screen width
+        float fromOpacity = 0.0f, toOpacity = 1.0f;
+        float time = 0.0f;
+        float duration = 0.0f;
+        bool leaving = false;
+    };
+
+    const CharacterSheet* findSheet(const std::string& name) const;
+    Actor* findActor(const std::string& name);
+    void moveTo(Actor& actor, float x, float opacity, StageMotion motion);
+    void leave(Actor& actor, StageMotion motion);
+    void place(Actor& actor);
+    float currentX(const Actor& actor) const;
+    float currentOpacity(const Actor& actor) const;
+
+    sf::RenderTarget& target;
+    std::vector<std::pair<std::string, CharacterSheet>> sheets;
+    std::vector<Actor> actors;      // In the order they came on, so the last is in front
+};
+
+#endif // PORTRAITSTAGE_HPP
@@ -0,0 +1,17 @@
+#ifndef PROFILECONFIG_HPP
+#define PROFILECONFIG_HPP
+
+// Profiling and tracing are on in debug builds. Define BIRINGAN_PROFILE=1 to keep
+// them in a release build, or BIRINGAN_PROFILE=0 to strip them from a debug one.
+#ifndef BIRINGAN_PROFILE
+#ifdef _DEBUG
+#define BIRINGAN_PROFILE 1
+#else
+#define BIRINGAN_PROFILE 0
+#endif
+#endif
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#endif // PROFILECONFIG_HPP
@@ -0,0 +1,223 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    // Plain globals so the allocation hook never has to construct anything
+    std::atomic<unsigned> allocationCount{ 0 };
+    std::atomic<unsigned> allocatedBytes{ 0 };
+    std::atomic<unsigned> scopeAllocationCount[Profiler::scopeCount];
+    std::atomic<unsigned> scopeAllocatedBytes[Profiler::scopeCount];
+    thread_local int allocationScope = -1;
+
+    const char* const scopeNames[] = {
+        "Events",
+        "  Widget events",
+        "Update",
+        "  DialogueBox::update",
+        "  Particle update",
+        "Render",
+        "  Background draw",
+        "  Text draw",
+        "  Particle draw",
+        "Display",
+        "Audio",
+        "I/O",
+        "Main-thread jobs"
+    };
+
+    const char* const counterNames[] = {
+        "Draw calls",
+        "Texture binds",
+        "Texture uploads",
+        "Texture evictions",
+        "Allocations",
+        "Allocated bytes"
+    };
+}
+
+#if BIRINGAN_PROFILE
+// Count every heap allocation in the process. Nothing else changes: the memory
+// still comes from malloc and goes back to free.
+void* operator new(std::size_t size) {
+    Profiler::countAllocation(size);
+    if (void* memory = std::malloc(size ? size : 1))
+        return memory;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+#endif
+
+void Profiler::beginFrame() {
+    frameStart = Tracer::getInstance().now();
+    frameOpen = true;
+    lastTexture = nullptr;
+
+    // Only what happens between beginFrame() and endFrame() belongs to the frame
+    allocationCount = 0;
+    allocatedBytes = 0;
+    for (std::size_t i = 0; i < scopeCount; ++i) {
+        scopeAllocationCount[i] = 0;
+        scopeAllocatedBytes[i] = 0;
+    }
+}
+
+void Profiler::endFrame() {
+    if (!frameOpen) return;
+    frameOpen = false;
+
+    Tracer& tracer = Tracer::getInstance();
+    std::int64_t frameTime = tracer.now() - frameStart;
+#if BIRINGAN_PROFILE
+    tracer.record("Frame", "frame", frameStart, frameTime);
+#endif
+    counters[static_cast<std::size_t>(ProfileCounter::Allocations)] = allocationCount.exchange(0);
+    counters[static_cast<std::size_t>(ProfileCounter::AllocatedBytes)] = allocatedBytes.exchange(0);
+    for (std::size_t i = 0; i < scopeCount; ++i) {
+        lastScopeAllocations[i] = scopeAllocationCount[i].exchange(0);
+        lastScopeBytes[i] = scopeAllocatedBytes[i].exchange(0);
+    }
+
+    lastScopeTimes = scopeTimes;
+    lastCounters = counters;
+
+    frameHistory[historyHead] = frameTime * 1e-9;
+    scopeHistory[historyHead] = scopeTimes;
+    historyHead = (historyHead + 1) % historySize;
+    historyCount = std::min(historyCount + 1, historySize);
+
+    scopeTimes.fill(0.0);
+    counters.fill(0);
+}
+
+void Profiler::addScopeTime(ProfileScope scope, double seconds) {
+    scopeTimes[static_cast<std::size_t>(scope)] += seconds;
+}
+
+void Profiler::count(ProfileCounter counter, unsigned amount) {
+    counters[static_cast<std::size_t>(counter)] += amount;
+}
+
+void Profiler::countDraw(const sf::Texture* texture) {
+    count(ProfileCounter::DrawCalls);
+    if (texture && texture != lastTexture)
+        count(ProfileCounter::TextureBinds);
+    lastTexture = texture;
+}
+
+void Profiler::countDraw(const sf::Sprite& sprite) {
+    countDraw(sprite.getTexture());
+}
+
+void Profiler::countDraw(const sf::Text& text) {
+    const sf::Font* font = text.getFont();
+    countDraw(font ? &font->getTexture(text.getCharacterSize()) : nullptr);
+}
+
+void Profiler::countDraw(const sf::Shape& shape) {
+    countDraw(shape.getTexture());
+}
+
+void Profiler::countAllocation(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(static_cast<unsigned>(size), std::memory_order_relaxed);
+    if (allocationScope >= 0) {
+        scopeAllocationCount[allocationScope].fetch_add(1, std::memory_order_relaxed);
+        scopeAllocatedBytes[allocationScope].fetch_add(static_cast<unsigned>(size), std::memory_order_relaxed);
+    }
+}
+
+int Profiler::enterAllocationScope(ProfileScope scope) {
+    int previous = allocationScope;
+    allocationScope = static_cast<int>(scope);
+    return previous;
+}
+
+void Profiler::leaveAllocationScope(int previous) {
+    allocationScope = previous;
+}
+
+double Profiler::getLastFrameTime() const {
+    if (historyCount == 0) return 0.0;
+    return frameHistory[(historyHead + historySize - 1) % historySize];
+}
+
+double Profiler::getScopeTime(ProfileScope scope) const {
+    return lastScopeTimes[static_cast<std::size_t>(scope)];
+}
+
+double Profiler::getScopePeak(ProfileScope scope) const {
+    double peak = 0.0;
+    for (std::size_t i = 0; i < historyCount; ++i)
+        peak = std::max(peak, scopeHistory[i][static_cast<std::size_t>(scope)]);
+    return peak;
+}
+
+unsigned Profiler::getCounter(ProfileCounter counter) const {
+    return lastCounters[static_cast<std::size_t>(counter)];
+}
+
+unsigned Profiler::getScopeAllocations(ProfileScope scope) const {
+    return lastScopeAllocations[static_cast<std::size_t>(scope)];
+}
+
+unsigned Profiler::getScopeAllocatedBytes(ProfileScope scope) const {
+    return lastScopeBytes[static_cast<std::size_t>(scope)];
+}
+
+std::size_t Profiler::getHistoryCount() const {
+    return historyCount;
+}
+
+double Profiler::getHistory(std::size_t index) const {
+    std::size_t oldest = (historyHead + historySize - historyCount) % historySize;
+    return frameHistory[(oldest + index) % historySize];
+}
+
+double Profiler::getPercentile(double percent) const {
+    if (historyCount == 0) return 0.0;
+
+    // Fixed-size copy so asking for a percentile doesn't allocate
+    std::array<double, historySize> sorted;
+    std::copy(frameHistory.begin(), frameHistory.begin() + historyCount, sorted.begin());
+
+    std::size_t rank = static_cast<std::size_t>(percent / 100.0 * (historyCount - 1) + 0.5);
+    std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.begin() + historyCount);
+    return sorted[rank];
+}
+
+const char* Profiler::getScopeName(ProfileScope scope) {
+    return scopeNames[static_cast<std::size_t>(scope)];
+}
+
+const char* Profiler::getTraceName(ProfileScope scope) {
+    const char* name = getScopeName(scope);
+    while (*name == ' ')
+        ++name;
+    return name;
+}
+
+const char* Profiler::getCounterName(ProfileCounter counter) {
+    return counterNames[static_cast<std::size_t>(counter)];
+}
@@ -0,0 +1,150 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "ProfileConfig.h"
+#include "Tracer.h"
+
+// Everything the overlay breaks frame time down into. Scopes nest (Update contains
+// DialogueUpdate), so times are inclusive and don't add up to the frame.
+enum class ProfileScope {
+    Events,
+    WidgetEvents,   // Hover and clicks, resolved by each screen's WidgetLayer
+    Update,
+    DialogueUpdate,
+    ParticleUpdate,
+    Render,
+    BackgroundDraw,
+    TextDraw,
+    ParticleDraw,
+    Display,        // Buffer swap, including the vsync wait
+    Audio,
+    IO,             // Synchronous file reads and waits on save jobs
+    MainJobs,       // Texture uploads and other main-thread jobs
+    Count
+};
+
+enum class ProfileCounter {
+    DrawCalls,
+    TextureBinds,   // Draws whose texture differs from the previous draw's
+    TextureUploads,
+    TextureEvictions,
+    Allocations,
+    AllocatedBytes,
+    Count
+};
+
+// Frame timings for the debug overlay. Main thread only, apart from the allocation
+// counters, which every thread bumps. Allocations are also charged to the innermost
+// profile scope open on the allocating thread.
+class Profiler {
+public:
+    static Profiler& getInstance() {
+        static Profiler instance;
+        return instance;
+    }
+
+    static const std::size_t historySize = 240;    // Four seconds at 60 fps
+    static const std::size_t scopeCount = static_cast<std::size_t>(ProfileScope::Count);
+    static const std::size_t counterCount = static_cast<std::size_t>(ProfileCounter::Count);
+
+    void beginFrame();
+    void endFrame();
+
+    void addScopeTime(ProfileScope scope, double seconds);
+    void count(ProfileCounter counter, unsigned amount = 1);
+
+    // Draw accounting: one draw call, plus a bind when the texture changes
+    void countDraw(const sf::Texture* texture);
+    void countDraw(const sf::Sprite& sprite);
+    void countDraw(const sf::Text& text);
+    void countDraw(const sf::Shape& shape);
+
+    // Called from the global operator new hook
+    static void countAllocation(std::size_t size);
+    // ProfileTimer keeps track of the scope allocations are charged to; -1 = none
+    static int enterAllocationScope(ProfileScope scope);
+    static void leaveAllocationScope(int previous);
+
+    // Results for the last finished frame
+    double getLastFrameTime() const;
+    double getScopeTime(ProfileScope scope) const;
+    double getScopePeak(ProfileScope scope) const;     // Worst over the history
+    unsigned getCounter(ProfileCounter counter) const;
+    unsigned getScopeAllocations(ProfileScope scope) const;    // Innermost scope only
+    unsigned getScopeAllocatedBytes(ProfileScope scope) const;
+
+    // Frame times (seconds), oldest first
+    std::size_t getHistoryCount() const;
+    double getHistory(std::size_t index) const;
+    double getPercentile(double percent) const;
+
+    static const char* getScopeName(ProfileScope scope);     // Indented to show nesting
+    static const char* getTraceName(ProfileScope scope);
+    static const char* getCounterName(ProfileCounter counter);
+
+    // Prevent copying
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+private:
+    Profiler() = default;
+
+    std::int64_t frameStart = 0;   // Tracer clock, nanoseconds
+    bool frameOpen = false;
+    const sf::Texture* lastTexture = nullptr;
+
+    std::array<double, scopeCount> scopeTimes{};
+    std::array<unsigned, counterCount> counters{};
+
+    std::array<double, scopeCount> lastScopeTimes{};
+    std::array<unsigned, counterCount> lastCounters{};
+    std::array<unsigned, scopeCount> lastScopeAllocations{};
+    std::array<unsigned, scopeCount> lastScopeBytes{};
+
+    // Ring buffers of finished frames
+    std::array<double, historySize> frameHistory{};
+    std::array<std::array<double, scopeCount>, historySize> scopeHistory{};
+    std::size_t historyHead = 0;
+    std::size_t historyCount = 0;
+};
+
+// Times the enclosing block into a scope, and puts it on the trace timeline too
+class ProfileTimer {
+public:
+    explicit ProfileTimer(ProfileScope scope)
+        : scope(scope), previousScope(Profiler::enterAllocationScope(scope)),
+        start(Tracer::getInstance().now()) {
+    }
+
+    ~ProfileTimer() {
+        Profiler::leaveAllocationScope(previousScope);
+        Tracer& tracer = Tracer::getInstance();
+        std::int64_t duration = tracer.now() - start;
+        Profiler::getInstance().addScopeTime(scope, duration * 1e-9);
+        tracer.record(Profiler::getTraceName(scope), "frame", start, duration);
+    }
+
+    ProfileTimer(const ProfileTimer&) = delete;
+    ProfileTimer& operator=(const ProfileTimer&) = delete;
+
+private:
+    ProfileScope scope;
+    int previousScope;
+    std::int64_t start;
+};
+
+#if BIRINGAN_PROFILE
+#define PROFILE_SCOPE(scope) ProfileTimer PROFILE_CONCAT(profileTimer, __LINE__)(ProfileScope::scope)
+#define PROFILE_COUNT(counter) Profiler::getInstance().count(ProfileCounter::counter)
+#define PROFILE_DRAW(drawable) Profiler::getInstance().countDraw(drawable)
+#else
+#define PROFILE_SCOPE(scope) ((void)0)
+#define PROFILE_COUNT(counter) ((void)0)
+#define PROFILE_DRAW(drawable) ((void)0)
+#endif
+
+#endif // PROFILER_HPP
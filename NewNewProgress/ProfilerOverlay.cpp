@@ -0,0 +1,208 @@
+#include "ProfilerOverlay.h"
+#include "Profiler.h"
+#include "JobSystem.h"
+#include "TextureCache.h"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+    const sf::Vector2f origin(20.0f, 20.0f);
+    const float histogramTop = 140.0f;
+    const float histogramHeight = 60.0f;
+
+    // Upper edge of each histogram bucket in milliseconds; the last one is open-ended
+    const float bucketEdges[] = { 4.0f, 8.0f, 12.0f, 16.7f, 25.0f, 33.3f, 50.0f, 1e9f };
+    const std::size_t bucketCount = sizeof(bucketEdges) / sizeof(bucketEdges[0]);
+
+    sf::Color frameColor(float ms) {
+        if (ms > 33.3f) return sf::Color(255, 80, 80);
+        if (ms > 16.7f) return sf::Color(255, 200, 60);
+        return sf::Color(90, 220, 90);
+    }
+}
+
+ProfilerOverlay::ProfilerOverlay(sf::Font& font)
+    : font(font),
+    graph(sf::LineStrip, Profiler::historySize),
+    budgetLines(sf::Lines, 4),
+    histogram(sf::Quads, bucketCount * 4)
+{
+    panel.setPosition(10.0f, 10.0f);
+    panel.setSize(sf::Vector2f(graphWidth + 20.0f, 860.0f));
+    panel.setFillColor(sf::Color(0, 0, 0, 190));
+
+    float y60 = origin.y + graphHeight - 16.7f / graphMaxMs * graphHeight;
+    float y30 = origin.y + graphHeight - 33.3f / graphMaxMs * graphHeight;
+    sf::Color lineColor(255, 255, 255, 70);
+    budgetLines[0] = sf::Vertex(sf::Vector2f(origin.x, y60), lineColor);
+    budgetLines[1] = sf::Vertex(sf::Vector2f(origin.x + graphWidth, y60), lineColor);
+    budgetLines[2] = sf::Vertex(sf::Vector2f(origin.x, y30), lineColor);
+    budgetLines[3] = sf::Vertex(sf::Vector2f(origin.x + graphWidth, y30), lineColor);
+
+    const char* const bucketNames[] = { "<4", "<8", "<12", "<17", "<25", "<33", "<50", "50+ ms" };
+    float barWidth = graphWidth / bucketCount;
+    for (std::size_t b = 0; b < bucketCount; ++b) {
+        sf::Text label(bucketNames[b], font, 12);
+        label.setFillColor(sf::Color(200, 200, 200));
+        label.setPosition(origin.x + b * barWidth + 2.0f, histogramTop + histogramHeight + 2.0f);
+        bucketLabels.push_back(label);
+    }
+
+    statLabels.setFont(font);
+    statLabels.setCharacterSize(16);
+    statLabels.setFillColor(sf::Color::White);
+    statLabels.setPosition(origin.x, histogramTop + histogramHeight + 24.0f);
+
+    statValues = statLabels;
+    statValues.setPosition(origin.x + 270.0f, histogramTop + histogramHeight + 24.0f);
+}
+
+void ProfilerOverlay::toggle() {
+    visible = !visible;
+    framesSinceRefresh = refreshFrames;     // Fill the text in on the first frame
+}
+
+bool ProfilerOverlay::isVisible() const {
+    return visible;
+}
+
+void ProfilerOverlay::buildGraph() {
+    const Profiler& profiler = Profiler::getInstance();
+    std::size_t count = profiler.getHistoryCount();
+    float step = graphWidth / static_cast<float>(Profiler::historySize - 1);
+
+    // Newest frame on the right; unused points sit on the baseline
+    std::size_t offset = Profiler::historySize - count;
+    for (std::size_t i = 0; i < Profiler::historySize; ++i) {
+        float ms = i >= offset ? static_cast<float>(profiler.getHistory(i - offset) * 1000.0) : 0.0f;
+        float height = std::min(ms, graphMaxMs) / graphMaxMs * graphHeight;
+        graph[i].position = sf::Vector2f(origin.x + i * step, origin.y + graphHeight - height);
+        graph[i].color = frameColor(ms);
+    }
+}
+
+void ProfilerOverlay::buildHistogram() {
+    const Profiler& profiler = Profiler::getInstance();
+    std::size_t count = profiler.getHistoryCount();
+
+    unsigned buckets[bucketCount] = {};
+    for (std::size_t i = 0; i < count; ++i) {
+        float ms = static_cast<float>(profiler.getHistory(i) * 1000.0);
+        std::size_t bucket = 0;
+        while (ms > bucketEdges[bucket] && bucket + 1 < bucketCount)
+            ++bucket;
+        ++buckets[bucket];
+    }
+
+    float barWidth = graphWidth / bucketCount;
+    for (std::size_t b = 0; b < bucketCount; ++b) {
+        float share = count ? static_cast<float>(buckets[b]) / count : 0.0f;
+        float left = origin.x + b * barWidth + 2.0f;
+        float right = left + barWidth - 4.0f;
+        float bottom = histogramTop + histogramHeight;
+        float top = bottom - share * histogramHeight;
+        sf::Color color = frameColor(b == 0 ? 0.0f : bucketEdges[b - 1] + 0.1f);
+
+        histogram[b * 4 + 0] = sf::Vertex(sf::Vector2f(left, top), color);
+        histogram[b * 4 + 1] = sf::Vertex(sf::Vector2f(right, top), color);
+        histogram[b * 4 + 2] = sf::Vertex(sf::Vector2f(right, bottom), color);
+        histogram[b * 4 + 3] = sf::Vertex(sf::Vector2f(left, bottom), color);
+    }
+}
+
+// The font is proportional, so names and numbers are kept in two aligned columns
+void ProfilerOverlay::refreshText() {
+    const Profiler& profiler = Profiler::getInstance();
+    std::string labels;
+    std::string values;
+    char line[128];
+
+    std::snprintf(line, sizeof(line), "Frame %.2f ms   p50 %.2f   p95 %.2f   p99 %.2f\n",
+        profiler.getLastFrameTime() * 1000.0, profiler.getPercentile(50.0) * 1000.0,
+        profiler.getPercentile(95.0) * 1000.0, profiler.getPercentile(99.0) * 1000.0);
+    labels += line;
+    values += "\n";
+
+#if BIRINGAN_PROFILE
+    labels += "\nScope (ms)\n";
+    values += "\nlast      peak      allocs\n";
+    for (std::size_t i = 0; i < Profiler::scopeCount; ++i) {
+        ProfileScope scope = static_cast<ProfileScope>(i);
+        labels += Profiler::getScopeName(scope);
+        labels += "\n";
+        std::snprintf(line, sizeof(line), "%.3f    %.3f    %u\n",
+            profiler.getScopeTime(scope) * 1000.0, profiler.getScopePeak(scope) * 1000.0,
+            profiler.getScopeAllocations(scope));
+        values += line;
+    }
+
+    labels += "\nPer frame\n";
+    values += "\n\n";
+    for (std::size_t i = 0; i < Profiler::counterCount; ++i) {
+        ProfileCounter counter = static_cast<ProfileCounter>(i);
+        labels += Profiler::getCounterName(counter);
+        labels += "\n";
+        std::snprintf(line, sizeof(line), "%u\n", profiler.getCounter(counter));
+        values += line;
+    }
+#else
+    labels += "\nScope timers are compiled out (build with BIRINGAN_PROFILE=1)\n";
+    values += "\n\n";
+#endif
+
+    // Texture residency against the budget
+    TextureResidency residency = TextureCache::getInstance().getResidency();
+    const double megabyte = 1024.0 * 1024.0;
+    labels += "\nTextures\n";
+    values += "\n\n";
+    labels += "Resident / budget\n";
+    std::snprintf(line, sizeof(line), "%.1f / %.0f MB\n",
+        residency.residentBytes / megabyte, residency.budgetBytes / megabyte);
+    values += line;
+    labels += "In use (not evictable)\n";
+    std::snprintf(line, sizeof(line), "%u of %u, %.1f MB\n",
+        residency.inUse, residency.textures, residency.inUseBytes / megabyte);
+    values += line;
+    labels += "Reduced tier / evicted\n";
+    std::snprintf(line, sizeof(line), "%u / %u\n", residency.reduced, TextureCache::getInstance().getStats().evictions);
+    values += line;
+
+    // Where background loading time went
+    std::vector<JobTiming> jobs = JobSystem::getInstance().getRecentTimings();
+    std::sort(jobs.begin(), jobs.end(), [](const JobTiming& a, const JobTiming& b) {
+        return a.duration > b.duration;
+    });
+    labels += "\nSlowest recent jobs\n";
+    values += "\n\n";
+    for (std::size_t i = 0; i < jobs.size() && i < 4; ++i) {
+        std::snprintf(line, sizeof(line), "%.30s\n", jobs[i].name.c_str());
+        labels += line;
+        std::snprintf(line, sizeof(line), "%.2f ms  (thread %u)\n", jobs[i].duration * 1000.0, jobs[i].thread);
+        values += line;
+    }
+
+    statLabels.setString(labels);
+    statValues.setString(values);
+}
+
+void ProfilerOverlay::draw(sf::RenderTarget& target) {
+    if (!visible) return;
+
+    if (++framesSinceRefresh >= refreshFrames) {
+        framesSinceRefresh = 0;
+        refreshText();
+        buildHistogram();
+    }
+    buildGraph();
+
+    target.draw(panel);
+    target.draw(budgetLines);
+    target.draw(graph);
+    target.draw(histogram);
+    for (const sf::Text& label : bucketLabels)
+        target.draw(label);
+    target.draw(statLabels);
+    target.draw(statValues);
+}
@@ -0,0 +1,41 @@
+#ifndef PROFILEROVERLAY_HPP
+#define PROFILEROVERLAY_HPP
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+// Debug panel over the top-left corner: frame-time graph, histogram with percentiles,
+// per-scope CPU times and per-frame counters. Toggled by Game on F3.
+class ProfilerOverlay {
+public:
+    explicit ProfilerOverlay(sf::Font& font);
+
+    void toggle();
+    bool isVisible() const;
+
+    void draw(sf::RenderTarget& target);
+
+private:
+    void refreshText();
+    void buildGraph();
+    void buildHistogram();
+
+    sf::Font& font;
+    bool visible = false;
+    unsigned framesSinceRefresh = 0;
+
+    sf::RectangleShape panel;
+    sf::VertexArray graph;          // One point per frame in the history
+    sf::VertexArray budgetLines;    // 60 fps and 30 fps markers
+    sf::VertexArray histogram;
+    std::vector<sf::Text> bucketLabels;
+    sf::Text statLabels;
+    sf::Text statValues;
+
+    const float graphWidth = 480.0f;
+    const float graphHeight = 100.0f;
+    const float graphMaxMs = 50.0f;
+    const unsigned refreshFrames = 15;  // Text is rebuilt a few times a second, not every frame
+};
+
+#endif // PROFILEROVERLAY_HPP
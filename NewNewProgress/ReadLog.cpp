@@ -0,0 +1,104 @@
+#include "ReadLog.h"
+#include "Tracer.h"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace {
+    std::size_t countBits(std::uint64_t word) {
+        std::size_t count = 0;
+        for (; word; word &= word - 1)
+            ++count;
+        return count;
+    }
+}
+
+ReadLog::ReadLog() : nodeIds(StoryScript::getNodeIds()), bits(nodeIds.size()) {
+}
+
+// Unknown nodes (since removed from the script) are skipped; lines past the end of
+// a node that got shorter just never come up
+bool ReadLog::load(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file) return false;
+
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream fields(line);
+        std::string id, hex;
+        if (!(fields >> id >> hex)) continue;
+
+        for (std::size_t node = 0; node < nodeIds.size(); ++node) {
+            if (nodeIds[node] != id) continue;
+            std::vector<std::uint64_t>& words = bits[node];
+            words.assign((hex.size() + 15) / 16, 0);
+            for (std::size_t w = 0; w < words.size(); ++w)
+                words[w] = std::strtoull(hex.substr(w * 16, 16).c_str(), nullptr, 16);
+            break;
+        }
+    }
+    dirty = false;
+    return true;
+}
+
+JobHandle ReadLog::saveAsync(const std::string& filename) {
+    if (!dirty)
+        return lastSave;
+    dirty = false;
+
+    // A few hundred bytes for the whole script, so it's encoded here and only written there
+    std::ostringstream out;
+    out << std::hex;
+    for (std::size_t node = 0; node < nodeIds.size(); ++node) {
+        if (bits[node].empty()) continue;
+        out << nodeIds[node] << ' ';
+        for (std::uint64_t word : bits[node]) {
+            out.width(16);
+            out.fill('0');
+            out << word;
+        }
+        out << '\n';
+    }
+
+    std::string contents = out.str();
+    lastSave = JobSystem::getInstance().submit("save " + filename, [filename, contents]() {
+        TRACE_SCOPE_CAT("Read log write", "io");
+        std::ofstream file(filename);
+        if (!file || !(file << contents))
+            std::cerr << "Failed to write read log: " << filename << "\n";
+    }, { lastSave });
+    return lastSave;
+}
+
+void ReadLog::markRead(LineId line) {
+    std::size_t node = StoryScript::getNodeIndex(line);
+    std::size_t index = StoryScript::getLineIndex(line);
+    if (node >= bits.size()) return;
+
+    std::vector<std::uint64_t>& words = bits[node];
+    if (words.size() <= index / 64)
+        words.resize(index / 64 + 1, 0);
+    std::uint64_t mask = std::uint64_t(1) << (index % 64);
+    if (!(words[index / 64] & mask)) {
+        words[index / 64] |= mask;
+        dirty = true;
+    }
+}
+
+bool ReadLog::isRead(LineId line) const {
+    std::size_t node = StoryScript::getNodeIndex(line);
+    std::size_t index = StoryScript::getLineIndex(line);
+    if (node >= bits.size() || index / 64 >= bits[node].size())
+        return false;
+    return (bits[node][index / 64] >> (index % 64)) & 1;
+}
+
+std::size_t ReadLog::getReadCount() const {
+    std::size_t count = 0;
+    for (const std::vector<std::uint64_t>& words : bits) {
+        for (std::uint64_t word : words)
+            count += countBits(word);
+    }
+    return count;
+}
@@ -0,0 +1,44 @@
+#ifndef READLOG_HPP
+#define READLOG_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "JobSystem.h"
+#include "StoryScript.h"
+
+// Every line the player has ever seen, across saves and playthroughs, one bit per
+// line of the script. Kept in its own file, so starting a new game or loading an
+// old save doesn't forget what's been read. Main thread only.
+//
+// The file has a line per node, "<node id> <hex>", so it still lines up when
+// nodes are added to the script or moved around in it.
+class ReadLog {
+public:
+    static ReadLog& getInstance() {
+        static ReadLog instance;
+        return instance;
+    }
+
+    bool load(const std::string& filename);
+    // Writes on a worker, only if something was read since the last save
+    JobHandle saveAsync(const std::string& filename);
+
+    void markRead(LineId line);
+    bool isRead(LineId line) const;
+    std::size_t getReadCount() const;
+
+    // Prevent copying
+    ReadLog(const ReadLog&) = delete;
+    ReadLog& operator=(const ReadLog&) = delete;
+
+private:
+    ReadLog();
+
+    std::vector<std::string> nodeIds;                   // By node index
+    std::vector<std::vector<std::uint64_t>> bits;       // By node index, then line / 64
+    bool dirty = false;
+    JobHandle lastSave;
+};
+
+#endif // READLOG_HPP
@@ -1,25 +1,100 @@
-#include "SaveManager.h"
-#include <iostream>
-#include <fstream>
-
-bool SaveManager::saveProgress(const std::string& filename, const GameProgress& progress) {
-    std::ofstream file(filename);
-    if (!file) return false;
-
-    file << progress.backgroundImage << '\n';
-    file << progress.speaker << '\n';
-    file << progress.dialogue << '\n';
-
-    return true;
-}
-
-bool SaveManager::loadProgress(const std::string& filename, GameProgress& progress) {
-    std::ifstream file(filename);
-    if (!file) return false;
-
-    std::getline(file, progress.backgroundImage);
-    std::getline(file, progress.speaker);
-    std::getline(file, progress.dialogue);
-
-    return true;
-}
\ No newline at end of file
+#include "SaveManager.h"
+#include "Profiler.h"
+#include "Tracer.h"
+#include <iostream>
+#include <cstdlib>
+#include <fstream>
+
+namespace {
+    JobHandle lastSaveJob;  // Only touched from the main thread
+}
+
+// One field per line; line breaks inside dialogue are stored as "\n"
+std::string SaveManager::escapeLine(const std::string& line) {
+    std::string escaped;
+    escaped.reserve(line.size());
+    for (char c : line) {
+        if (c == '\n') escaped += "\\n";
+        else escaped += c;
+    }
+    return escaped;
+}
+
+std::string SaveManager::unescapeLine(const std::string& line) {
+    std::string text;
+    text.reserve(line.size());
+    for (std::size_t i = 0; i < line.size(); ++i) {
+        if (line[i] == '\\' && i + 1 < line.size() && line[i + 1] == 'n') {
+            text += '\n';
+            ++i;
+        }
+        else {
+            text += line[i];
+        }
+    }
+    return text;
+}
+
+std::string SaveManager::encode(const GameProgress& progress) {
+    return escapeLine(progress.backgroundImage) + '\n'
+        + escapeLine(progress.speaker) + '\n'
+        + escapeLine(progress.dialogue) + '\n'
+        + escapeLine(progress.timeline) + '\n'
+        + std::to_string(progress.timelineTime) + '\n'
+        + escapeLine(progress.playerName) + '\n'
+        + escapeLine(progress.nickname) + '\n'
+        + progress.storyVariables + '\n';
+}
+
+bool SaveManager::saveProgress(const std::string& filename, const GameProgress& progress) {
+    TRACE_SCOPE_CAT("Save write", "io");
+    std::ofstream file(filename);
+    if (!file) return false;
+
+    file << encode(progress);
+
+    return true;
+}
+
+bool SaveManager::loadProgress(const std::string& filename, GameProgress& progress) {
+    std::ifstream file(filename);
+    if (!file) return false;
+
+    std::getline(file, progress.backgroundImage);
+    std::getline(file, progress.speaker);
+    std::getline(file, progress.dialogue);
+    progress.backgroundImage = unescapeLine(progress.backgroundImage);
+    progress.speaker = unescapeLine(progress.speaker);
+    progress.dialogue = unescapeLine(progress.dialogue);
+
+    // Saves from before timelines end here, leaving no timeline running
+    std::string timelineTime;
+    std::getline(file, progress.timeline);
+    std::getline(file, timelineTime);
+    progress.timeline = unescapeLine(progress.timeline);
+    progress.timelineTime = std::strtof(timelineTime.c_str(), nullptr);
+
+    // And saves from before names, here
+    std::getline(file, progress.playerName);
+    std::getline(file, progress.nickname);
+    progress.playerName = unescapeLine(progress.playerName);
+    progress.nickname = unescapeLine(progress.nickname);
+
+    // And story variables (all 0 if they're missing)
+    std::getline(file, progress.storyVariables);
+
+    return true;
+}
+
+JobHandle SaveManager::saveProgressAsync(const std::string& filename, const GameProgress& progress) {
+    lastSaveJob = JobSystem::getInstance().submit("save " + filename, [filename, progress]() {
+        if (!saveProgress(filename, progress))
+            std::cerr << "Failed to write save file: " << filename << "\n";
+    }, { lastSaveJob });
+    return lastSaveJob;
+}
+
+void SaveManager::waitForSaves() {
+    PROFILE_SCOPE(IO);
+    JobSystem::getInstance().wait(lastSaveJob);
+}
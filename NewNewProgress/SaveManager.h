@@ -1,12 +1,23 @@
-#ifndef SAVEMANAGER_HPP
-#define SAVEMANAGER_HPP
-
-#include "GameProgress.h"
-
-class SaveManager {
-public:
-    static bool saveProgress(const std::string& filename, const GameProgress& progress);
-    static bool loadProgress(const std::string& filename, GameProgress& progress);
-};
-
-#endif
\ No newline at end of file
+#ifndef SAVEMANAGER_HPP
+#define SAVEMANAGER_HPP
+
+#include "GameProgress.h"
+#include "JobSystem.h"
+
+class SaveManager {
+public:
+    static bool saveProgress(const std::string& filename, const GameProgress& progress);
+    static bool loadProgress(const std::string& filename, GameProgress& progress);
+
+    // Encode and write on a worker. Saves are chained so they land in the order they were made.
+    static JobHandle saveProgressAsync(const std::string& filename, const GameProgress& progress);
+    // Main thread only: blocks until every queued save has been written
+    static void waitForSaves();
+
+private:
+    static std::string encode(const GameProgress& progress);
+    static std::string escapeLine(const std::string& line);
+    static std::string unescapeLine(const std::string& line);
+};
+
+#endif
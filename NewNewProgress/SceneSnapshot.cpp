@@ -0,0 +1,34 @@
+#include "SceneSnapshot.h"
+#include "Profiler.h"
+#include <iostream>
+
+SceneSnapshot::SceneSnapshot(sf::RenderWindow& window) : window(window) {
+}
+
+void SceneSnapshot::draw(sf::RenderTarget& target, const sf::Color& tint) {
+    // The texture is only recreated when the window's size has changed
+    if (!captured) {
+        sf::Vector2u pixels = window.getSize();
+        if (texture.getSize() != pixels && !texture.create(pixels.x, pixels.y)) {
+            std::cerr << "Failed to create the scene snapshot\n";
+            return;
+        }
+        texture.update(window);
+        sprite.setTexture(texture, true);
+        sf::Vector2f size = window.getDefaultView().getSize();
+        sprite.setScale(size.x / pixels.x, size.y / pixels.y);
+        captured = true;
+    }
+
+    sprite.setColor(tint);
+    target.draw(sprite);
+    PROFILE_DRAW(sprite);
+}
+
+bool SceneSnapshot::isCaptured() const {
+    return captured;
+}
+
+void SceneSnapshot::invalidate() {
+    captured = false;
+}
@@ -0,0 +1,26 @@
+#ifndef SCENESNAPSHOT_HPP
+#define SCENESNAPSHOT_HPP
+
+#include <SFML/Graphics.hpp>
+
+// A copy of the scene under a menu. The overlay's screen lets the scene draw once
+// more, then takes it from the window's back buffer before drawing over it; after
+// that only the copy is drawn, so the covered screen costs nothing while the menu
+// is up.
+class SceneSnapshot {
+public:
+    explicit SceneSnapshot(sf::RenderWindow& window);
+
+    // Takes the snapshot if there isn't one yet, then draws it, tinted
+    void draw(sf::RenderTarget& target, const sf::Color& tint);
+    bool isCaptured() const;
+    void invalidate();      // Take a new one next frame, e.g. once the window has been resized
+
+private:
+    sf::RenderWindow& window;
+    sf::Texture texture;
+    sf::Sprite sprite;
+    bool captured = false;
+};
+
+#endif // SCENESNAPSHOT_HPP
@@ -0,0 +1,28 @@
+#ifndef SCREEN_HPP
+#define SCREEN_HPP
+
+#include <SFML/Graphics.hpp>
+
+// Base for every screen driven by the game loop. Screens are built once and
+// stay alive; the loop only pushes and pops them on the ScreenStack.
+class Screen {
+public:
+    virtual ~Screen() = default;
+
+    // Called when the screen is pushed / popped (not when covered by an overlay)
+    virtual void onEnter() {}
+    virtual void onExit() {}
+    // The overlay that was covering the screen has been popped
+    virtual void onReveal() {}
+    // The window has settled at a new size (the view keeps its size; only the pixels change)
+    virtual void onResize() {}
+
+    virtual void handleEvent(const sf::Event& event) = 0;
+    virtual void update(float deltaTime) = 0;    // Fixed timestep
+    virtual void draw(sf::RenderTarget& target) = 0;
+
+    // Overlays let the screen below them keep drawing (frozen, not updated)
+    virtual bool isOverlay() const { return false; }
+};
+
+#endif // SCREEN_HPP
@@ -0,0 +1,94 @@
+#include "ScreenStack.h"
+#include <iostream>
+
+void ScreenStack::add(GameState id, Screen& screen) {
+    registry[id] = &screen;
+}
+
+void ScreenStack::push(GameState id) {
+    pending.push_back({ Action::PUSH, id });
+}
+
+void ScreenStack::pop() {
+    pending.push_back({ Action::POP, GameState::QUIT });
+}
+
+void ScreenStack::switchTo(GameState id) {
+    pending.push_back({ Action::CLEAR, GameState::QUIT });
+    pending.push_back({ Action::PUSH, id });
+}
+
+void ScreenStack::applyPendingChanges() {
+    // onEnter/onExit may queue more changes, so walk by index
+    for (std::size_t i = 0; i < pending.size(); ++i) {
+        PendingChange change = pending[i];
+        switch (change.action) {
+        case Action::PUSH: {
+            auto it = registry.find(change.id);
+            if (it == registry.end()) {
+                std::cerr << "No screen registered for state " << static_cast<int>(change.id) << "\n";
+                break;
+            }
+            stack.push_back(change.id);
+            it->second->onEnter();
+            break;
+        }
+        case Action::POP:
+            if (!stack.empty()) {
+                GameState top = stack.back();
+                stack.pop_back();
+                registry[top]->onExit();
+                if (!stack.empty())
+                    registry[stack.back()]->onReveal();
+            }
+            break;
+        case Action::CLEAR:
+            while (!stack.empty()) {
+                GameState top = stack.back();
+                stack.pop_back();
+                registry[top]->onExit();
+            }
+            break;
+        }
+    }
+    pending.clear();
+}
+
+void ScreenStack::handleEvent(const sf::Event& event) {
+    if (!stack.empty())
+        registry[stack.back()]->handleEvent(event);
+}
+
+void ScreenStack::update(float deltaTime) {
+    if (!stack.empty())
+        registry[stack.back()]->update(deltaTime);
+}
+
+void ScreenStack::draw(sf::RenderTarget& target) {
+    if (stack.empty()) return;
+
+    // Find the lowest screen still visible through the overlays on top of it
+    std::size_t first = stack.size() - 1;
+    while (first > 0 && registry[stack[first]]->isOverlay())
+        --first;
+
+    for (std::size_t i = first; i < stack.size(); ++i)
+        registry[stack[i]]->draw(target);
+}
+
+void ScreenStack::resize() {
+    for (GameState id : stack)
+        registry[id]->onResize();
+}
+
+bool ScreenStack::isEmpty() const {
+    return stack.empty() && pending.empty();
+}
+
+bool ScreenStack::isOnTop(GameState id) const {
+    return !stack.empty() && stack.back() == id;
+}
+
+std::size_t ScreenStack::getDepth() const {
+    return stack.size();
+}
@@ -0,0 +1,43 @@
+#ifndef SCREENSTACK_HPP
+#define SCREENSTACK_HPP
+
+#include <SFML/Graphics.hpp>
+#include <map>
+#include <vector>
+#include "Screen.h"
+#include "GameState.h"
+
+class ScreenStack {
+public:
+    // Register a screen once; the stack never owns or rebuilds it
+    void add(GameState id, Screen& screen);
+
+    // Changes are queued and applied between frames so a screen can
+    // safely push/pop itself from inside its own handleEvent/update.
+    void push(GameState id);
+    void pop();
+    void switchTo(GameState id);    // Clear the stack, then push
+    void applyPendingChanges();
+
+    void handleEvent(const sf::Event& event);   // Top screen only
+    void update(float deltaTime);               // Top screen only
+    void draw(sf::RenderTarget& target);        // Top screen plus what its overlays reveal
+    void resize();                              // Every screen on the stack, covered ones too
+
+    bool isEmpty() const;
+    bool isOnTop(GameState id) const;
+    std::size_t getDepth() const;               // Screens on the stack, covered ones too
+
+private:
+    enum class Action { PUSH, POP, CLEAR };
+    struct PendingChange {
+        Action action;
+        GameState id;
+    };
+
+    std::map<GameState, Screen*> registry;
+    std::vector<GameState> stack;
+    std::vector<PendingChange> pending;
+};
+
+#endif // SCREENSTACK_HPP
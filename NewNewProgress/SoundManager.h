@@ -1,91 +1,176 @@
-﻿#ifndef SOUNDMANAGER_H
-#define SOUNDMANAGER_H
-
-#include <SFML/Audio.hpp>
-#include <unordered_map>
-#include <string>
-#include <memory>
-
-class SoundManager {
-private:
-    std::unordered_map<std::string, std::unique_ptr<sf::SoundBuffer>> soundBuffers;
-    std::unordered_map<std::string, sf::Sound> sounds;
-    std::unique_ptr<sf::Music> currentMusic;
-    std::string currentMusicFile = "";  // 🔹 Track the currently playing music
-    float musicVolume = 100.0f;
-    float soundVolume = 100.0f;
-
-    SoundManager() = default;
-
-public:
-    static SoundManager& getInstance() {
-        static SoundManager instance;
-        return instance;
-    }
-
-    // Load sound effect
-    bool loadSound(const std::string& name, const std::string& filename) {
-        auto buffer = std::make_unique<sf::SoundBuffer>();
-        if (!buffer->loadFromFile(filename)) return false;
-        sounds[name] = sf::Sound();
-        sounds[name].setBuffer(*buffer);
-        soundBuffers[name] = std::move(buffer);
-        return true;
-    }
-
-    void playSound(const std::string& name) {
-        if (sounds.find(name) != sounds.end()) {
-            sounds[name].setVolume(soundVolume);
-            sounds[name].play();
-        }
-    }
-
-    void setSoundVolume(float volume) {
-        soundVolume = volume;
-    }
-
-    // 🔧 Improved music playback
-    bool playMusic(const std::string& filename, bool loop = true) {
-        // 🔹 Avoid restarting if already playing same file
-        if (currentMusic && currentMusic->getStatus() == sf::Music::Playing && currentMusicFile == filename) {
-            return true;
-        }
-
-        // Stop and load new music
-        stopMusic();
-        currentMusic = std::make_unique<sf::Music>();
-        if (!currentMusic->openFromFile(filename)) return false;
-
-        currentMusicFile = filename;
-        currentMusic->setLoop(loop);
-        currentMusic->setVolume(musicVolume);
-        currentMusic->play();
-        return true;
-    }
-
-    void stopMusic() {
-        if (currentMusic) {
-            currentMusic->stop();
-            currentMusicFile.clear();  // 🔹 Reset tracking
-        }
-    }
-
-    void pauseMusic() {
-        if (currentMusic) currentMusic->pause();
-    }
-
-    void resumeMusic() {
-        if (currentMusic) currentMusic->play();
-    }
-
-    void setMusicVolume(float volume) {
-        musicVolume = volume;
-        if (currentMusic) currentMusic->setVolume(musicVolume);
-    }
-
-    // Prevent copying
-    SoundManager(const SoundManager&) = delete;
-    SoundManager& operator=(const SoundManager&) = delete;
-};
-
+﻿#ifndef SOUNDMANAGER_H
+#define SOUNDMANAGER_H
+
+#include <SFML/Audio.hpp>
+#include <unordered_map>
+#include <string>
+#include <memory>
+#include <iostream>
+#include <thread>
+#include "JobSystem.h"
+#include "Profiler.h"
+#include "Tracer.h"
+
+#if BIRINGAN_PROFILE
+// Music whose streaming callback (run on SFML's audio thread) shows up in traces
+class TracedMusic : public sf::Music {
+protected:
+    bool onGetData(Chunk& data) override {
+        // play() after stop() starts a new streaming thread
+        if (namedThread != std::this_thread::get_id()) {
+            namedThread = std::this_thread::get_id();
+            TRACE_THREAD_NAME("Audio stream");
+        }
+        TRACE_SCOPE_CAT("Music::onGetData", "audio");
+        return sf::Music::onGetData(data);
+    }
+
+private:
+    std::thread::id namedThread;
+};
+using StreamedMusic = TracedMusic;
+#else
+using StreamedMusic = sf::Music;
+#endif
+
+class SoundManager {
+private:
+    std::unordered_map<std::string, std::unique_ptr<sf::SoundBuffer>> soundBuffers;
+    std::unordered_map<std::string, sf::Sound> sounds;
+    std::unique_ptr<sf::Music> currentMusic;
+    std::string currentMusicFile = "";  // 🔹 Track the currently playing music
+    float musicVolume = 100.0f;
+    float soundVolume = 100.0f;
+
+    SoundManager() = default;
+
+public:
+    static SoundManager& getInstance() {
+        static SoundManager instance;
+        return instance;
+    }
+
+    // Load sound effect
+    bool loadSound(const std::string& name, const std::string& filename) {
+        PROFILE_SCOPE(Audio);
+        auto buffer = std::make_unique<sf::SoundBuffer>();
+        if (!buffer->loadFromFile(filename)) return false;
+        sounds[name] = sf::Sound();
+        sounds[name].setBuffer(*buffer);
+        soundBuffers[name] = std::move(buffer);
+        return true;
+    }
+
+    // Decode on a worker; the sound is only registered once the buffer is ready
+    JobHandle loadSoundAsync(const std::string& name, const std::string& filename) {
+        auto buffer = std::make_shared<std::unique_ptr<sf::SoundBuffer>>();
+        JobHandle decode = JobSystem::getInstance().submit("decode " + filename, [buffer, filename]() {
+            auto loaded = std::make_unique<sf::SoundBuffer>();
+            if (loaded->loadFromFile(filename))
+                *buffer = std::move(loaded);
+        });
+        return JobSystem::getInstance().submitMain("register " + name, [this, buffer, name, filename]() {
+            if (!*buffer) {
+                std::cerr << "Failed to load sound: " << filename << "\n";
+                return;
+            }
+            sounds[name] = sf::Sound();
+            sounds[name].setBuffer(**buffer);
+            soundBuffers[name] = std::move(*buffer);
+        }, { decode });
+    }
+
+    bool hasSound(const std::string& name) const {
+        return sounds.find(name) != sounds.end();
+    }
+
+    // Stops and forgets every sound effect, so a tool can start again from cold
+    void unloadSounds() {
+        sounds.clear();
+        soundBuffers.clear();
+    }
+
+    void playSound(const std::string& name) {
+        PROFILE_SCOPE(Audio);
+        if (sounds.find(name) != sounds.end()) {
+            sounds[name].setVolume(soundVolume);
+            sounds[name].play();
+        }
+    }
+
+    // Starts offset seconds in; false if the sound isn't loaded or is already over by then
+    bool playSoundFrom(const std::string& name, float offset) {
+        PROFILE_SCOPE(Audio);
+        auto it = sounds.find(name);
+        if (it == sounds.end() || offset >= it->second.getBuffer()->getDuration().asSeconds())
+            return false;
+        it->second.setVolume(soundVolume);
+        it->second.play();
+        it->second.setPlayingOffset(sf::seconds(offset));
+        return true;
+    }
+
+    void stopSound(const std::string& name) {
+        auto it = sounds.find(name);
+        if (it != sounds.end())
+            it->second.stop();
+    }
+
+    void setSoundVolume(float volume) {
+        soundVolume = volume;
+    }
+
+    float getSoundVolume() const {
+        return soundVolume;
+    }
+
+    // 🔧 Improved music playback
+    bool playMusic(const std::string& filename, bool loop = true) {
+        // 🔹 Avoid restarting if already playing same file
+        if (currentMusic && currentMusic->getStatus() == sf::Music::Playing && currentMusicFile == filename) {
+            return true;
+        }
+
+        // Stop and load new music
+        PROFILE_SCOPE(Audio);
+        stopMusic();
+        currentMusic = std::make_unique<StreamedMusic>();
+        if (!currentMusic->openFromFile(filename)) return false;
+
+        currentMusicFile = filename;
+        currentMusic->setLoop(loop);
+        currentMusic->setVolume(musicVolume);
+        currentMusic->play();
+        return true;
+    }
+
+    void stopMusic() {
+        if (currentMusic) {
+            currentMusic->stop();
+            currentMusicFile.clear();  // 🔹 Reset tracking
+        }
+    }
+
+    void pauseMusic() {
+        if (currentMusic) currentMusic->pause();
+    }
+
+    void resumeMusic() {
+        if (currentMusic) currentMusic->play();
+    }
+
+    void setMusicVolume(float volume) {
+        musicVolume = volume;
+        if (currentMusic) currentMusic->setVolume(musicVolume);
+    }
+
+    float getMusicVolume() const {
+        return musicVolume;
+    }
+
+    // Prevent copying
+    SoundManager(const SoundManager&) = delete;
+    SoundManager& operator=(const SoundManager&) = delete;
+};
+
 #endif
\ No newline at end of file
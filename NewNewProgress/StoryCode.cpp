@@ -0,0 +1,260 @@
+#include "StoryCode.h"
+#include "StoryVariables.h"
+#include "ChapterArena.h"
+#include <cctype>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+namespace {
+    // An opcode byte, then for PUSH, LOAD and STORE one operand byte
+    enum Op : std::uint8_t {
+        END,
+        PUSH,       // constant
+        LOAD,       // variable
+        STORE,      // variable; pops the value
+        NOT,
+        AND, OR,
+        EQ, NE, LT, LE, GT, GE,
+        ADD, SUB
+    };
+
+    const std::size_t stackSize = 16;
+
+    // Recursive descent straight to bytecode, lowest precedence first:
+    // || then && then comparisons then + and - then ! and brackets
+    class Compiler {
+    public:
+        explicit Compiler(const std::string& source) : source(source) {}
+
+        bool condition() {
+            expression();
+            finish();
+            return error.empty();
+        }
+
+        // Statements split by ';'
+        bool effect() {
+            do {
+                int variable = name();
+                if (!error.empty()) break;
+                if (accept("+=") || accept("-=")) {
+                    Op op = source[position - 2] == '+' ? ADD : SUB;
+                    emit(LOAD, variable);
+                    expression();
+                    emit(op);
+                }
+                else if (accept("=")) {
+                    expression();
+                }
+                else {
+                    fail("expected =, += or -=");
+                }
+                emit(STORE, variable);
+            } while (error.empty() && accept(";") && !atEnd());
+            finish();
+            return error.empty();
+        }
+
+        const std::vector<std::uint8_t>& getCode() const { return code; }
+        const std::string& getError() const { return error; }
+
+    private:
+        void expression() {
+            conjunction();
+            while (error.empty() && accept("||")) {
+                conjunction();
+                emit(OR);
+            }
+        }
+
+        void conjunction() {
+            comparison();
+            while (error.empty() && accept("&&")) {
+                comparison();
+                emit(AND);
+            }
+        }
+
+        // Two-character operators are tried first, so "<=" isn't read as "<"
+        void comparison() {
+            sum();
+            if (!error.empty()) return;
+            static const struct { const char* text; Op op; } operators[] = {
+                {"==", EQ}, {"!=", NE}, {"<=", LE}, {">=", GE}, {"<", LT}, {">", GT}
+            };
+            for (const auto& candidate : operators) {
+                if (accept(candidate.text)) {
+                    sum();
+                    emit(candidate.op);
+                    return;
+                }
+            }
+        }
+
+        void sum() {
+            unary();
+            while (error.empty()) {
+                if (accept("+")) { unary(); emit(ADD); }
+                else if (accept("-")) { unary(); emit(SUB); }
+                else return;
+            }
+        }
+
+        void unary() {
+            skipSpace();
+            if (accept("!")) {
+                unary();
+                emit(NOT);
+            }
+            else if (accept("(")) {
+                expression();
+                if (error.empty() && !accept(")")) fail("expected )");
+            }
+            else if (position < source.size() && std::isdigit(static_cast<unsigned char>(source[position]))) {
+                int value = 0;
+                while (position < source.size() && std::isdigit(static_cast<unsigned char>(source[position])) && value <= 255)
+                    value = value * 10 + (source[position++] - '0');
+                if (value > 255) fail("numbers only go up to 255");
+                else emit(PUSH, value);
+            }
+            else {
+                int variable = name();
+                if (error.empty()) emit(LOAD, variable);
+            }
+        }
+
+        int name() {
+            skipSpace();
+            std::size_t start = position;
+            while (position < source.size() && (std::isalnum(static_cast<unsigned char>(source[position])) || source[position] == '_'))
+                ++position;
+            if (position == start) {
+                fail("expected a name or a number");
+                return 0;
+            }
+            int variable = StoryVariables::find(source.c_str() + start, position - start);
+            if (variable < 0) {
+                fail("no story variable named " + source.substr(start, position - start));
+                return 0;
+            }
+            return variable;
+        }
+
+        void finish() {
+            if (error.empty() && !atEnd()) fail("unexpected " + source.substr(position));
+            emit(END);
+        }
+
+        bool lookingAt(const char* text) {
+            skipSpace();
+            return source.compare(position, std::strlen(text), text) == 0;
+        }
+
+        bool accept(const char* text) {
+            if (!lookingAt(text)) return false;
+            position += std::strlen(text);
+            return true;
+        }
+
+        bool atEnd() {
+            skipSpace();
+            return position >= source.size();
+        }
+
+        void skipSpace() {
+            while (position < source.size() && std::isspace(static_cast<unsigned char>(source[position])))
+                ++position;
+        }
+
+        // Keeps count of how deep the stack gets, so running never has to check
+        void emit(Op op, int operand = -1) {
+            code.push_back(op);
+            if (operand >= 0) code.push_back(static_cast<std::uint8_t>(operand));
+
+            if (op == PUSH || op == LOAD) ++depth;
+            else if (op == STORE || (op >= AND && op <= SUB)) --depth;
+            if (depth > static_cast<int>(stackSize)) fail("too deeply nested");
+        }
+
+        void fail(const std::string& message) {
+            if (error.empty()) error = message;
+        }
+
+        const std::string& source;
+        std::size_t position = 0;
+        std::vector<std::uint8_t> code;
+        int depth = 0;
+        std::string error;
+    };
+
+    const std::uint8_t* store(const Compiler& compiler, const char* kind, const std::string& source, ChapterArena& arena) {
+        if (!compiler.getError().empty()) {
+            std::cerr << "Bad story " << kind << " \"" << source << "\": " << compiler.getError() << "\n";
+            return nullptr;
+        }
+        const std::vector<std::uint8_t>& code = compiler.getCode();
+        std::uint8_t* stored = arena.allocateArray<std::uint8_t>(code.size());
+        std::memcpy(stored, code.data(), code.size());
+        return stored;
+    }
+}
+
+const std::uint8_t* StoryCode::compileCondition(const std::string& source, ChapterArena& arena) {
+    if (source.empty()) return nullptr;
+    Compiler compiler(source);
+    compiler.condition();
+    return store(compiler, "condition", source, arena);
+}
+
+const std::uint8_t* StoryCode::compileEffect(const std::string& source, ChapterArena& arena) {
+    if (source.empty()) return nullptr;
+    Compiler compiler(source);
+    compiler.effect();
+    return store(compiler, "effect", source, arena);
+}
+
+bool StoryCode::test(const std::uint8_t* condition) {
+    return !condition || execute(condition) != 0;
+}
+
+void StoryCode::run(const std::uint8_t* effect) {
+    if (effect) execute(effect);
+}
+
+// The compiler has already made sure the stack can't overflow or underflow
+int StoryCode::execute(const std::uint8_t* code) {
+    StoryVariables& variables = StoryVariables::getInstance();
+    int stack[stackSize];
+    std::size_t top = 0;
+
+    for (;;) {
+        std::uint8_t op = *code++;
+        if (op == END)
+            return top > 0 ? stack[top - 1] : 0;
+
+        switch (op) {
+        case PUSH: stack[top++] = *code++; break;
+        case LOAD: stack[top++] = variables.get(static_cast<std::size_t>(*code++)); break;
+        case STORE: variables.set(static_cast<std::size_t>(*code++), stack[--top]); break;
+        case NOT: stack[top - 1] = !stack[top - 1]; break;
+        default: {
+            int right = stack[--top];
+            int& left = stack[top - 1];
+            switch (op) {
+            case AND: left = left && right; break;
+            case OR: left = left || right; break;
+            case EQ: left = left == right; break;
+            case NE: left = left != right; break;
+            case LT: left = left < right; break;
+            case LE: left = left <= right; break;
+            case GT: left = left > right; break;
+            case GE: left = left >= right; break;
+            case ADD: left = left + right; break;
+            case SUB: left = left - right; break;
+            }
+            break;
+        }
+        }
+    }
+}
@@ -0,0 +1,32 @@
+#ifndef STORYCODE_HPP
+#define STORYCODE_HPP
+
+#include <cstdint>
+#include <string>
+
+class ChapterArena;
+
+// The script's conditions and effects. Each is compiled once, when its node starts,
+// to a few bytes of bytecode in the chapter arena; checking a choice or a line is
+// then a short run of a tiny stack machine over StoryVariables, with no parsing,
+// lookups or allocation.
+//
+//   conditions:  "gahum"   "!stared && questions >= 2"   "(shook_hand || stared) && gahum == 0"
+//   effects:     "gahum = 1"   "questions += 1; stared = 0"
+//
+// Names are StoryVariables'; numbers run from 0 to 255.
+class StoryCode {
+public:
+    // Null for an empty source. One that doesn't compile is reported and also comes
+    // back null, so whatever it was on acts as if it had none.
+    static const std::uint8_t* compileCondition(const std::string& source, ChapterArena& arena);
+    static const std::uint8_t* compileEffect(const std::string& source, ChapterArena& arena);
+
+    static bool test(const std::uint8_t* condition);    // Null always holds
+    static void run(const std::uint8_t* effect);        // Null does nothing
+
+private:
+    static int execute(const std::uint8_t* code);
+};
+
+#endif // STORYCODE_HPP
@@ -0,0 +1,366 @@
+#include "StoryPlayer.h"
+#include "ReadLog.h"
+#include "StoryCode.h"
+#include "Tracer.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace {
+    double secondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+StoryPlayer::StoryPlayer(BackgroundManager& background, DialogueBox& dialogue, ChoiceBox& choices,
+    PortraitStage& stage, Camera& camera, TimelinePlayer& timelines, ParticleSystem& particles,
+    SoundManager& sounds)
+    : background(background), dialogue(dialogue), choices(choices), stage(stage), camera(camera),
+    timelines(timelines), particles(particles), sounds(sounds) {
+}
+
+void StoryPlayer::startChapter(const ScriptNode& next, std::size_t first) {
+    // Nothing reads the old chapter's lines past this point: start() hands the
+    // dialogue box new ones straight away
+    choices.hide();
+    arena.reset();
+    timelines.skip();
+    camera.reset();     // A move left running at the end of a chapter doesn't carry over
+    particles.clear();
+    stage.clear();
+    start(next, first);
+}
+
+void StoryPlayer::start(const ScriptNode& next, std::size_t first) {
+    node = next;
+    firstLine = first < node.lines.size() ? first : 0;
+    linesSeen = 0;
+    choicesOffered = false;
+    firstLineApplied = false;
+    skippedBackground = nullptr;
+    skippedCamera = nullptr;
+
+    choices.hide();
+    if (!node.background.empty())
+        background.setBackground(node.background);
+
+    // Chapters have theirs loaded behind the chapter cards; a branch's come in while
+    // its first lines are read
+    for (const auto& sound : node.sounds) {
+        if (!sounds.hasSound(sound.first))
+            sounds.loadSoundAsync(sound.first, sound.second);
+    }
+    for (const auto& character : node.characters)
+        stage.cast(character.first, character.second);
+
+    // Rasterize the node's glyphs now rather than on whichever frame first types them
+    for (const DialogueEntry& line : node.lines)
+        dialogue.prewarmGlyphs(line);
+
+    // What the box plays and the cue lookup live in the chapter arena
+    std::size_t count = node.lines.size();
+    DialogueLine* lines = arena.allocateArray<DialogueLine>(count);
+    lineCues = arena.allocateArray<LineCues>(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        lines[i].text = arena.copyString(node.lines[i].text);
+        lines[i].speaker = arena.copyString(node.lines[i].speaker);
+        lines[i].spanCount = TextVariables::tokenize(lines[i].text, arena, lines[i].spans);
+
+        std::size_t matches = 0;
+        for (const ScriptCue& cue : node.cues) {
+            if (cue.line == node.lines[i].text) ++matches;
+        }
+        lineCues[i].cues = arena.allocateArray<CompiledCue>(matches);
+        lineCues[i].count = 0;
+        lineCues[i].condition = StoryCode::compileCondition(node.lines[i].condition, arena);
+        for (const ScriptCue& cue : node.cues) {
+            if (cue.line != node.lines[i].text) continue;
+            CompiledCue& compiled = lineCues[i].cues[lineCues[i].count++];
+            compiled.cue = &cue;
+            compiled.condition = StoryCode::compileCondition(cue.condition, arena);
+            compiled.effect = cue.type == CueType::SET ? StoryCode::compileEffect(cue.argument, arena) : nullptr;
+        }
+    }
+
+    choiceCode = arena.allocateArray<CompiledChoice>(node.choices.size());
+    for (std::size_t i = 0; i < node.choices.size(); ++i) {
+        choiceCode[i].condition = StoryCode::compileCondition(node.choices[i].condition, arena);
+        choiceCode[i].effect = StoryCode::compileEffect(node.choices[i].effect, arena);
+    }
+    dialogue.startDialogue(lines + firstLine, count - firstLine);
+}
+
+void StoryPlayer::update() {
+    if (!dialogue.isVisible()) {
+        setSkipping(false);
+        return;
+    }
+
+    syncLines();
+    if (skipping)
+        skipRead();
+}
+
+// Several lines can go by in one update when the player clicks quickly
+void StoryPlayer::syncLines() {
+    while (linesSeen < dialogue.getLinesStarted()) {
+        ++linesSeen;
+        lineStarted(firstLine + linesSeen - 1);
+    }
+}
+
+// Only the line skipping lands on is laid out; the ones before it just fire their cues.
+// Lines left out (as things stand) don't stop it.
+void StoryPlayer::skipRead() {
+    ReadLog& readLog = ReadLog::getInstance();
+    std::size_t current = getLineIndex();
+    std::size_t left = dialogue.getLinesLeft();
+    std::size_t ahead = 0;
+    while (ahead < skipLinesPerUpdate && ahead < left && !choices.isVisible() &&
+        node.index != ScriptNode::notInScript &&
+        (readLog.isRead(StoryScript::makeLineId(node.index, current + 1 + ahead)) || !isLineShown(current + 1 + ahead)))
+        ++ahead;
+
+    if (ahead > 0) {
+        dialogue.skipLines(ahead);
+        syncLines();
+
+        if (skippedBackground) {
+            background.setBackground(skippedBackground->argument);
+            skippedBackground = nullptr;
+        }
+        if (skippedCamera) {
+            timelines.releaseCamera();
+            camera.play(skippedCamera->camera);
+            skippedCamera = nullptr;
+        }
+    }
+
+    // Next line unread, or nothing left to skip to
+    if (ahead < skipLinesPerUpdate || choices.isVisible())
+        setSkipping(false);
+}
+
+void StoryPlayer::setSkipping(bool skip) {
+    if (skipping == skip) return;
+    skipping = skip;
+    dialogue.setSkipping(skip);
+}
+
+bool StoryPlayer::isSkipping() const {
+    return skipping;
+}
+
+bool StoryPlayer::resumeTimeline(const std::string& id, float time) {
+    for (const ScriptCue& cue : node.cues) {
+        if (cue.type == CueType::TIMELINE && cue.argument == id) {
+            timelines.play(cue.argument, cue.timeline, time);
+            return true;
+        }
+    }
+    return false;
+}
+
+void StoryPlayer::setFirstLineApplied() {
+    firstLineApplied = true;
+}
+
+const ScriptNode& StoryPlayer::getNode() const {
+    return node;
+}
+
+std::size_t StoryPlayer::getLineIndex() const {
+    return linesSeen > 0 ? firstLine + linesSeen - 1 : firstLine;
+}
+
+const std::vector<std::size_t>& StoryPlayer::getOfferedChoices() const {
+    return offered;
+}
+
+const ChapterArena& StoryPlayer::getArena() const {
+    return arena;
+}
+
+Backlog& StoryPlayer::getBacklog() {
+    return backlog;
+}
+
+bool StoryPlayer::isLineShown(std::size_t index) const {
+    return index + 1 >= node.lines.size() || StoryCode::test(lineCues[index].condition);
+}
+
+void StoryPlayer::lineStarted(std::size_t index) {
+    if (index >= node.lines.size()) return;
+
+    // Left out: move the box on if it's the line on screen (not one skipped past),
+    // before anything gets drawn. syncLines picks up the next one.
+    if (!isLineShown(index)) {
+        if (index == firstLine + dialogue.getLinesStarted() - 1)
+            dialogue.passLine();
+        return;
+    }
+
+    if (node.index != ScriptNode::notInScript) {
+        LineId id = StoryScript::makeLineId(node.index, index);
+        backlog.record(id, Backlog::countRows(node.lines[index]), TextVariables::getInstance().getSnapshot());
+        ReadLog::getInstance().markRead(id);
+    }
+    bool effectsApplied = firstLineApplied && index == firstLine;
+    firstLineApplied = false;
+    for (std::size_t i = 0; i < lineCues[index].count; ++i) {
+        const CompiledCue& compiled = lineCues[index].cues[i];
+        if (!StoryCode::test(compiled.condition))
+            continue;
+        if (compiled.cue->type == CueType::SET && effectsApplied)
+            continue;
+        // start() replaces the node and its cues, so nothing more of this line runs
+        if (compiled.cue->type == CueType::JUMP) {
+            jump(compiled.cue->argument, "jump");
+            return;
+        }
+        runCue(*compiled.cue, compiled.effect);
+    }
+
+    if (index + 1 == node.lines.size() && !node.choices.empty() && !choicesOffered) {
+        choicesOffered = true;
+        options.clear();
+        offered.clear();
+        for (std::size_t i = 0; i < node.choices.size(); ++i) {
+            if (!StoryCode::test(choiceCode[i].condition))
+                continue;
+            offered.push_back(i);
+            // Small enough for std::function to keep inline
+            options.push_back({ node.choices[i].text, [this, i]() { choose(i); } });
+        }
+        choices.startChoices(options);
+    }
+}
+
+void StoryPlayer::runCue(const ScriptCue& cue, const std::uint8_t* effect) {
+    if (skipping) {
+        switch (cue.type) {
+        case CueType::BACKGROUND:
+        case CueType::TRANSITION:
+            skippedBackground = &cue;
+            return;
+        case CueType::CAMERA:
+            skippedCamera = &cue;
+            return;
+        case CueType::SOUND:
+        case CueType::TIMELINE:
+        case CueType::INSPECT:
+            return;
+        case CueType::PORTRAIT: {
+            StageDirection direction = cue.stage;
+            direction.motion = StageMotion::CUT;
+            if (cue.argument.empty() && direction.exit)
+                stage.exitAll(StageMotion::CUT);
+            else
+                stage.direct(cue.argument, direction);
+            return;
+        }
+        case CueType::CHAPTER:
+            setSkipping(false);     // The next chapter's lines come in behind its cards
+            break;
+        case CueType::PARTICLES:
+        case CueType::SET:
+        case CueType::JUMP:
+            break;
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    switch (cue.type) {
+    case CueType::BACKGROUND: {
+        TRACE_SCOPE("Cue: background");
+        background.setBackground(cue.argument);
+        report("background", cue.argument, secondsSince(start));
+        break;
+    }
+    case CueType::TRANSITION: {
+        TRACE_SCOPE("Cue: transition");
+        background.transitionTo(cue.argument, cue.transition);
+        report("background", cue.argument, secondsSince(start));
+        break;
+    }
+    case CueType::SOUND: {
+        TRACE_SCOPE("Cue: sound");
+        sounds.playSound(cue.argument);
+        report("sound", cue.argument, secondsSince(start));
+        break;
+    }
+    case CueType::PORTRAIT: {
+        TRACE_SCOPE("Cue: portrait");
+        if (cue.argument.empty() && cue.stage.exit)
+            stage.exitAll(cue.stage.motion);
+        else
+            stage.direct(cue.argument, cue.stage);
+        report("portrait", cue.argument, secondsSince(start));
+        break;
+    }
+    case CueType::CAMERA:
+        timelines.releaseCamera();
+        camera.play(cue.camera);
+        break;
+    case CueType::TIMELINE: {
+        // Already running when the story was resumed on this line
+        if (timelines.isPlaying() && timelines.getId() == cue.argument)
+            break;
+        TRACE_SCOPE("Cue: timeline");
+        timelines.play(cue.argument, cue.timeline);
+        report("timeline", cue.argument, secondsSince(start));
+        break;
+    }
+    case CueType::PARTICLES: {
+        if (cue.argument.empty()) {
+            particles.stopAll();
+            break;
+        }
+        TRACE_SCOPE("Cue: particles");
+        auto effect = std::find_if(node.effects.begin(), node.effects.end(),
+            [&cue](const std::pair<std::string, ParticleEffect>& named) { return named.first == cue.argument; });
+        if (effect == node.effects.end()) {
+            std::cerr << "No particle effect named " << cue.argument << " in " << node.id << "\n";
+            break;
+        }
+        particles.start(effect->first, effect->second);
+        report("particles", cue.argument, secondsSince(start));
+        break;
+    }
+    case CueType::CHAPTER:
+        if (onChapter) onChapter(cue);
+        break;
+    case CueType::INSPECT:
+        if (onInspect) onInspect(cue);
+        break;
+    case CueType::SET:
+        StoryCode::run(effect);
+        break;
+    case CueType::JUMP:
+        break;      // Taken in lineStarted
+    }
+}
+
+void StoryPlayer::choose(std::size_t option) {
+    StoryCode::run(choiceCode[option].effect);
+    jump(node.choices[option].nextNode, "choice");
+}
+
+void StoryPlayer::jump(const std::string& target, const char* kind) {
+    std::string nextNode = target;  // start() replaces node
+    TRACE_SCOPE("StoryPlayer::jump");
+    auto start = std::chrono::steady_clock::now();
+
+    ScriptNode next;
+    if (!StoryScript::loadNode(nextNode, next)) {
+        std::cerr << "Unknown script node: " << nextNode << "\n";
+        return;
+    }
+    this->start(next);
+    report(kind, nextNode, secondsSince(start));
+}
+
+void StoryPlayer::report(const char* kind, const std::string& target, double seconds) {
+    if (onTriggerTimed)
+        onTriggerTimed({ kind, target, seconds });
+}
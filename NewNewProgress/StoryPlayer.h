@@ -0,0 +1,135 @@
+#ifndef STORYPLAYER_HPP
+#define STORYPLAYER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "StoryScript.h"
+#include "BackgroundManager.h"
+#include "DialogueBox.h"
+#include "ChoiceBox.h"
+#include "PortraitStage.h"
+#include "Camera.h"
+#include "TimelinePlayer.h"
+#include "ParticleSystem.h"
+#include "SoundManager.h"
+#include "ChapterArena.h"
+#include "Backlog.h"
+
+// How long a cue or a choice took to carry out
+struct TriggerTiming {
+    std::string kind;       // "background", "sound", "chapter", "choice", "jump"
+    std::string target;     // Image, sound or node
+    double seconds;
+};
+
+// Plays script nodes on the gameplay systems: feeds the lines to the dialogue box,
+// fires each line's cues as it comes up and offers the node's choices on its last
+// line. The game and the headless benchmark both drive the story through this.
+//
+// Conditions and effects (on lines, cues and choices) are compiled into the chapter
+// arena when a node starts and checked against StoryVariables as each comes up. A
+// line whose condition doesn't hold is passed over without counting as read; a
+// node's last line always shows, since its choices come up on it.
+class StoryPlayer {
+public:
+    StoryPlayer(BackgroundManager& background, DialogueBox& dialogue, ChoiceBox& choices,
+        PortraitStage& stage, Camera& camera, TimelinePlayer& timelines, ParticleSystem& particles,
+        SoundManager& sounds);
+
+    // A new chapter: releases everything the previous one kept in the arena
+    void startChapter(const ScriptNode& node, std::size_t firstLine = 0);
+    // Another node of the same chapter (a branch)
+    void start(const ScriptNode& node, std::size_t firstLine = 0);
+    void update();      // Call after DialogueBox::update
+    // Restarts a TIMELINE cue of the node part-way through, e.g. from a save; false if
+    // the node has no such timeline
+    bool resumeTimeline(const std::string& id, float time);
+    // The node's first line has had its SET cues applied already (a save made on it
+    // is being resumed), so they're passed over when it starts; its other cues still fire
+    void setFirstLineApplied();
+
+    const ScriptNode& getNode() const;
+    std::size_t getLineIndex() const;   // Line of the node on screen
+    // Where each option on the menu is in getNode().choices; only those whose
+    // conditions held are offered
+    const std::vector<std::size_t>& getOfferedChoices() const;
+    const ChapterArena& getArena() const;
+    // Every line started, across chapters, until cleared
+    Backlog& getBacklog();
+
+    // Skipping races through lines the player has read before (see ReadLog), a
+    // batch per update. Cues on the lines passed over are cut short: only the last
+    // background and camera move are applied, portraits cut, sounds, timelines and
+    // inspects are left out. Story variables are still set and branches still
+    // taken. It stops by itself at an unread line, a choice or a chapter change.
+    void setSkipping(bool skipping);
+    bool isSkipping() const;
+
+    // CHAPTER cues are left to the owner, which decides how the next node is loaded.
+    // It must not start a node from inside the callback; defer it to a later frame.
+    std::function<void(const ScriptCue&)> onChapter;
+    // INSPECT cues, also left to the owner; the benchmark has nothing to show them on
+    std::function<void(const ScriptCue&)> onInspect;
+    // Optional; reports how long each cue and choice took
+    std::function<void(const TriggerTiming&)> onTriggerTimed;
+
+private:
+    void syncLines();
+    void skipRead();
+    void lineStarted(std::size_t index);
+    bool isLineShown(std::size_t index) const;
+    void runCue(const ScriptCue& cue, const std::uint8_t* effect);
+    void choose(std::size_t option);
+    void jump(const std::string& nextNode, const char* kind);
+    void report(const char* kind, const std::string& target, double seconds);
+
+    BackgroundManager& background;
+    DialogueBox& dialogue;
+    ChoiceBox& choices;
+    PortraitStage& stage;
+    Camera& camera;
+    TimelinePlayer& timelines;
+    ParticleSystem& particles;
+    SoundManager& sounds;
+
+    // A cue with its condition and (SET only) effect compiled
+    struct CompiledCue {
+        const ScriptCue* cue;
+        const std::uint8_t* condition;
+        const std::uint8_t* effect;
+    };
+
+    // The cues that fire on one line, resolved once when the node starts
+    struct LineCues {
+        CompiledCue* cues;
+        std::size_t count;
+        const std::uint8_t* condition;      // The line's own
+    };
+
+    struct CompiledChoice {
+        const std::uint8_t* condition;
+        const std::uint8_t* effect;
+    };
+
+    ScriptNode node;
+    ChapterArena arena;             // Line table and cue lookup for every node of the chapter
+    Backlog backlog;
+    LineCues* lineCues = nullptr;   // One per line of node, in the arena
+    CompiledChoice* choiceCode = nullptr;   // One per choice of node, in the arena
+    std::vector<Choice> options;    // Reused for every menu
+    std::vector<std::size_t> offered;   // Node choice behind each option
+    std::size_t firstLine = 0;
+    std::size_t linesSeen = 0;      // DialogueBox::getLinesStarted() at the last update
+    bool choicesOffered = false;
+    bool firstLineApplied = false;
+
+    bool skipping = false;
+    const ScriptCue* skippedBackground = nullptr;   // Last of each passed over in a batch
+    const ScriptCue* skippedCamera = nullptr;
+    const std::size_t skipLinesPerUpdate = 8;       // 480 lines a second at 60 Hz
+};
+
+#endif // STORYPLAYER_HPP
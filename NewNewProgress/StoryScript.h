@@ -0,0 +1,90 @@
+#ifndef STORYSCRIPT_HPP
+#define STORYSCRIPT_HPP
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "DialogueBox.h"
+#include "BackgroundManager.h"
+#include "Camera.h"
+#include "Timeline.h"
+#include "ParticleSystem.h"
+#include "PortraitStage.h"
+
+// Something that happens when a particular line comes up
+enum class CueType {
+    BACKGROUND,     // argument: image to switch to, or a "#rrggbb" colour
+    TRANSITION,     // Same, blended in as transition says
+    SOUND,          // argument: sound name (see ScriptNode::sounds)
+    PORTRAIT,       // argument: character (see ScriptNode::characters); stage: where and how
+                    // they come on, move or leave. "" with stage.exit clears the stage
+    CAMERA,         // camera: the move to play, eased from wherever the camera is
+    CHAPTER,        // argument: next node; titles: the cards shown while it loads
+    INSPECT,        // argument: cooked .tiles image the player pans and zooms around
+    TIMELINE,       // argument: timeline name (saved with progress); timeline: its keys
+    PARTICLES,      // argument: effect to start (see ScriptNode::effects); "" stops every
+                    // emitter and lets what's out die away
+    SET,            // argument: effect on the story variables, e.g. "gahum = 1" (see StoryCode)
+    JUMP            // argument: node to branch to, in the same chapter; the rest of this
+                    // node is dropped. Usually with a condition
+};
+
+struct ScriptCue {
+    std::string line;
+    CueType type;
+    std::string argument;
+    std::vector<std::string> titles;
+    std::vector<CameraKeyframe> camera;
+    std::vector<TimelineKey> timeline;
+    BackgroundTransition transition;
+    StageDirection stage;
+    std::string condition;      // Only fires if this holds (see StoryCode); empty = always
+};
+
+// An option offered on a node's last line
+struct ScriptChoice {
+    std::string text;
+    std::string nextNode;
+    std::string condition;      // Only offered if this holds (see StoryCode)
+    std::string effect;         // Run on the story variables when it's picked
+};
+
+// A line of the script: its node's place in the script, then its index in the node
+using LineId = std::uint32_t;
+
+// One loadable chunk of the story (a chapter or a branch) plus the assets it needs
+struct ScriptNode {
+    static const std::size_t notInScript = static_cast<std::size_t>(-1);   // Put together in code
+
+    std::string id;
+    std::size_t index = notInScript;            // Of the node in the script, for line IDs
+    std::string background;                     // Shown when the node starts (empty = keep)
+    std::vector<std::string> preloadBackgrounds; // Swapped in by cues mid-node
+    std::vector<std::pair<std::string, std::string>> sounds;  // Sound name, file
+    std::vector<std::pair<std::string, ParticleEffect>> effects;    // Started by PARTICLES cues
+    std::vector<std::pair<std::string, CharacterSheet>> characters; // Put on stage by PORTRAIT cues
+    std::vector<DialogueEntry> lines;
+    std::vector<ScriptCue> cues;
+    std::vector<ScriptChoice> choices;
+};
+
+class StoryScript {
+public:
+    static const char* const firstNode;
+
+    static bool loadNode(const std::string& nodeId, ScriptNode& node);
+    static std::vector<std::string> getNodeIds();
+
+    // Where a line of dialogue lives, e.g. to pick the story back up from a save
+    static bool findLine(const std::string& text, std::string& nodeId, std::size_t& lineIndex);
+
+    static LineId makeLineId(std::size_t nodeIndex, std::size_t lineIndex);
+    static std::size_t getNodeIndex(LineId id);
+    static std::size_t getLineIndex(LineId id);
+    // The line an ID refers to, or null. A node's lines are built the first time one
+    // of them is asked for and kept from then on. Main thread only.
+    static const DialogueEntry* getLine(LineId id);
+};
+
+#endif // STORYSCRIPT_HPP
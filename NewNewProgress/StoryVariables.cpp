@@ -0,0 +1,70 @@
+#include "StoryVariables.h"
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+    // Script names, by StoryVariable
+    const char* const variableNames[] = { "shook_hand", "stared", "questions", "gahum" };
+    static_assert(sizeof(variableNames) / sizeof(variableNames[0]) == StoryVariables::count,
+        "every story variable needs a name");
+}
+
+const std::size_t StoryVariables::count;
+
+StoryVariables::StoryVariables() {
+    reset();
+}
+
+std::uint8_t StoryVariables::get(StoryVariable variable) const {
+    return get(static_cast<std::size_t>(variable));
+}
+
+void StoryVariables::set(StoryVariable variable, int value) {
+    set(static_cast<std::size_t>(variable), value);
+}
+
+std::uint8_t StoryVariables::get(std::size_t index) const {
+    return values[index];
+}
+
+void StoryVariables::set(std::size_t index, int value) {
+    values[index] = static_cast<std::uint8_t>(value < 0 ? 0 : value > 255 ? 255 : value);
+}
+
+void StoryVariables::reset() {
+    std::memset(values, 0, sizeof(values));
+}
+
+std::string StoryVariables::save() const {
+    static const char digits[] = "0123456789abcdef";
+    std::string saved;
+    saved.reserve(count * 2);
+    for (std::uint8_t value : values) {
+        saved += digits[value >> 4];
+        saved += digits[value & 0xF];
+    }
+    return saved;
+}
+
+bool StoryVariables::load(const std::string& saved) {
+    reset();
+    for (std::size_t i = 0; i < count && i * 2 + 1 < saved.size(); ++i) {
+        char digits[3] = { saved[i * 2], saved[i * 2 + 1], '\0' };
+        char* end = nullptr;
+        long value = std::strtol(digits, &end, 16);
+        if (end != digits + 2) {
+            reset();
+            return false;
+        }
+        values[i] = static_cast<std::uint8_t>(value);
+    }
+    return true;
+}
+
+int StoryVariables::find(const char* name, std::size_t length) {
+    for (std::size_t i = 0; i < count; ++i) {
+        if (std::strlen(variableNames[i]) == length && std::strncmp(variableNames[i], name, length) == 0)
+            return static_cast<int>(i);
+    }
+    return -1;
+}
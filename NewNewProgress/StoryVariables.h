@@ -0,0 +1,58 @@
+#ifndef STORYVARIABLES_HPP
+#define STORYVARIABLES_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// What the story remembers about the player's choices. Script conditions and
+// effects refer to these by name (see StoryCode). New ones go at the end, so older
+// saves still line up. Where the script sets and reads each is noted alongside.
+enum class StoryVariable : std::uint8_t {
+    SHOOK_HAND,     // "shook_hand": took the stranger's hand in the market ("Makipagkamay").
+                    // Read in maca_bumalik: Maca doesn't ask to hold their hand again
+    STARED,         // "stared": stared back at him instead ("Tumitig"). Not read yet
+    QUESTIONS,      // "questions": times Maca was asked something more ("Magtanong pa").
+                    // Not read yet
+    TOOK_GAHUM,     // "gahum": let Maca put the amulet on (SET cue in maca_wala_na).
+                    // Not read yet
+    Count
+};
+
+// Every story variable, a byte each, in one flat array indexed by StoryVariable.
+// Small numbers only (0 to 255; anything else is clamped), which is plenty for
+// flags and counters and keeps a save down to a couple of hex digits a variable.
+// Main thread only.
+class StoryVariables {
+public:
+    static const std::size_t count = static_cast<std::size_t>(StoryVariable::Count);
+
+    static StoryVariables& getInstance() {
+        static StoryVariables instance;
+        return instance;
+    }
+
+    std::uint8_t get(StoryVariable variable) const;
+    void set(StoryVariable variable, int value);
+    // By index, for the interpreter; the index has to be below count
+    std::uint8_t get(std::size_t index) const;
+    void set(std::size_t index, int value);
+    void reset();       // All back to 0, for a new game
+
+    std::string save() const;               // Two hex digits a variable
+    bool load(const std::string& saved);    // Missing ones (an older save) are 0
+
+    // The variable a script name stands for, or -1
+    static int find(const char* name, std::size_t length);
+
+    // Prevent copying
+    StoryVariables(const StoryVariables&) = delete;
+    StoryVariables& operator=(const StoryVariables&) = delete;
+
+private:
+    StoryVariables();
+
+    std::uint8_t values[count];
+};
+
+#endif // STORYVARIABLES_HPP
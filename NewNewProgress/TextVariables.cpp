@@ -0,0 +1,118 @@
+#include "TextVariables.h"
+#include "ChapterArena.h"
+#include <cstring>
+
+namespace {
+    // Placeholder names, by TextVariable
+    const char* const placeholderNames[] = { "Name", "Nickname" };
+}
+
+TextVariables::TextVariables() : snapshots(1, Values(variableCount)) {
+}
+
+// A change starts a new snapshot; the old ones stay as they were for the backlog
+void TextVariables::set(TextVariable variable, const std::string& value) {
+    std::size_t index = static_cast<std::size_t>(variable);
+    if (snapshots.back()[index] == value) return;
+    if (snapshots.size() < 0xFFFF)
+        snapshots.push_back(snapshots.back());
+    snapshots.back()[index] = value;
+}
+
+const std::string& TextVariables::get(TextVariable variable) const {
+    return snapshots.back()[static_cast<std::size_t>(variable)];
+}
+
+std::uint16_t TextVariables::getSnapshot() const {
+    return static_cast<std::uint16_t>(snapshots.size() - 1);
+}
+
+int TextVariables::findVariable(const char* name, std::size_t length) {
+    for (std::size_t i = 0; i < variableCount; ++i) {
+        if (std::strlen(placeholderNames[i]) == length && std::strncmp(placeholderNames[i], name, length) == 0)
+            return static_cast<int>(i);
+    }
+    return -1;
+}
+
+// Two passes over the text: count the spans, then fill them in
+std::size_t TextVariables::tokenize(const char* text, ChapterArena& arena, const TextSpan*& spans) {
+    spans = nullptr;
+    TextSpan* filled = nullptr;
+    std::size_t count = 0;
+
+    for (int pass = 0; pass < 2; ++pass) {
+        std::size_t span = 0;
+        const char* literal = text;
+        for (const char* c = text; *c; ++c) {
+            if (*c != '[') continue;
+            const char* close = std::strchr(c + 1, ']');
+            if (!close) break;
+            int variable = findVariable(c + 1, close - c - 1);
+            if (variable < 0) continue;
+
+            if (c > literal) {
+                if (filled) filled[span] = { literal, static_cast<std::uint32_t>(c - literal), -1 };
+                ++span;
+            }
+            if (filled) filled[span] = { nullptr, 0, static_cast<std::int8_t>(variable) };
+            ++span;
+            c = close;
+            literal = close + 1;
+        }
+
+        if (pass == 0) {
+            // No placeholders at all: nothing to put together
+            if (span == 0) return 0;
+            if (*literal) ++span;
+            count = span;
+            filled = arena.allocateArray<TextSpan>(count);
+        }
+        else if (*literal) {
+            filled[span] = { literal, static_cast<std::uint32_t>(std::strlen(literal)), -1 };
+        }
+    }
+
+    spans = filled;
+    return count;
+}
+
+void TextVariables::append(const Values& values, int variable, std::string& out) {
+    const std::string& value = values[variable];
+    if (value.empty()) {
+        out += '[';
+        out += placeholderNames[variable];
+        out += ']';
+    }
+    else {
+        out += value;
+    }
+}
+
+void TextVariables::expand(const TextSpan* spans, std::size_t count, std::string& out) const {
+    out.clear();
+    for (std::size_t i = 0; i < count; ++i) {
+        if (spans[i].variable < 0)
+            out.append(spans[i].text, spans[i].length);
+        else
+            append(snapshots.back(), spans[i].variable, out);
+    }
+}
+
+void TextVariables::expand(const std::string& text, std::uint16_t snapshot, std::string& out) const {
+    const Values& values = snapshots[snapshot < snapshots.size() ? snapshot : snapshots.size() - 1];
+    out.clear();
+    std::size_t literal = 0;
+    for (std::size_t open = text.find('['); open != std::string::npos; open = text.find('[', open + 1)) {
+        std::size_t close = text.find(']', open + 1);
+        if (close == std::string::npos) break;
+        int variable = findVariable(text.data() + open + 1, close - open - 1);
+        if (variable < 0) continue;
+
+        out.append(text, literal, open - literal);
+        append(values, variable, out);
+        literal = close + 1;
+        open = close;
+    }
+    out.append(text, literal, std::string::npos);
+}
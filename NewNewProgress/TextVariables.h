@@ -0,0 +1,66 @@
+#ifndef TEXTVARIABLES_HPP
+#define TEXTVARIABLES_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class ChapterArena;
+
+// What the script's [Name] and [Nickname] placeholders stand for
+enum class TextVariable : std::uint8_t {
+    NAME,
+    NICKNAME,
+    Count
+};
+
+// A piece of a line: literal text, or a placeholder to fill in
+struct TextSpan {
+    const char* text;           // Literal only; not null-terminated
+    std::uint32_t length;
+    std::int8_t variable;       // -1 for literal text, else a TextVariable
+};
+
+// The player's names, and the placeholders in the script that use them. Lines are
+// split into spans once, when a node is loaded, and put back together into a
+// reusable buffer only when a line starts.
+//
+// Every change of names is kept as a numbered set, so the backlog can show an old
+// line the way it read at the time. Main thread only.
+class TextVariables {
+public:
+    static TextVariables& getInstance() {
+        static TextVariables instance;
+        return instance;
+    }
+
+    void set(TextVariable variable, const std::string& value);
+    const std::string& get(TextVariable variable) const;
+    std::uint16_t getSnapshot() const;      // The current set of names
+
+    // Spans for text, in the arena; 0 (and no spans) if it has no placeholders, so
+    // the text can be shown as it is. Brackets that aren't a known name are left alone.
+    static std::size_t tokenize(const char* text, ChapterArena& arena, const TextSpan*& spans);
+    // Into out, reusing its buffer. A name that hasn't been set stays a placeholder.
+    void expand(const TextSpan* spans, std::size_t count, std::string& out) const;
+    // Same, straight from the script text, with an earlier snapshot of the names
+    void expand(const std::string& text, std::uint16_t snapshot, std::string& out) const;
+
+    // Prevent copying
+    TextVariables(const TextVariables&) = delete;
+    TextVariables& operator=(const TextVariables&) = delete;
+
+private:
+    TextVariables();
+
+    static const std::size_t variableCount = static_cast<std::size_t>(TextVariable::Count);
+    using Values = std::vector<std::string>;
+
+    static int findVariable(const char* name, std::size_t length);
+    static void append(const Values& values, int variable, std::string& out);
+
+    std::vector<Values> snapshots;      // The last one is current
+};
+
+#endif // TEXTVARIABLES_HPP
@@ -0,0 +1,297 @@
+#include "TextureCache.h"
+#include "ImageFilter.h"
+#include "ImageResample.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+namespace {
+    std::size_t tierBytes(sf::Vector2u size, unsigned tier) {
+        std::size_t width = std::max(1u, size.x >> tier);
+        std::size_t height = std::max(1u, size.y >> tier);
+        return width * height * 4;
+    }
+
+    // The sharpest tier that fits in the room left and under the size limit
+    unsigned chooseTier(sf::Vector2u size, std::size_t room, unsigned maxDimension) {
+        unsigned tier = 0;
+        while (tier < TextureCache::maxTier &&
+            ((std::max(size.x, size.y) >> tier) > maxDimension || tierBytes(size, tier) > room))
+            ++tier;
+        return tier;
+    }
+
+    const char* fitNames[] = { "cover", "letterbox", "stretch" };
+}
+
+std::shared_ptr<const sf::Texture> TextureCache::get(const std::string& path) {
+    auto it = textures.find(path);
+    if (it != textures.end()) {
+        ++stats.hits;
+        it->second.lastUsed = ++useCounter;
+        return it->second.texture;
+    }
+
+    auto loading = pending.find(path);
+    if (loading != pending.end()) {
+        ++stats.waits;
+        JobHandle upload = loading->second;     // The upload job erases its own entry
+        PROFILE_SCOPE(IO);
+        JobSystem::getInstance().wait(upload);
+        it = textures.find(path);
+        if (it == textures.end())
+            return nullptr;
+        it->second.lastUsed = ++useCounter;
+        return it->second.texture;
+    }
+
+    // Nothing preloaded it: decode and upload right here, on the frame that asked
+    PROFILE_SCOPE(IO);
+    ++stats.misses;
+    Decoded decoded;
+    if (!decode(path, headroom(), getMaxDimension(), decoded))
+        return nullptr;
+    return upload(path, decoded);
+}
+
+std::string TextureCache::fittedKey(const std::string& key, sf::Vector2u footprint, FitMode mode) {
+    char suffix[48];
+    std::snprintf(suffix, sizeof(suffix), "@%s:%ux%u", fitNames[static_cast<int>(mode)], footprint.x, footprint.y);
+    return key + suffix;
+}
+
+sf::Vector2u TextureCache::getSourceSize(const std::string& path) const {
+    auto it = textures.find(path);
+    return it != textures.end() ? it->second.sourceSize : sf::Vector2u(0, 0);
+}
+
+JobHandle TextureCache::loadAsync(const std::string& path) {
+    if (textures.find(path) != textures.end())
+        return nullptr;
+
+    auto loading = pending.find(path);
+    if (loading != pending.end())
+        return loading->second;
+
+    // The worker picks the tier, so it gets a snapshot of the budget as it is now
+    JobSystem& jobs = JobSystem::getInstance();
+    auto decoded = std::make_shared<Decoded>();
+    std::size_t room = headroom();
+    unsigned maxSize = getMaxDimension();
+
+    JobHandle decode = jobs.submit("decode " + path, [decoded, path, room, maxSize]() {
+        TextureCache::decode(path, room, maxSize, *decoded);
+    });
+
+    // GL work has to happen on the main thread
+    JobHandle upload = jobs.submitMain("upload " + path, [this, decoded, path]() {
+        pending.erase(path);
+        if (!decoded->ok) {
+            std::cerr << "Failed to decode texture: " << path << "\n";
+            return;
+        }
+        this->upload(path, *decoded);
+    }, { decode });
+
+    pending[path] = upload;
+    return upload;
+}
+
+bool TextureCache::preload(const std::string& path) {
+    return get(path) != nullptr;
+}
+
+bool TextureCache::isLoaded(const std::string& path) const {
+    return textures.find(path) != textures.end();
+}
+
+void TextureCache::setBudget(std::size_t bytes) {
+    budget = bytes;
+    makeRoom(0);
+}
+
+std::size_t TextureCache::getBudget() const {
+    return budget;
+}
+
+void TextureCache::setMaxDimension(unsigned pixels) {
+    maxDimension = pixels;
+}
+
+void TextureCache::trim() {
+    for (auto it = textures.begin(); it != textures.end();) {
+        if (it->second.texture.use_count() == 1 && !pinned.count(it->first)) {
+            residentBytes -= it->second.bytes;
+            it = textures.erase(it);
+            ++stats.evictions;
+            PROFILE_COUNT(TextureEvictions);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+void TextureCache::pin(const std::string& path) {
+    pinned.insert(path);
+}
+
+void TextureCache::unpinAll() {
+    pinned.clear();
+}
+
+const TextureCacheStats& TextureCache::getStats() const {
+    return stats;
+}
+
+void TextureCache::resetStats() {
+    stats = TextureCacheStats();
+}
+
+TextureResidency TextureCache::getResidency() const {
+    TextureResidency residency;
+    residency.residentBytes = residentBytes;
+    residency.budgetBytes = budget;
+    for (const auto& entry : textures) {
+        ++residency.textures;
+        if (entry.second.texture.use_count() > 1) {
+            ++residency.inUse;
+            residency.inUseBytes += entry.second.bytes;
+        }
+        if (entry.second.tier > 0)
+            ++residency.reduced;
+    }
+    return residency;
+}
+
+std::vector<std::string> TextureCache::getLoadedPaths() const {
+    std::vector<std::string> paths;
+    for (const auto& entry : textures)
+        paths.push_back(entry.first);
+    return paths;
+}
+
+std::size_t TextureCache::getMemoryBytes() const {
+    return residentBytes;
+}
+
+void TextureCache::clear() {
+    // Uploads still queued would write into the emptied map later on
+    while (!pending.empty()) {
+        JobHandle upload = pending.begin()->second;
+        JobSystem::getInstance().wait(upload);
+    }
+    textures.clear();
+    residentBytes = 0;
+}
+
+bool TextureCache::decode(const std::string& key, std::size_t room, unsigned maxDimension, Decoded& decoded) {
+    // "path|filters@fit:WxH", both parts optional
+    std::string rest = key;
+    bool fitted = false;
+    FitMode mode = FitMode::COVER;
+    sf::Vector2u footprint;
+    std::size_t at = rest.rfind('@');
+    if (at != std::string::npos) {
+        char name[16] = {};
+        if (std::sscanf(rest.c_str() + at + 1, "%15[a-z]:%ux%u", name, &footprint.x, &footprint.y) == 3) {
+            for (int i = 0; i < 3; ++i) {
+                if (std::strcmp(name, fitNames[i]) == 0) {
+                    mode = static_cast<FitMode>(i);
+                    fitted = true;
+                }
+            }
+        }
+        if (!fitted)
+            std::cerr << "Bad texture fit: " << key << "\n";
+        rest.resize(at);
+    }
+    std::size_t bar = rest.find('|');
+
+    if (!decoded.image.loadFromFile(rest.substr(0, bar)))
+        return false;
+    decoded.sourceSize = decoded.image.getSize();
+
+    // The tier comes off the size the image ends up at. A fit that shrinks it gets
+    // to the reduced size in one pass; an image the fit leaves alone (already no
+    // bigger than it shows) is halved like an unfitted one.
+    sf::Vector2u size = decoded.sourceSize;
+    if (fitted)
+        size = ImageResample::fitResult(decoded.sourceSize, footprint, mode);
+    decoded.tier = chooseTier(size, room, maxDimension);
+
+    float scale = 1.0f;
+    if (size != decoded.sourceSize) {
+        footprint.x = std::max(1u, footprint.x >> decoded.tier);
+        footprint.y = std::max(1u, footprint.y >> decoded.tier);
+        scale = ImageResample::fit(decoded.image, footprint, mode);
+    }
+    else {
+        for (unsigned tier = 0; tier < decoded.tier; ++tier)
+            ImageResample::halve(decoded.image);
+        scale = static_cast<float>(decoded.image.getSize().x) / decoded.sourceSize.x;
+    }
+
+    // Filtering after the reduction is cheaper, and blur radii scale down to match
+    if (bar != std::string::npos)
+        ImageFilter::apply(decoded.image, rest.substr(bar + 1), scale);
+    decoded.ok = true;
+    return true;
+}
+
+std::shared_ptr<const sf::Texture> TextureCache::upload(const std::string& path, Decoded& decoded) {
+    sf::Vector2u size = decoded.image.getSize();
+    std::size_t bytes = static_cast<std::size_t>(size.x) * size.y * 4;
+    makeRoom(bytes);
+
+    PROFILE_COUNT(TextureUploads);
+    auto texture = std::make_shared<sf::Texture>();
+    if (!texture->loadFromImage(decoded.image))
+        return nullptr;
+    if (decoded.tier > 0)
+        ++stats.reduced;
+
+    Entry& entry = textures[path];
+    residentBytes += bytes - entry.bytes;
+    entry.texture = texture;
+    entry.sourceSize = decoded.sourceSize;
+    entry.bytes = bytes;
+    entry.tier = decoded.tier;
+    entry.lastUsed = ++useCounter;
+    return texture;
+}
+
+std::size_t TextureCache::headroom() const {
+    std::size_t inUse = 0;
+    for (const auto& entry : textures) {
+        if (entry.second.texture.use_count() > 1 || pinned.count(entry.first))
+            inUse += entry.second.bytes;
+    }
+    return budget > inUse ? budget - inUse : 0;
+}
+
+void TextureCache::makeRoom(std::size_t bytes) {
+    while (residentBytes + bytes > budget) {
+        auto victim = textures.end();
+        for (auto it = textures.begin(); it != textures.end(); ++it) {
+            if (it->second.texture.use_count() == 1 && !pinned.count(it->first) &&
+                (victim == textures.end() || it->second.lastUsed < victim->second.lastUsed))
+                victim = it;
+        }
+        if (victim == textures.end())
+            return;     // Everything left is on screen or pinned; go over rather than pull it out
+
+        residentBytes -= victim->second.bytes;
+        textures.erase(victim);
+        ++stats.evictions;
+        PROFILE_COUNT(TextureEvictions);
+    }
+}
+
+unsigned TextureCache::getMaxDimension() {
+    if (gpuMaxDimension == 0)
+        gpuMaxDimension = sf::Texture::getMaximumSize();
+    return maxDimension ? std::min(maxDimension, gpuMaxDimension) : gpuMaxDimension;
+}
@@ -0,0 +1,145 @@
+#ifndef TEXTURECACHE_HPP
+#define TEXTURECACHE_HPP
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "JobSystem.h"
+#include "ImageResample.h"
+
+// What get() had to do since the last resetStats()
+struct TextureCacheStats {
+    unsigned hits = 0;
+    unsigned misses = 0;    // Decoded and uploaded synchronously, on the frame that asked
+    unsigned waits = 0;     // Blocked on a background load that hadn't finished
+    unsigned evictions = 0; // Unused textures dropped to stay under the budget
+    unsigned reduced = 0;   // Loads that came in below full resolution
+};
+
+// Snapshot for the profiler overlay
+struct TextureResidency {
+    std::size_t residentBytes = 0;
+    std::size_t budgetBytes = 0;
+    std::size_t inUseBytes = 0;     // Held by a screen or manager, so not evictable
+    unsigned textures = 0;
+    unsigned inUse = 0;
+    unsigned reduced = 0;           // Resident below full resolution
+};
+
+// Shared textures keyed by file path, kept under a memory budget. Each image is
+// decoded and uploaded once; get() hands out a shared handle, and a texture counts
+// as visible for as long as anyone holds one. Textures nobody holds stay cached
+// until the budget needs the room, then go least recently used first.
+//
+// When even evicting everything unused wouldn't make room, a new texture is loaded
+// at a lower tier instead: each tier halves the width and height. Textures larger
+// than the GPU's limit (or setMaxDimension) are always reduced. A tier is picked
+// when the texture loads and never changes while it's held, since sprites keep the
+// size they were set up with.
+//
+// A key can also name a filtered variant of an image, "path|filters", e.g.
+// "Biringan2.jpg|blur(6) darken(0.4)" (see ImageFilter for the steps). The filters
+// run on the decoded pixels as part of the load, so a variant costs the same to
+// draw as the plain image and is cached, budgeted and evicted on its own.
+//
+// Likewise a key from fittedKey() names the image resampled down to the pixels it
+// actually covers in the window, so a large source never goes to the GPU at full
+// size just to be shrunk again on every draw.
+class TextureCache {
+public:
+    static TextureCache& getInstance() {
+        static TextureCache instance;
+        return instance;
+    }
+
+    static const unsigned maxTier = 3;  // At most 1/8 of the width and height
+
+    // Returns the texture, loading it on first use; empty if the file can't be loaded.
+    // If the texture is still loading in the background this waits for it.
+    std::shared_ptr<const sf::Texture> get(const std::string& path);
+
+    // "path@cover:1600x900": the key's image fitted to a footprint in window pixels.
+    // Every footprint is a texture of its own, so after a resize the old size stays
+    // cached (and evictable) in case the window goes back to it.
+    static std::string fittedKey(const std::string& key, sf::Vector2u footprint, FitMode mode);
+
+    // Full-resolution size of a loaded texture, so callers that scale against the
+    // image's real size can make up for a reduced tier. Zero if it isn't loaded.
+    sf::Vector2u getSourceSize(const std::string& path) const;
+
+    // Decode on a worker, then upload on the main thread. The returned job is done
+    // once the texture is in the cache (empty handle if it already was).
+    JobHandle loadAsync(const std::string& path);
+
+    // Load ahead of time (e.g. during a chapter card) so a later get() costs nothing
+    bool preload(const std::string& path);
+    bool isLoaded(const std::string& path) const;
+
+    void setBudget(std::size_t bytes);  // Evicts straight away if now over it
+    std::size_t getBudget() const;
+    void setMaxDimension(unsigned pixels);      // 0 = the GPU's maximum texture size
+
+    // Drop every texture nobody holds and nobody pinned, e.g. when the window is minimized
+    void trim();
+    // Keep a texture through trim() though nothing holds it yet, e.g. one preloaded
+    // behind a chapter card. Pinning before loadAsync covers the load itself too.
+    void pin(const std::string& path);
+    void unpinAll();
+
+    const TextureCacheStats& getStats() const;
+    void resetStats();
+    TextureResidency getResidency() const;
+    std::vector<std::string> getLoadedPaths() const;
+    std::size_t getMemoryBytes() const;     // Uncompressed RGBA size of every cached texture
+
+    // Drops every texture. Handles already given out stay valid; the cache just
+    // forgets them. Waits for background loads first.
+    void clear();
+
+    // Prevent copying
+    TextureCache(const TextureCache&) = delete;
+    TextureCache& operator=(const TextureCache&) = delete;
+
+private:
+    TextureCache() = default;
+
+    struct Entry {
+        std::shared_ptr<sf::Texture> texture;
+        sf::Vector2u sourceSize;
+        std::size_t bytes = 0;
+        unsigned tier = 0;
+        std::uint64_t lastUsed = 0;
+    };
+
+    // Decoded pixels on their way from a worker to the upload job
+    struct Decoded {
+        sf::Image image;
+        sf::Vector2u sourceSize;
+        unsigned tier = 0;
+        bool ok = false;
+    };
+
+    // Loads, reduces and filters the image a key names; safe to run on a worker
+    static bool decode(const std::string& key, std::size_t room, unsigned maxDimension, Decoded& decoded);
+    std::shared_ptr<const sf::Texture> upload(const std::string& path, Decoded& decoded);
+    std::size_t headroom() const;   // Room left if everything unused and unpinned were evicted
+    void makeRoom(std::size_t bytes);
+    unsigned getMaxDimension();
+
+    std::unordered_map<std::string, Entry> textures;
+    std::unordered_map<std::string, JobHandle> pending;     // Main thread only
+    std::unordered_set<std::string> pinned;
+    TextureCacheStats stats;
+
+    std::size_t budget = 256 * 1024 * 1024;
+    std::size_t residentBytes = 0;
+    unsigned maxDimension = 0;      // From setMaxDimension; 0 = no limit of our own
+    unsigned gpuMaxDimension = 0;   // Queried on first use; needs a GL context
+    std::uint64_t useCounter = 0;   // Ordering for least-recently-used eviction
+};
+
+#endif // TEXTURECACHE_HPP
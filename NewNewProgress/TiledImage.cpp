@@ -0,0 +1,216 @@
+#include "TiledImage.h"
+#include "ImageResample.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+namespace {
+    const char magic[4] = { 'B', 'T', 'I', 'L' };
+    const std::uint32_t version = 1;
+
+    void writeU32(std::ostream& out, std::uint32_t value) {
+        char bytes[4];
+        for (int i = 0; i < 4; ++i)
+            bytes[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+        out.write(bytes, 4);
+    }
+
+    void writeU64(std::ostream& out, std::uint64_t value) {
+        writeU32(out, static_cast<std::uint32_t>(value & 0xFFFFFFFFu));
+        writeU32(out, static_cast<std::uint32_t>(value >> 32));
+    }
+
+    bool readU32(std::istream& in, std::uint32_t& value) {
+        unsigned char bytes[4];
+        if (!in.read(reinterpret_cast<char*>(bytes), 4))
+            return false;
+        value = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<std::uint32_t>(bytes[3]) << 24);
+        return true;
+    }
+
+    bool readU64(std::istream& in, std::uint64_t& value) {
+        std::uint32_t low = 0, high = 0;
+        if (!readU32(in, low) || !readU32(in, high))
+            return false;
+        value = (static_cast<std::uint64_t>(high) << 32) | low;
+        return true;
+    }
+}
+
+std::vector<TiledLevel> TiledImage::layout(sf::Vector2u size, unsigned tileSize) {
+    std::vector<TiledLevel> levels;
+    std::size_t tileCount = 0;
+    for (;;) {
+        TiledLevel level;
+        level.size = size;
+        level.columns = (size.x + tileSize - 1) / tileSize;
+        level.rows = (size.y + tileSize - 1) / tileSize;
+        level.firstTile = tileCount;
+        tileCount += static_cast<std::size_t>(level.columns) * level.rows;
+        levels.push_back(level);
+
+        // Stop once the whole image fits in one tile
+        if (level.columns == 1 && level.rows == 1)
+            return levels;
+        size = sf::Vector2u(std::max(1u, size.x / 2), std::max(1u, size.y / 2));
+    }
+}
+
+bool TiledImage::cook(const sf::Image& source, const std::string& outputPath, unsigned tileSize) {
+    sf::Vector2u size = source.getSize();
+    if (size.x == 0 || size.y == 0 || tileSize == 0) {
+        std::cerr << "Nothing to cook into " << outputPath << "\n";
+        return false;
+    }
+
+    std::vector<TiledLevel> levels = layout(size, tileSize);
+    std::size_t tileCount = levels.back().firstTile + 1;
+
+    std::ofstream file(outputPath, std::ios::binary);
+    if (!file) {
+        std::cerr << "Failed to write " << outputPath << "\n";
+        return false;
+    }
+
+    file.write(magic, 4);
+    writeU32(file, version);
+    writeU32(file, size.x);
+    writeU32(file, size.y);
+    writeU32(file, tileSize);
+    writeU32(file, static_cast<std::uint32_t>(levels.size()));
+
+    // The table is filled in once the tiles are written and their sizes known
+    std::streamoff tableStart = file.tellp();
+    std::vector<TileEntry> entries(tileCount);
+    for (std::size_t i = 0; i < tileCount; ++i) {
+        writeU64(file, 0);
+        writeU32(file, 0);
+    }
+
+    sf::Image level = source;
+    for (std::size_t l = 0; l < levels.size(); ++l) {
+        if (l > 0)
+            ImageResample::halve(level);
+        const TiledLevel& info = levels[l];
+
+        for (unsigned row = 0; row < info.rows; ++row) {
+            for (unsigned column = 0; column < info.columns; ++column) {
+                // The tile's own pixels plus a border wherever there is a neighbour
+                unsigned left = column * tileSize;
+                unsigned top = row * tileSize;
+                unsigned x0 = left > 0 ? left - border : 0;
+                unsigned y0 = top > 0 ? top - border : 0;
+                unsigned x1 = std::min(left + tileSize + border, info.size.x);
+                unsigned y1 = std::min(top + tileSize + border, info.size.y);
+
+                sf::Image tile;
+                tile.create(x1 - x0, y1 - y0);
+                tile.copy(level, 0, 0, sf::IntRect(x0, y0, x1 - x0, y1 - y0));
+
+                std::vector<sf::Uint8> png;
+                if (!tile.saveToMemory(png, "png")) {
+                    std::cerr << "Failed to encode a tile of " << outputPath << "\n";
+                    return false;
+                }
+                TileEntry& entry = entries[info.firstTile + static_cast<std::size_t>(row) * info.columns + column];
+                entry.offset = static_cast<std::uint64_t>(file.tellp());
+                entry.bytes = static_cast<std::uint32_t>(png.size());
+                file.write(reinterpret_cast<const char*>(png.data()), png.size());
+            }
+        }
+    }
+
+    file.seekp(tableStart);
+    for (const TileEntry& entry : entries) {
+        writeU64(file, entry.offset);
+        writeU32(file, entry.bytes);
+    }
+    return static_cast<bool>(file);
+}
+
+bool TiledImage::open(const std::string& filePath) {
+    path.clear();
+    levels.clear();
+    tiles.clear();
+
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file) {
+        std::cerr << "Failed to open tiled image: " << filePath << "\n";
+        return false;
+    }
+
+    char header[4];
+    std::uint32_t fileVersion = 0, width = 0, height = 0, fileTileSize = 0, levelCount = 0;
+    if (!file.read(header, 4) || !std::equal(header, header + 4, magic) ||
+        !readU32(file, fileVersion) || fileVersion != version ||
+        !readU32(file, width) || !readU32(file, height) ||
+        !readU32(file, fileTileSize) || !readU32(file, levelCount) ||
+        width == 0 || height == 0 || fileTileSize == 0) {
+        std::cerr << "Not a tiled image (or an old one; cook it again): " << filePath << "\n";
+        return false;
+    }
+
+    std::vector<TiledLevel> expected = layout(sf::Vector2u(width, height), fileTileSize);
+    if (expected.size() != levelCount) {
+        std::cerr << "Tiled image has an unexpected number of levels: " << filePath << "\n";
+        return false;
+    }
+
+    std::size_t tileCount = expected.back().firstTile + 1;
+    std::vector<TileEntry> table(tileCount);
+    for (TileEntry& entry : table) {
+        if (!readU64(file, entry.offset) || !readU32(file, entry.bytes)) {
+            std::cerr << "Tiled image is cut short: " << filePath << "\n";
+            return false;
+        }
+    }
+
+    path = filePath;
+    size = sf::Vector2u(width, height);
+    tileSize = fileTileSize;
+    levels = std::move(expected);
+    tiles = std::move(table);
+    return true;
+}
+
+bool TiledImage::isOpen() const {
+    return !path.empty();
+}
+
+sf::Vector2u TiledImage::getSize() const {
+    return size;
+}
+
+unsigned TiledImage::getTileSize() const {
+    return tileSize;
+}
+
+std::size_t TiledImage::getLevelCount() const {
+    return levels.size();
+}
+
+const TiledLevel& TiledImage::getLevel(std::size_t level) const {
+    return levels[level];
+}
+
+bool TiledImage::loadTile(std::size_t level, unsigned column, unsigned row, sf::Image& tile) const {
+    if (level >= levels.size() || column >= levels[level].columns || row >= levels[level].rows)
+        return false;
+    const TileEntry& entry = tiles[levels[level].firstTile + static_cast<std::size_t>(row) * levels[level].columns + column];
+
+    std::ifstream file(path, std::ios::binary);
+    std::vector<char> png(entry.bytes);
+    if (!file || !file.seekg(static_cast<std::streamoff>(entry.offset)) || !file.read(png.data(), png.size()))
+        return false;
+    return tile.loadFromMemory(png.data(), png.size());
+}
+
+sf::Vector2u TiledImage::getTileOffset(unsigned column, unsigned row) const {
+    return sf::Vector2u(column > 0 ? border : 0, row > 0 ? border : 0);
+}
+
+sf::Vector2u TiledImage::getTilePixels(std::size_t level, unsigned column, unsigned row) const {
+    const TiledLevel& info = levels[level];
+    return sf::Vector2u(std::min(tileSize, info.size.x - column * tileSize),
+        std::min(tileSize, info.size.y - row * tileSize));
+}
@@ -0,0 +1,68 @@
+#ifndef TILEDIMAGE_HPP
+#define TILEDIMAGE_HPP
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// One level of the pyramid: level 0 is the full image, each next one half the size
+struct TiledLevel {
+    sf::Vector2u size;
+    unsigned columns = 0;
+    unsigned rows = 0;
+    std::size_t firstTile = 0;  // Index of its top-left tile in the tile table
+};
+
+// A large image cooked into a mip pyramid of square tiles (.tiles), so a viewer
+// only ever decodes and uploads the part it shows, at the detail it shows it at,
+// and never needs a texture bigger than one tile. AssetCooker writes these; the
+// game only reads them.
+//
+// File layout, all integers little-endian:
+//   "BTIL", version, width, height, tileSize, levelCount     (u32 each)
+//   tile table: offset (u64) and byte size (u32) of every tile, level 0 first,
+//   each level's rows top to bottom
+//   tile data: one PNG per tile
+// Each tile's PNG also holds a border pixel copied from its neighbours on every
+// side that has one, so smooth filtering doesn't show the seams between tiles.
+class TiledImage {
+public:
+    static const unsigned defaultTileSize = 256;
+    static const unsigned border = 1;
+
+    // Builds the pyramid from a full-size image and writes it out (cooker side)
+    static bool cook(const sf::Image& source, const std::string& outputPath, unsigned tileSize = defaultTileSize);
+
+    // Reads the header and tile table only; tiles are loaded one at a time later
+    bool open(const std::string& path);
+    bool isOpen() const;
+
+    sf::Vector2u getSize() const;   // Full resolution
+    unsigned getTileSize() const;
+    std::size_t getLevelCount() const;
+    const TiledLevel& getLevel(std::size_t level) const;
+
+    // Pixels of the tile (column, row) of a level, border included: the tile's own
+    // pixels start at getTileOffset(). Const and opens its own stream, so any number
+    // of workers can load tiles at once.
+    bool loadTile(std::size_t level, unsigned column, unsigned row, sf::Image& tile) const;
+    sf::Vector2u getTileOffset(unsigned column, unsigned row) const;
+    sf::Vector2u getTilePixels(std::size_t level, unsigned column, unsigned row) const;   // Without the border
+
+private:
+    struct TileEntry {
+        std::uint64_t offset;
+        std::uint32_t bytes;
+    };
+
+    static std::vector<TiledLevel> layout(sf::Vector2u size, unsigned tileSize);
+
+    std::string path;
+    sf::Vector2u size;
+    unsigned tileSize = 0;
+    std::vector<TiledLevel> levels;
+    std::vector<TileEntry> tiles;
+};
+
+#endif // TILEDIMAGE_HPP
@@ -0,0 +1,248 @@
+#include "TiledImageView.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+bool TiledImageView::open(const std::string& path) {
+    close();
+    auto opened = std::make_shared<TiledImage>();
+    if (!opened->open(path))
+        return false;
+    image = opened;
+
+    std::size_t top = image->getLevelCount() - 1;
+    sf::Image pixels;
+    auto tile = std::make_unique<Tile>();
+    tile->loading = false;
+    if (!image->loadTile(top, 0, 0, pixels) || !tile->texture.loadFromImage(pixels)) {
+        std::cerr << "Failed to load the smallest level of " << path << "\n";
+        image.reset();
+        return false;
+    }
+    tile->texture.setSmooth(true);
+    tile->ready = true;
+    tiles[key(top, 0, 0)] = std::move(tile);
+
+    sf::Vector2f size = getImageSize();
+    setCamera(sf::Vector2f(size.x / 2.0f, size.y / 2.0f), 1.0f);
+    return true;
+}
+
+void TiledImageView::close() {
+    ++generation;
+    tiles.clear();
+    loading = 0;
+    image.reset();
+}
+
+bool TiledImageView::isOpen() const {
+    return image != nullptr;
+}
+
+sf::Vector2f TiledImageView::getImageSize() const {
+    return image ? sf::Vector2f(image->getSize()) : sf::Vector2f();
+}
+
+void TiledImageView::setCamera(const sf::Vector2f& newCenter, float newZoom) {
+    center = newCenter;
+    zoom = std::max(newZoom, 1e-4f);
+}
+
+const sf::Vector2f& TiledImageView::getCenter() const {
+    return center;
+}
+
+float TiledImageView::getZoom() const {
+    return zoom;
+}
+
+float TiledImageView::getFitZoom(const sf::Vector2u& targetSize) const {
+    sf::Vector2f size = getImageSize();
+    if (size.x <= 0.0f || size.y <= 0.0f)
+        return 1.0f;
+    return std::min(targetSize.x / size.x, targetSize.y / size.y);
+}
+
+void TiledImageView::update(const sf::Vector2u& targetSize) {
+    if (!image) return;
+    ++frame;
+
+    std::size_t level = levelForZoom();
+    sf::FloatRect area = visibleArea(targetSize);
+
+    // Visible tiles of this level and every coarser one are in use: draw() falls
+    // back on the coarser ones while this level streams in
+    for (std::size_t l = level; l < image->getLevelCount(); ++l) {
+        unsigned firstColumn, lastColumn, firstRow, lastRow;
+        visibleTiles(l, area, firstColumn, lastColumn, firstRow, lastRow);
+        for (unsigned row = firstRow; row <= lastRow; ++row) {
+            for (unsigned column = firstColumn; column <= lastColumn; ++column) {
+                auto it = tiles.find(key(l, column, row));
+                if (it != tiles.end())
+                    it->second->lastUsed = frame;
+                else if (l == level)
+                    wanted.push_back({ column, row, 0.0f });
+            }
+        }
+    }
+
+    // Middle of the screen first; the edges can take a frame or two longer
+    if (!wanted.empty()) {
+        sf::Vector2f scale = levelScale(level);
+        float tileSize = static_cast<float>(image->getTileSize());
+        for (Wanted& tile : wanted) {
+            float dx = (tile.column + 0.5f) * tileSize * scale.x - center.x;
+            float dy = (tile.row + 0.5f) * tileSize * scale.y - center.y;
+            tile.distance = dx * dx + dy * dy;
+        }
+        std::sort(wanted.begin(), wanted.end(), [](const Wanted& a, const Wanted& b) {
+            return a.distance < b.distance;
+        });
+        for (std::size_t i = 0; i < wanted.size() && loading < maxLoading; ++i)
+            request(level, wanted[i].column, wanted[i].row);
+        wanted.clear();
+    }
+
+    evict();
+}
+
+void TiledImageView::draw(sf::RenderTarget& target) {
+    if (!image) return;
+
+    sf::View saved = target.getView();
+    sf::Vector2u targetSize = target.getSize();
+    target.setView(sf::View(center, sf::Vector2f(targetSize.x / zoom, targetSize.y / zoom)));
+
+    // Coarse to fine, so each level paints over the blurrier one under it
+    std::size_t level = levelForZoom();
+    sf::FloatRect area = visibleArea(targetSize);
+    float tileSize = static_cast<float>(image->getTileSize());
+    for (std::size_t l = image->getLevelCount(); l-- > level;) {
+        sf::Vector2f scale = levelScale(l);
+        unsigned firstColumn, lastColumn, firstRow, lastRow;
+        visibleTiles(l, area, firstColumn, lastColumn, firstRow, lastRow);
+        for (unsigned row = firstRow; row <= lastRow; ++row) {
+            for (unsigned column = firstColumn; column <= lastColumn; ++column) {
+                auto it = tiles.find(key(l, column, row));
+                if (it == tiles.end() || !it->second->ready)
+                    continue;
+
+                sf::Vector2u offset = image->getTileOffset(column, row);
+                sf::Vector2u pixels = image->getTilePixels(l, column, row);
+                sprite.setTexture(it->second->texture);
+                sprite.setTextureRect(sf::IntRect(offset.x, offset.y, pixels.x, pixels.y));
+                sprite.setPosition(column * tileSize * scale.x, row * tileSize * scale.y);
+                sprite.setScale(scale);
+                target.draw(sprite);
+                PROFILE_DRAW(sprite);
+            }
+        }
+    }
+
+    target.setView(saved);
+}
+
+std::size_t TiledImageView::getResidentTiles() const {
+    return tiles.size() - loading;
+}
+
+std::size_t TiledImageView::getLoadingTiles() const {
+    return loading;
+}
+
+// The finest level that doesn't have more pixels than the screen can show
+std::size_t TiledImageView::levelForZoom() const {
+    std::size_t level = 0;
+    while (level + 1 < image->getLevelCount() && zoom * levelScale(level + 1).x <= 1.0f)
+        ++level;
+    return level;
+}
+
+sf::FloatRect TiledImageView::visibleArea(const sf::Vector2u& targetSize) const {
+    sf::Vector2f half(targetSize.x / zoom / 2.0f, targetSize.y / zoom / 2.0f);
+    return sf::FloatRect(center - half, half * 2.0f);
+}
+
+sf::Vector2f TiledImageView::levelScale(std::size_t level) const {
+    sf::Vector2u full = image->getSize();
+    sf::Vector2u size = image->getLevel(level).size;
+    return sf::Vector2f(static_cast<float>(full.x) / size.x, static_cast<float>(full.y) / size.y);
+}
+
+void TiledImageView::visibleTiles(std::size_t level, const sf::FloatRect& area,
+    unsigned& firstColumn, unsigned& lastColumn, unsigned& firstRow, unsigned& lastRow) const {
+    const TiledLevel& info = image->getLevel(level);
+    sf::Vector2f scale = levelScale(level);
+    float tileWidth = image->getTileSize() * scale.x;
+    float tileHeight = image->getTileSize() * scale.y;
+
+    auto clamp = [](float value, unsigned count) {
+        return static_cast<unsigned>(std::min(std::max(value, 0.0f), static_cast<float>(count - 1)));
+    };
+    firstColumn = clamp(std::floor(area.left / tileWidth), info.columns);
+    lastColumn = clamp(std::floor((area.left + area.width) / tileWidth), info.columns);
+    firstRow = clamp(std::floor(area.top / tileHeight), info.rows);
+    lastRow = clamp(std::floor((area.top + area.height) / tileHeight), info.rows);
+}
+
+std::uint64_t TiledImageView::key(std::size_t level, unsigned column, unsigned row) {
+    return (static_cast<std::uint64_t>(level) << 48) | (static_cast<std::uint64_t>(row) << 24) | column;
+}
+
+void TiledImageView::request(std::size_t level, unsigned column, unsigned row) {
+    std::uint64_t tileKey = key(level, column, row);
+    auto tile = std::make_unique<Tile>();
+    tile->lastUsed = frame;
+    tiles[tileKey] = std::move(tile);
+    ++loading;
+
+    JobSystem& jobs = JobSystem::getInstance();
+    std::shared_ptr<const TiledImage> source = image;
+    auto pixels = std::make_shared<sf::Image>();
+    auto decoded = std::make_shared<bool>(false);
+    unsigned requestGeneration = generation;
+
+    JobHandle decode = jobs.submit("decode tile", [source, pixels, decoded, level, column, row]() {
+        *decoded = source->loadTile(level, column, row, *pixels);
+    });
+
+    // GL work has to happen on the main thread
+    jobs.submitMain("upload tile", [this, pixels, decoded, tileKey, requestGeneration]() {
+        if (requestGeneration != generation)
+            return;     // Closed or reopened since; the tile table is gone
+        auto it = tiles.find(tileKey);
+        if (it == tiles.end())
+            return;
+        --loading;
+        Tile& tile = *it->second;
+        tile.loading = false;
+
+        // A tile that fails stays in the table not ready, so it isn't asked for
+        // again every frame; the coarser level keeps covering for it
+        PROFILE_COUNT(TextureUploads);
+        if (*decoded && tile.texture.loadFromImage(*pixels)) {
+            tile.texture.setSmooth(true);
+            tile.texture.generateMipmap();  // Zoom sits between two levels most of the time
+            tile.ready = true;
+        }
+    }, { decode });
+}
+
+// Least recently visible first; the one-tile top level and anything still loading stay
+void TiledImageView::evict() {
+    std::uint64_t topKey = key(image->getLevelCount() - 1, 0, 0);
+    while (tiles.size() > maxTiles) {
+        auto victim = tiles.end();
+        for (auto it = tiles.begin(); it != tiles.end(); ++it) {
+            if (it->first == topKey || it->second->loading || it->second->lastUsed == frame)
+                continue;
+            if (victim == tiles.end() || it->second->lastUsed < victim->second->lastUsed)
+                victim = it;
+        }
+        if (victim == tiles.end())
+            return;     // Everything left is on screen
+        tiles.erase(victim);
+    }
+}
@@ -0,0 +1,78 @@
+#ifndef TILEDIMAGEVIEW_HPP
+#define TILEDIMAGEVIEW_HPP
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "TiledImage.h"
+
+// Draws a TiledImage at any pan and zoom. Only the tiles on screen are loaded, from
+// the level whose detail matches the zoom: workers decode them and the uploads go
+// through the main-thread job budget, so a frame costs about the same however big
+// the source is. Until a tile arrives, the coarser levels underneath show through.
+// Main thread only.
+class TiledImageView {
+public:
+    // Loads the smallest level (a single tile) before returning, so there is always
+    // something to draw
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const;
+    sf::Vector2f getImageSize() const;
+
+    // center: the image pixel shown in the middle of the target
+    // zoom: screen pixels per full-resolution image pixel
+    void setCamera(const sf::Vector2f& center, float zoom);
+    const sf::Vector2f& getCenter() const;
+    float getZoom() const;
+    float getFitZoom(const sf::Vector2u& targetSize) const;    // Whole image on screen
+
+    void update(const sf::Vector2u& targetSize);    // Asks for the visible tiles it lacks
+    void draw(sf::RenderTarget& target);
+
+    std::size_t getResidentTiles() const;
+    std::size_t getLoadingTiles() const;
+
+private:
+    struct Tile {
+        sf::Texture texture;
+        std::uint64_t lastUsed = 0;
+        bool loading = true;
+        bool ready = false;
+    };
+
+    // A visible tile that isn't loaded yet, and how far it is from the middle
+    struct Wanted {
+        unsigned column;
+        unsigned row;
+        float distance;
+    };
+
+    std::size_t levelForZoom() const;
+    sf::FloatRect visibleArea(const sf::Vector2u& targetSize) const;
+    sf::Vector2f levelScale(std::size_t level) const;   // Image pixels per level pixel
+    void visibleTiles(std::size_t level, const sf::FloatRect& area,
+        unsigned& firstColumn, unsigned& lastColumn, unsigned& firstRow, unsigned& lastRow) const;
+    static std::uint64_t key(std::size_t level, unsigned column, unsigned row);
+    void request(std::size_t level, unsigned column, unsigned row);
+    void evict();
+
+    std::shared_ptr<const TiledImage> image;    // Shared with the decode jobs
+    std::unordered_map<std::uint64_t, std::unique_ptr<Tile>> tiles;
+    std::vector<Wanted> wanted;                 // Reused every update
+    sf::Sprite sprite;
+
+    sf::Vector2f center;
+    float zoom = 1.0f;
+    std::uint64_t frame = 0;
+    std::size_t loading = 0;
+    unsigned generation = 0;    // Uploads from before the last open/close are dropped
+
+    const std::size_t maxTiles = 96;    // About 25 MB of 256-pixel tiles
+    const std::size_t maxLoading = 8;   // In flight at once, so new requests stay current
+};
+
+#endif // TILEDIMAGEVIEW_HPP
@@ -0,0 +1,125 @@
+#include "Timeline.h"
+#include <algorithm>
+
+namespace {
+    float smoothstep(float t) {
+        return t * t * (3.0f - 2.0f * t);
+    }
+
+    // The channel a key's value goes to; CAMERA keys feed five of them
+    float channelValue(const TimelineKey& key, int channel) {
+        switch (channel) {
+        case Timeline::FADE: return key.value;
+        case Timeline::PAN_X: return key.camera.pan.x;
+        case Timeline::PAN_Y: return key.camera.pan.y;
+        case Timeline::ZOOM: return key.camera.zoom;
+        case Timeline::ROTATION: return key.camera.rotation;
+        default: return key.camera.shake;
+        }
+    }
+
+    bool feedsChannel(TimelineTrack track, int channel) {
+        return channel == Timeline::FADE ? track == TimelineTrack::FADE : track == TimelineTrack::CAMERA;
+    }
+}
+
+void Timeline::build(const std::string& timelineId, const std::vector<TimelineKey>& keys) {
+    id = timelineId;
+    duration = 0.0f;
+    eventTimes.clear();
+    eventTracks.clear();
+    eventValues.clear();
+    eventArguments.clear();
+    arguments.clear();
+    keyTimes.clear();
+    keyValues.clear();
+
+    // Stable, so keys at the same time keep the order the script gave them
+    order.resize(keys.size());
+    for (std::size_t i = 0; i < keys.size(); ++i)
+        order[i] = static_cast<std::uint32_t>(i);
+    std::stable_sort(order.begin(), order.end(), [&keys](std::uint32_t a, std::uint32_t b) {
+        return keys[a].time < keys[b].time;
+    });
+
+    for (std::uint32_t i : order) {
+        const TimelineKey& key = keys[i];
+        duration = std::max(duration, key.time);
+        if (key.track == TimelineTrack::CAMERA || key.track == TimelineTrack::FADE)
+            continue;
+        eventTimes.push_back(key.time);
+        eventTracks.push_back(key.track);
+        eventValues.push_back(key.value);
+        eventArguments.push_back(static_cast<std::uint32_t>(arguments.size()));
+        arguments.push_back(key.argument);
+    }
+
+    for (int channel = 0; channel < channelCount; ++channel) {
+        channelStart[channel] = static_cast<std::uint32_t>(keyTimes.size());
+        for (std::uint32_t i : order) {
+            if (!feedsChannel(keys[i].track, channel))
+                continue;
+            keyTimes.push_back(keys[i].time);
+            keyValues.push_back(channelValue(keys[i], channel));
+        }
+    }
+    channelStart[channelCount] = static_cast<std::uint32_t>(keyTimes.size());
+}
+
+const std::string& Timeline::getId() const {
+    return id;
+}
+
+float Timeline::getDuration() const {
+    return duration;
+}
+
+bool Timeline::hasChannel(Channel channel) const {
+    return channelStart[channel] != channelStart[channel + 1];
+}
+
+std::size_t Timeline::getEventCount() const {
+    return eventTimes.size();
+}
+
+float Timeline::getEventTime(std::size_t event) const {
+    return eventTimes[event];
+}
+
+TimelineTrack Timeline::getEventTrack(std::size_t event) const {
+    return eventTracks[event];
+}
+
+const std::string& Timeline::getEventArgument(std::size_t event) const {
+    return arguments[eventArguments[event]];
+}
+
+float Timeline::getEventValue(std::size_t event) const {
+    return eventValues[event];
+}
+
+void Timeline::sample(float time, Cursor& cursor, float* values) const {
+    for (int channel = 0; channel < channelCount; ++channel) {
+        std::uint32_t first = channelStart[channel];
+        std::uint32_t end = channelStart[channel + 1];
+        if (first == end)
+            continue;
+
+        // First sample, or the time went back: start the walk over
+        std::uint32_t k = cursor.key[channel];
+        if (k < first || k >= end || keyTimes[k] > time)
+            k = first;
+        while (k + 1 < end && keyTimes[k + 1] <= time)
+            ++k;
+        cursor.key[channel] = k;
+
+        // Before the first key and after the last, the value holds
+        if (k + 1 == end || time <= keyTimes[k]) {
+            values[channel] = keyValues[k];
+        }
+        else {
+            float t = smoothstep((time - keyTimes[k]) / (keyTimes[k + 1] - keyTimes[k]));
+            values[channel] = keyValues[k] + (keyValues[k + 1] - keyValues[k]) * t;
+        }
+    }
+}
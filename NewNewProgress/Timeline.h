@@ -0,0 +1,79 @@
+#ifndef TIMELINE_HPP
+#define TIMELINE_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Camera.h"
+
+// What a timeline key drives
+enum class TimelineTrack : std::uint8_t {
+    BACKGROUND,     // argument: image or "#rrggbb" (list images in the node's preloadBackgrounds);
+                    // value: seconds to crossfade over, 0 to cut
+    PORTRAIT,       // argument: character; value: 1, 2 or 3 brings them on (or moves them) to the
+                    // left, middle or right slot, 0 takes them off
+    CAMERA,         // camera: pose, eased towards from the key before
+    SOUND,          // argument: sound name (see ScriptNode::sounds)
+    FADE,           // value: black over the screen, 0 clear to 1 opaque, eased between keys
+    TEXT            // argument: caption across the top of the screen; "" clears it
+};
+
+// One key as the script writes it
+struct TimelineKey {
+    float time;     // Seconds from the start of the timeline
+    TimelineTrack track;
+    std::string argument;
+    float value;
+    CameraPose camera;
+};
+
+// A timeline compiled for playback, with its keys split into parallel arrays by
+// kind. One-off events (background, portrait, sound, text) are sorted by time and
+// fired as the playhead passes them. The eased values (the fade and each part of
+// the camera pose) are channels, each a contiguous run of times and values, so a
+// frame's evaluation is one forward walk over a few small float arrays.
+class Timeline {
+public:
+    enum Channel { FADE, PAN_X, PAN_Y, ZOOM, ROTATION, SHAKE, channelCount };
+
+    // Where playback has got to. Only ever moves forward unless the time goes back.
+    struct Cursor {
+        std::size_t event = 0;                  // Next event to fire
+        std::uint32_t key[channelCount] = {};   // Per channel, the key at or before the time
+    };
+
+    // Keys can come in any order. The arrays keep their capacity from the last build.
+    void build(const std::string& id, const std::vector<TimelineKey>& keys);
+
+    const std::string& getId() const;
+    float getDuration() const;      // Time of the last key
+    bool hasChannel(Channel channel) const;
+
+    std::size_t getEventCount() const;
+    float getEventTime(std::size_t event) const;
+    TimelineTrack getEventTrack(std::size_t event) const;
+    const std::string& getEventArgument(std::size_t event) const;
+    float getEventValue(std::size_t event) const;
+
+    // Every channel's value at time into values (channelCount of them). Channels
+    // with no keys are left as they were.
+    void sample(float time, Cursor& cursor, float* values) const;
+
+private:
+    std::string id;
+    float duration = 0.0f;
+
+    std::vector<float> eventTimes;
+    std::vector<TimelineTrack> eventTracks;
+    std::vector<float> eventValues;
+    std::vector<std::uint32_t> eventArguments;  // Index into arguments
+    std::vector<std::string> arguments;
+
+    std::vector<float> keyTimes;
+    std::vector<float> keyValues;
+    std::uint32_t channelStart[channelCount + 1] = {};  // Channel c is keys channelStart[c] to channelStart[c + 1]
+
+    std::vector<std::uint32_t> order;   // Keys sorted by time, reused by build
+};
+
+#endif // TIMELINE_HPP
@@ -0,0 +1,156 @@
+#include "TimelinePlayer.h"
+#include "Profiler.h"
+#include "Tracer.h"
+#include <algorithm>
+
+TimelinePlayer::TimelinePlayer(sf::RenderTarget& target, sf::Font& font, BackgroundManager& background,
+    PortraitStage& stage, Camera& camera, SoundManager& sounds)
+    : target(target), background(background), stage(stage), camera(camera), sounds(sounds) {
+    caption.setFont(font);
+    caption.setCharacterSize(26);
+    caption.setFillColor(sf::Color(230, 230, 230));
+    caption.setOutlineColor(sf::Color::Black);
+    caption.setOutlineThickness(2.0f);
+}
+
+void TimelinePlayer::play(const std::string& id, const std::vector<TimelineKey>& keys, float startTime) {
+    TRACE_SCOPE("TimelinePlayer::play");
+    stop();
+    timeline.build(id, keys);
+    cursor = Timeline::Cursor();
+    time = std::max(startTime, 0.0f);
+    playing = true;
+    drivesCamera = timeline.hasChannel(Timeline::PAN_X);
+
+    advance(time, time > 0.0f ? Firing::SEEK : Firing::PLAY);
+    if (time >= timeline.getDuration())
+        finish();
+}
+
+void TimelinePlayer::skip() {
+    if (!playing) return;
+    advance(timeline.getDuration(), Firing::SKIP);
+    stop();
+}
+
+void TimelinePlayer::stop() {
+    for (std::size_t event : soundsStarted)
+        sounds.stopSound(timeline.getEventArgument(event));
+    finish();
+}
+
+void TimelinePlayer::releaseCamera() {
+    drivesCamera = false;
+}
+
+void TimelinePlayer::update(float deltaTime) {
+    if (!playing) return;
+    time += deltaTime;
+    advance(time, Firing::PLAY);
+    if (time >= timeline.getDuration())
+        finish();
+}
+
+void TimelinePlayer::draw() {
+    if (!hasCaption) return;
+    target.draw(caption);
+    PROFILE_DRAW(caption);
+}
+
+bool TimelinePlayer::isPlaying() const {
+    return playing;
+}
+
+const std::string& TimelinePlayer::getId() const {
+    return timeline.getId();
+}
+
+float TimelinePlayer::getTime() const {
+    return time;
+}
+
+std::size_t TimelinePlayer::getEventsFired() const {
+    return eventsFired;
+}
+
+// Fires the events up to time, then sets the fade and camera from the channels
+void TimelinePlayer::advance(float until, Firing firing) {
+    while (cursor.event < timeline.getEventCount() && timeline.getEventTime(cursor.event) <= until)
+        fire(cursor.event++, firing);
+
+    if (!timeline.hasChannel(Timeline::FADE) && !drivesCamera)
+        return;
+
+    CameraPose pose = camera.getPose();
+    values[Timeline::FADE] = 0.0f;
+    values[Timeline::PAN_X] = pose.pan.x;
+    values[Timeline::PAN_Y] = pose.pan.y;
+    values[Timeline::ZOOM] = pose.zoom;
+    values[Timeline::ROTATION] = pose.rotation;
+    values[Timeline::SHAKE] = pose.shake;
+    timeline.sample(until, cursor, values);
+
+    if (timeline.hasChannel(Timeline::FADE))
+        background.setFadeAmount(values[Timeline::FADE]);
+    if (drivesCamera) {
+        pose.pan = sf::Vector2f(values[Timeline::PAN_X], values[Timeline::PAN_Y]);
+        pose.zoom = values[Timeline::ZOOM];
+        pose.rotation = values[Timeline::ROTATION];
+        pose.shake = values[Timeline::SHAKE];
+        camera.setPose(pose);
+    }
+}
+
+void TimelinePlayer::fire(std::size_t event, Firing firing) {
+    ++eventsFired;
+    const std::string& argument = timeline.getEventArgument(event);
+    switch (timeline.getEventTrack(event)) {
+    case TimelineTrack::BACKGROUND:
+        // Only a timeline playing in real time blends; catching up or skipping cuts
+        if (firing == Firing::PLAY)
+            background.transitionTo(argument, { TransitionType::CROSSFADE, timeline.getEventValue(event) });
+        else
+            background.setBackground(argument);
+        break;
+    case TimelineTrack::PORTRAIT: {
+        // Catching up or skipping puts everyone straight where they end up
+        StageDirection direction;
+        int slot = static_cast<int>(timeline.getEventValue(event) + 0.5f);
+        direction.exit = slot <= 0;
+        direction.slot = slot == 1 ? StageSlot::LEFT : slot == 3 ? StageSlot::RIGHT : StageSlot::CENTER;
+        direction.motion = firing == Firing::PLAY ? StageMotion::FADE : StageMotion::CUT;
+        stage.direct(argument, direction);
+        break;
+    }
+    case TimelineTrack::SOUND:
+        // A skipped timeline stays quiet; a resumed one picks up sounds that are still going
+        if (firing == Firing::PLAY) {
+            sounds.playSound(argument);
+            soundsStarted.push_back(event);
+        }
+        else if (firing == Firing::SEEK && sounds.playSoundFrom(argument, time - timeline.getEventTime(event))) {
+            soundsStarted.push_back(event);
+        }
+        break;
+    case TimelineTrack::TEXT:
+        setCaption(argument);
+        break;
+    default:
+        break;
+    }
+}
+
+void TimelinePlayer::finish() {
+    playing = false;
+    soundsStarted.clear();
+    if (hasCaption)
+        setCaption("");
+}
+
+void TimelinePlayer::setCaption(const std::string& text) {
+    hasCaption = !text.empty();
+    caption.setString(sf::String::fromUtf8(text.begin(), text.end()));
+    sf::FloatRect bounds = caption.getLocalBounds();
+    caption.setOrigin(bounds.left + bounds.width / 2.0f, bounds.top);
+    caption.setPosition(target.getDefaultView().getSize().x / 2.0f, 40.0f);
+}
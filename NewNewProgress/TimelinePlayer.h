@@ -0,0 +1,62 @@
+#ifndef TIMELINEPLAYER_HPP
+#define TIMELINEPLAYER_HPP
+
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+#include "Timeline.h"
+#include "BackgroundManager.h"
+#include "PortraitStage.h"
+#include "Camera.h"
+#include "SoundManager.h"
+
+// Plays one timeline at a time on the gameplay systems, alongside the dialogue:
+// lines keep advancing while it runs. StoryPlayer starts timelines from TIMELINE
+// cues; the game can skip one, and saves record where it had got to.
+class TimelinePlayer {
+public:
+    TimelinePlayer(sf::RenderTarget& target, sf::Font& font, BackgroundManager& background,
+        PortraitStage& stage, Camera& camera, SoundManager& sounds);
+
+    // Replaces whatever was playing. Starting part-way applies what the earlier keys
+    // did at once, and sounds still within their length pick up part-way through.
+    void play(const std::string& id, const std::vector<TimelineKey>& keys, float startTime = 0.0f);
+    void skip();            // Straight to how the timeline ends, without its sounds
+    void stop();            // Ends it where it is
+    void releaseCamera();   // A CAMERA cue takes the camera back for the rest of the timeline
+    void update(float deltaTime);
+    void draw();            // The caption, in screen space
+
+    bool isPlaying() const;
+    const std::string& getId() const;
+    float getTime() const;
+    std::size_t getEventsFired() const;     // Since construction
+
+private:
+    enum class Firing { PLAY, SEEK, SKIP };
+
+    void advance(float time, Firing firing);
+    void fire(std::size_t event, Firing firing);
+    void finish();
+    void setCaption(const std::string& text);
+
+    sf::RenderTarget& target;
+    BackgroundManager& background;
+    PortraitStage& stage;
+    Camera& camera;
+    SoundManager& sounds;
+
+    Timeline timeline;
+    Timeline::Cursor cursor;
+    float values[Timeline::channelCount];
+    std::vector<std::size_t> soundsStarted;     // Events, so a stop can silence them
+    sf::Text caption;
+    bool hasCaption = false;
+
+    float time = 0.0f;
+    bool playing = false;
+    bool drivesCamera = false;
+    std::size_t eventsFired = 0;
+};
+
+#endif // TIMELINEPLAYER_HPP
@@ -1,130 +1,100 @@
-﻿#include "TitleScreen.h"
-#include <cmath>
-#include <iostream>
-
-// Constructor to initialize assets and layout
-TitleScreen::TitleScreen(sf::RenderWindow& win, sf::Font& titleFont, sf::Font& bodyFont, SoundManager& soundManager)
-    : window(win), titleFont(titleFont), bodyFont(bodyFont), soundManager(soundManager)
-{
-    backgroundTexture.loadFromFile("Frontpage.png");
-    background.setTexture(backgroundTexture);
-
-    float scaleX = static_cast<float>(window.getSize().x) / backgroundTexture.getSize().x;
-    float scaleY = static_cast<float>(window.getSize().y) / backgroundTexture.getSize().y;
-    background.setScale(scaleX, scaleY);
-
-    // Load Baybayin button images
-    playTexture.loadFromFile("start200.png");
-    loadTexture.loadFromFile("load200.png");
-    aboutTexture.loadFromFile("gabay200.png");
-    quitTexture.loadFromFile("labasan200.png");
-
-    playSprite.setTexture(playTexture);
-    loadSprite.setTexture(loadTexture);
-    aboutSprite.setTexture(aboutTexture);
-    quitSprite.setTexture(quitTexture);
-
-    // Scale down
-    float targetWidth = 130.f;
-    float scalePlay = targetWidth / playTexture.getSize().x;
-    float scaleLoad = 1.3f * targetWidth / loadTexture.getSize().x;
-    //float scaleLoad = targetWidth / loadTexture.getSize().x;
-    float scaleAbout = targetWidth / aboutTexture.getSize().x;
-    float scaleQuit = targetWidth / quitTexture.getSize().x;
-
-    playSprite.setScale(scalePlay, scalePlay);
-    loadSprite.setScale(scaleLoad, scaleLoad);
-    aboutSprite.setScale(scaleAbout, scaleAbout);
-    quitSprite.setScale(scaleQuit, scaleQuit);
-
-    // 🔄 Center origin of each sprite (so we can align center to circles)
-    playSprite.setOrigin(playTexture.getSize().x / 2, playTexture.getSize().y / 2);
-    loadSprite.setOrigin(loadTexture.getSize().x / 2, loadTexture.getSize().y / 2);
-    aboutSprite.setOrigin(aboutTexture.getSize().x / 2, aboutTexture.getSize().y / 2);
-    quitSprite.setOrigin(quitTexture.getSize().x / 2, quitTexture.getSize().y / 2);
-
-    // 🔧 Position aligned with circles
-    float xCenter = 1260; // Align center X with glowing dots
-    float yStart = 160;   // First circle center Y
-    float spacing = 120;  // Distance between dots
-
-    playSprite.setPosition(1180, 156);  // Simula
-    loadSprite.setPosition(1200, 250);  // Buhayin ang Alaala
-    aboutSprite.setPosition(1180, 340); // Gabay
-    quitSprite.setPosition(1180, 430);  // Labasan
-}
-
-TitleScreen::GameState TitleScreen::run() {
-    sf::Clock clock;
-    soundManager.playMusic("BeginM.ogg", true);
-
-    while (window.isOpen()) {
-        GameState state = handleEvents();
-        if (state != GameState::TITLE) return state;
-
-        float time = clock.getElapsedTime().asSeconds();
-        animateTitles(time);
-
-        draw();
-    }
-
-    return GameState::QUIT;
-}
-
-void TitleScreen::handleMouseHover(const sf::Vector2f& mousePos) {
-    auto handleHover = [&](sf::Sprite& sprite) {
-        if (sprite.getGlobalBounds().contains(mousePos))
-            sprite.setColor(sf::Color(255, 100, 100));  // reddish hover
-        else
-            sprite.setColor(sf::Color::White);
-        };
-
-    handleHover(playSprite);
-    handleHover(loadSprite);
-    handleHover(aboutSprite);
-    handleHover(quitSprite);
-}
-
-TitleScreen::GameState TitleScreen::handleEvents() {
-    sf::Event event;
-    while (window.pollEvent(event)) {
-        if (event.type == sf::Event::Closed)
-            window.close();
-
-        if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
-            sf::Vector2f mousePos = window.mapPixelToCoords(sf::Mouse::getPosition(window));
-
-            if (playSprite.getGlobalBounds().contains(mousePos)) {
-                soundManager.stopMusic();
-                return GameState::GAMEPLAY;
-            }
-            if (loadSprite.getGlobalBounds().contains(mousePos))
-                return GameState::LOAD;
-            if (aboutSprite.getGlobalBounds().contains(mousePos))
-                return GameState::ABOUT;
-            if (quitSprite.getGlobalBounds().contains(mousePos)) {
-                window.close();
-                return GameState::QUIT;
-            }
-        }
-    }
-
-    sf::Vector2f mousePos = window.mapPixelToCoords(sf::Mouse::getPosition(window));
-    handleMouseHover(mousePos);
-
-    return GameState::TITLE;
-}
-
-void TitleScreen::animateTitles(float time) {
-    // Optional animations if you ever bring text back
-}
-
-void TitleScreen::draw() {
-    window.clear();
-    window.draw(background);
-    window.draw(playSprite);
-    window.draw(loadSprite);
-    window.draw(aboutSprite);
-    window.draw(quitSprite);
-    window.display();
+﻿#include "TitleScreen.h"
+#include "Game.h"
+#include "Profiler.h"
+#include "TextureCache.h"
+#include <cmath>
+#include <iostream>
+
+// Constructor to initialize the layout; textures are picked up in onEnter
+TitleScreen::TitleScreen(sf::RenderWindow& win, sf::Font& titleFont, sf::Font& bodyFont, SoundManager& soundManager, Game& game)
+    : window(win), titleFont(titleFont), bodyFont(bodyFont), soundManager(soundManager), game(game), ui(win)
+{
+    // Reddish on hover
+    ButtonStyle normal;
+    ButtonStyle hover;
+    hover.content = sf::Color(255, 100, 100);
+    for (SpriteButton* button : { &playSprite, &loadSprite, &aboutSprite, &quitSprite }) {
+        button->setStyles(normal, hover);
+        ui.add(*button);
+    }
+
+    playSprite.onClick = [this]() {
+        this->soundManager.stopMusic();
+        this->game.changeState(GameState::INTRO);
+    };
+    loadSprite.onClick = [this]() { this->game.changeState(GameState::LOAD); };
+    aboutSprite.onClick = [this]() { this->game.changeState(GameState::ABOUT); };
+    quitSprite.onClick = [this]() { this->game.changeState(GameState::QUIT); };
+}
+
+void TitleScreen::onEnter() {
+    elapsed = 0.0f;
+    soundManager.playMusic("BeginM.ogg", true);
+    loadTextures();
+    ui.syncPointer(sf::Mouse::getPosition(window));
+}
+
+// Nothing here is on screen during the game, so let the cache evict it
+void TitleScreen::onExit() {
+    backgroundTexture.reset();
+    playTexture.reset();
+    loadTexture.reset();
+    aboutTexture.reset();
+    quitTexture.reset();
+}
+
+void TitleScreen::onResize() {
+    loadTextures();
+}
+
+// Scales come from each texture's own size, so a reduced tier lays out the same.
+// The background is resampled to the window's pixels; the buttons are small enough as they are.
+void TitleScreen::loadTextures() {
+    TextureCache& cache = TextureCache::getInstance();
+    backgroundTexture = cache.get(TextureCache::fittedKey("Frontpage.png", window.getSize(), FitMode::STRETCH));
+    if (backgroundTexture) {
+        background.setTexture(*backgroundTexture, true);
+        float scaleX = window.getDefaultView().getSize().x / backgroundTexture->getSize().x;
+        float scaleY = window.getDefaultView().getSize().y / backgroundTexture->getSize().y;
+        background.setScale(scaleX, scaleY);
+    }
+
+    // Load Baybayin button images
+    playTexture = cache.get("start200.png");
+    loadTexture = cache.get("load200.png");
+    aboutTexture = cache.get("gabay200.png");
+    quitTexture = cache.get("labasan200.png");
+
+    // Scale down, centred on the glowing circles
+    float targetWidth = 130.f;
+    auto setUp = [targetWidth](SpriteButton& button, const std::shared_ptr<const sf::Texture>& texture,
+        const sf::Vector2f& center, float widthFactor) {
+        if (texture)
+            button.setTexture(*texture, center, widthFactor * targetWidth);
+        };
+
+    setUp(playSprite, playTexture, sf::Vector2f(1180, 156), 1.0f);     // Simula
+    setUp(loadSprite, loadTexture, sf::Vector2f(1200, 250), 1.3f);     // Buhayin ang Alaala
+    setUp(aboutSprite, aboutTexture, sf::Vector2f(1180, 340), 1.0f);   // Gabay
+    setUp(quitSprite, quitTexture, sf::Vector2f(1180, 430), 1.0f);     // Labasan
+}
+
+void TitleScreen::update(float deltaTime) {
+    elapsed += deltaTime;
+    animateTitles(elapsed);
+    ui.update();
+}
+
+void TitleScreen::handleEvent(const sf::Event& event) {
+    ui.handleEvent(event);
+}
+
+void TitleScreen::animateTitles(float time) {
+    // Optional animations if you ever bring text back
+}
+
+void TitleScreen::draw(sf::RenderTarget& target) {
+    target.draw(background);
+    PROFILE_DRAW(background);
+    ui.draw(target);
 }
\ No newline at end of file
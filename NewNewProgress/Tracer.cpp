@@ -0,0 +1,127 @@
+#include "Tracer.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+// Gives the thread's buffer back when the thread exits
+struct ThreadBufferOwner {
+    Tracer::ThreadBuffer* buffer = nullptr;
+
+    ~ThreadBufferOwner() {
+        if (buffer)
+            Tracer::getInstance().releaseBuffer(buffer);
+    }
+};
+
+namespace {
+    thread_local ThreadBufferOwner threadBuffer;
+
+    void writeJsonString(std::ostream& out, const char* text) {
+        out << '"';
+        for (const char* c = text; *c; ++c) {
+            if (*c == '"' || *c == '\\') out << '\\' << *c;
+            else if (static_cast<unsigned char>(*c) < 0x20) out << ' ';
+            else out << *c;
+        }
+        out << '"';
+    }
+}
+
+std::int64_t Tracer::now() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - startTime).count();
+}
+
+Tracer::ThreadBuffer& Tracer::localBuffer() {
+    if (threadBuffer.buffer)
+        return *threadBuffer.buffer;
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (const auto& buffer : buffers) {
+        if (!buffer->inUse) {
+            buffer->inUse = true;
+            threadBuffer.buffer = buffer.get();
+            return *buffer;
+        }
+    }
+
+    auto buffer = std::make_unique<ThreadBuffer>();
+    buffer->id = static_cast<unsigned>(buffers.size()) + 1;
+    buffer->name = "Thread " + std::to_string(buffer->id);
+    buffer->inUse = true;
+    threadBuffer.buffer = buffer.get();
+    buffers.push_back(std::move(buffer));
+    return *threadBuffer.buffer;
+}
+
+void Tracer::releaseBuffer(ThreadBuffer* buffer) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    buffer->inUse = false;
+}
+
+void Tracer::record(const char* name, const char* category, std::int64_t start, std::int64_t duration) {
+    ThreadBuffer& buffer = localBuffer();
+
+    // Only this thread writes here; the release store publishes the event to a dump
+    std::uint64_t index = buffer.written.load(std::memory_order_relaxed);
+    TraceEvent& event = buffer.events[index % bufferSize];
+    std::strncpy(event.name, name, sizeof(event.name) - 1);
+    event.name[sizeof(event.name) - 1] = '\0';
+    event.category = category;
+    event.start = start;
+    event.duration = duration;
+    buffer.written.store(index + 1, std::memory_order_release);
+}
+
+void Tracer::setThreadName(const std::string& name) {
+    ThreadBuffer& buffer = localBuffer();
+    std::lock_guard<std::mutex> lock(registryMutex);
+    buffer.name = name;
+}
+
+bool Tracer::writeChromeTrace(const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file) {
+        std::cerr << "Failed to write trace: " << filename << "\n";
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    bool first = true;
+    char number[64];
+    for (const auto& buffer : buffers) {
+        if (!first) file << ",\n";
+        first = false;
+        file << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << buffer->id << ",\"args\":{\"name\":";
+        writeJsonString(file, buffer->name.c_str());
+        file << "}}";
+
+        std::uint64_t written = buffer->written.load(std::memory_order_acquire);
+        std::uint64_t count = std::min<std::uint64_t>(written, bufferSize);
+        for (std::uint64_t i = written - count; i < written; ++i) {
+            // The owner keeps recording while we read, so copy the slot out and check
+            // afterwards that it wasn't reused: the event being written now has index
+            // 'written', which lands on our slot once it reaches i + bufferSize
+            TraceEvent event = buffer->events[i % bufferSize];
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (buffer->written.load(std::memory_order_relaxed) >= i + bufferSize)
+                continue;
+
+            file << ",\n{\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->id << ",\"name\":";
+            writeJsonString(file, event.name);
+            file << ",\"cat\":\"" << event.category << "\"";
+            // Chrome wants microseconds
+            std::snprintf(number, sizeof(number), ",\"ts\":%.3f,\"dur\":%.3f}",
+                event.start / 1000.0, event.duration / 1000.0);
+            file << number;
+        }
+    }
+
+    file << "\n]}\n";
+    std::cout << "Trace written to " << filename << "\n";
+    return true;
+}
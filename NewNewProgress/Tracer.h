@@ -0,0 +1,103 @@
+#ifndef TRACER_HPP
+#define TRACER_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "ProfileConfig.h"
+
+// One finished scope. The name is copied in so callers can pass temporaries (job names).
+struct TraceEvent {
+    char name[48];
+    const char* category;   // Must be a string literal
+    std::int64_t start;     // Nanoseconds since the tracer started
+    std::int64_t duration;
+};
+
+// Timeline recorder for Chrome's trace viewer / Perfetto. Each thread writes into its
+// own ring buffer without taking a lock; only the first event from a new thread
+// registers its buffer. A thread's buffer is handed on to the next new thread once it
+// exits (music streams get a fresh thread every time they play), so the events stay
+// in the dump. writeChromeTrace() collects every buffer into one JSON file.
+class Tracer {
+public:
+    static Tracer& getInstance() {
+        // Never destroyed: the audio streaming thread can still record while statics unwind
+        static Tracer* instance = new Tracer();
+        return *instance;
+    }
+
+    static const std::size_t bufferSize = 8192;     // Events kept per thread
+
+    std::int64_t now() const;
+    void record(const char* name, const char* category, std::int64_t start, std::int64_t duration);
+
+    // Shown as the track name in the viewer; call from the thread being named
+    void setThreadName(const std::string& name);
+
+    // Safe to call while other threads keep recording; events overwritten while the
+    // dump reads them are left out rather than written half-updated
+    bool writeChromeTrace(const std::string& filename);
+
+    // Prevent copying
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+private:
+    friend struct ThreadBufferOwner;
+
+    Tracer() = default;
+
+    struct ThreadBuffer {
+        unsigned id = 0;
+        std::string name;
+        bool inUse = false;
+        std::atomic<std::uint64_t> written{ 0 };    // Total events ever written
+        std::array<TraceEvent, bufferSize> events;
+    };
+
+    ThreadBuffer& localBuffer();
+    void releaseBuffer(ThreadBuffer* buffer);
+
+    std::mutex registryMutex;                       // Registration and dumping only
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+};
+
+// Records the enclosing block
+class TraceScope {
+public:
+    explicit TraceScope(const char* name, const char* category = "game")
+        : name(name), category(category), start(Tracer::getInstance().now()) {
+    }
+
+    ~TraceScope() {
+        Tracer& tracer = Tracer::getInstance();
+        tracer.record(name, category, start, tracer.now() - start);
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* name;
+    const char* category;
+    std::int64_t start;
+};
+
+#if BIRINGAN_PROFILE
+#define TRACE_SCOPE(name) TraceScope PROFILE_CONCAT(traceScope, __LINE__)(name)
+#define TRACE_SCOPE_CAT(name, category) TraceScope PROFILE_CONCAT(traceScope, __LINE__)(name, category)
+#define TRACE_THREAD_NAME(name) Tracer::getInstance().setThreadName(name)
+#else
+#define TRACE_SCOPE(name) ((void)0)
+#define TRACE_SCOPE_CAT(name, category) ((void)0)
+#define TRACE_THREAD_NAME(name) ((void)0)
+#endif
+
+#endif // TRACER_HPP
@@ -0,0 +1,371 @@
+#include "Widget.h"
+#include "WidgetLayer.h"
+#include "Profiler.h"
+
+Widget::Widget(bool interactive) : interactive(interactive) {
+}
+
+void Widget::setVisible(bool show) {
+    if (visible == show) return;
+    visible = show;
+    invalidate();
+}
+
+bool Widget::isVisible() const {
+    return visible;
+}
+
+const sf::FloatRect& Widget::getBounds() const {
+    return bounds;
+}
+
+void Widget::setBounds(const sf::FloatRect& area) {
+    if (area == bounds) return;
+    bounds = area;
+    invalidate();
+}
+
+bool Widget::contains(const sf::Vector2f& point) const {
+    return bounds.contains(point);
+}
+
+// Only the hit-testing grid cares where a widget is
+void Widget::invalidate() {
+    if (layer && interactive)
+        layer->invalidate();
+}
+
+// Label
+
+void Label::setup(const sf::Font& font, const sf::String& string, unsigned size, const sf::Color& color) {
+    text.setFont(font);
+    text.setString(string);
+    text.setCharacterSize(size);
+    text.setFillColor(color);
+}
+
+void Label::setString(const sf::String& string) {
+    text.setString(string);
+}
+
+void Label::setPosition(float x, float y) {
+    text.setPosition(x, y);
+}
+
+void Label::setColor(const sf::Color& color) {
+    text.setFillColor(color);
+}
+
+sf::Text& Label::getText() {
+    return text;
+}
+
+void Label::draw(sf::RenderTarget& target) {
+    target.draw(text);
+    PROFILE_DRAW(text);
+}
+
+// Panel
+
+void Panel::setup(const sf::FloatRect& area, const sf::Color& fill, const sf::Color& outline, float outlineThickness) {
+    shape.setPosition(area.left, area.top);
+    shape.setSize(sf::Vector2f(area.width, area.height));
+    shape.setFillColor(fill);
+    shape.setOutlineColor(outline);
+    shape.setOutlineThickness(outlineThickness);
+    setBounds(area);
+}
+
+void Panel::draw(sf::RenderTarget& target) {
+    target.draw(shape);
+    PROFILE_DRAW(shape);
+}
+
+// Button
+
+Button::Button() : Widget(true) {
+}
+
+void Button::setStyles(const ButtonStyle& normalStyle, const ButtonStyle& hoverStyle) {
+    setStyles(normalStyle, hoverStyle, normalStyle);
+}
+
+void Button::setStyles(const ButtonStyle& normalStyle, const ButtonStyle& hoverStyle, const ButtonStyle& selected) {
+    normal = normalStyle;
+    hover = hoverStyle;
+    selectedStyle = selected;
+    restyle();
+}
+
+void Button::setSelected(bool select) {
+    if (selected == select) return;
+    selected = select;
+    restyle();
+}
+
+bool Button::isSelected() const {
+    return selected;
+}
+
+void Button::hoverChanged(bool hover, const sf::Vector2f& point) {
+    hovered = hover;
+    restyle();
+}
+
+void Button::clicked(const sf::Vector2f& point) {
+    if (onClick) onClick();
+}
+
+void Button::restyle() {
+    applyStyle(hovered ? hover : selected ? selectedStyle : normal);
+}
+
+// TextButton
+
+void TextButton::setup(const sf::Font& font, const sf::String& string, unsigned size) {
+    text.setFont(font);
+    text.setString(string);
+    text.setCharacterSize(size);
+    restyle();
+}
+
+void TextButton::setPosition(float x, float y) {
+    hasBox = false;
+    text.setOrigin(0.0f, 0.0f);
+    text.setPosition(x, y);
+    setBounds(text.getGlobalBounds());
+}
+
+void TextButton::setBox(const sf::FloatRect& area, float outlineThickness) {
+    hasBox = true;
+    box.setPosition(area.left, area.top);
+    box.setSize(sf::Vector2f(area.width, area.height));
+    box.setOutlineThickness(outlineThickness);
+
+    sf::FloatRect textBounds = text.getLocalBounds();
+    text.setOrigin(textBounds.left + textBounds.width / 2.0f, textBounds.top + textBounds.height / 2.0f);
+    text.setPosition(area.left + area.width / 2.0f, area.top + area.height / 2.0f);
+    setBounds(area);
+}
+
+void TextButton::draw(sf::RenderTarget& target) {
+    if (hasBox) {
+        target.draw(box);
+        PROFILE_DRAW(box);
+    }
+    target.draw(text);
+    PROFILE_DRAW(text);
+}
+
+void TextButton::applyStyle(const ButtonStyle& style) {
+    box.setFillColor(style.fill);
+    box.setOutlineColor(style.outline);
+    text.setFillColor(style.content);
+}
+
+// SpriteButton
+
+void SpriteButton::setTexture(const sf::Texture& texture, const sf::Vector2f& center, float width) {
+    sprite.setTexture(texture, true);
+    float scale = width / texture.getSize().x;
+    sprite.setScale(scale, scale);
+    sprite.setOrigin(texture.getSize().x / 2.0f, texture.getSize().y / 2.0f);
+    sprite.setPosition(center);
+    setBounds(sprite.getGlobalBounds());
+    restyle();
+}
+
+void SpriteButton::draw(sf::RenderTarget& target) {
+    target.draw(sprite);
+    PROFILE_DRAW(sprite);
+}
+
+void SpriteButton::applyStyle(const ButtonStyle& style) {
+    sprite.setColor(style.content);
+}
+
+// ListBox
+
+const std::size_t ListBox::none;
+
+ListBox::ListBox() : Widget(true) {
+}
+
+void ListBox::setup(const sf::Font& listFont, unsigned size, const ButtonStyle& normalStyle, const ButtonStyle& hoverStyle) {
+    font = &listFont;
+    characterSize = size;
+    normal = normalStyle;
+    hover = hoverStyle;
+}
+
+void ListBox::setItems(const std::vector<sf::String>& items, const sf::Vector2f& center,
+    const sf::Vector2f& rowSize, float gap) {
+    count = items.size();
+    if (rows.size() < count)
+        rows.resize(count);
+    pitch = rowSize.y + gap;
+    rowHeight = rowSize.y;
+    hoveredRow = none;
+
+    float left = center.x - rowSize.x / 2.0f;
+    float top = center.y - count * pitch / 2.0f;
+    for (std::size_t i = 0; i < count; ++i) {
+        Row& row = rows[i];
+        row.box.setSize(rowSize);
+        row.box.setOutlineThickness(2.0f);
+        row.box.setPosition(left, top + i * pitch);
+
+        row.text.setFont(*font);
+        row.text.setString(items[i]);
+        row.text.setCharacterSize(characterSize);
+        sf::FloatRect textBounds = row.text.getLocalBounds();
+        row.text.setOrigin(textBounds.left + textBounds.width / 2.0f, textBounds.top + textBounds.height / 2.0f);
+        row.text.setPosition(left + rowSize.x / 2.0f, top + i * pitch + rowSize.y / 2.0f);
+        style(row, normal);
+    }
+
+    // The layer works out hover again once it has the new rows, even if they fill the same space
+    setBounds(sf::FloatRect(left, top, rowSize.x, count > 0 ? count * pitch - gap : 0.0f));
+    invalidate();
+}
+
+std::size_t ListBox::getCount() const {
+    return count;
+}
+
+void ListBox::draw(sf::RenderTarget& target) {
+    for (std::size_t i = 0; i < count; ++i) {
+        target.draw(rows[i].box);
+        PROFILE_DRAW(rows[i].box);
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        target.draw(rows[i].text);
+        PROFILE_DRAW(rows[i].text);
+    }
+}
+
+// The gaps between rows aren't part of the list
+bool ListBox::contains(const sf::Vector2f& point) const {
+    return getBounds().contains(point) && rowAt(point) != none;
+}
+
+void ListBox::hoverChanged(bool hovered, const sf::Vector2f& point) {
+    setHoveredRow(hovered ? rowAt(point) : none);
+}
+
+void ListBox::pointerMoved(const sf::Vector2f& point) {
+    setHoveredRow(rowAt(point));
+}
+
+void ListBox::clicked(const sf::Vector2f& point) {
+    std::size_t row = rowAt(point);
+    if (row != none && onSelect)
+        onSelect(row);
+}
+
+std::size_t ListBox::rowAt(const sf::Vector2f& point) const {
+    float offset = point.y - getBounds().top;
+    if (pitch <= 0.0f || offset < 0.0f)
+        return none;
+    std::size_t row = static_cast<std::size_t>(offset / pitch);
+    if (row >= count || offset - row * pitch > rowHeight)
+        return none;
+    return row;
+}
+
+void ListBox::setHoveredRow(std::size_t row) {
+    if (row == hoveredRow) return;
+    if (hoveredRow != none && hoveredRow < count)
+        style(rows[hoveredRow], normal);
+    hoveredRow = row;
+    if (hoveredRow != none)
+        style(rows[hoveredRow], hover);
+}
+
+void ListBox::style(Row& row, const ButtonStyle& look) {
+    row.box.setFillColor(look.fill);
+    row.box.setOutlineColor(look.outline);
+    row.text.setFillColor(look.content);
+}
+
+// TextField
+
+TextField::TextField() : Widget(true) {
+}
+
+void TextField::setup(const sf::Font& font, unsigned size, const sf::FloatRect& area, std::size_t length) {
+    maxLength = length;
+    box.setPosition(area.left, area.top);
+    box.setSize(sf::Vector2f(area.width, area.height));
+    box.setFillColor(sf::Color(0, 0, 0, 180));
+    box.setOutlineThickness(2.0f);
+
+    text.setFont(font);
+    text.setCharacterSize(size);
+    text.setFillColor(sf::Color::White);
+    text.setPosition(area.left + 12.0f, area.top + (area.height - size) / 2.0f - 4.0f);
+
+    caret.setSize(sf::Vector2f(2.0f, static_cast<float>(size)));
+    caret.setFillColor(sf::Color::White);
+
+    setBounds(area);
+    setFocused(focused);
+    placeCaret();
+}
+
+void TextField::setFocused(bool focus) {
+    focused = focus;
+    box.setOutlineColor(focused ? sf::Color(255, 220, 130) : sf::Color(120, 120, 120));
+}
+
+bool TextField::isFocused() const {
+    return focused;
+}
+
+const sf::String& TextField::getString() const {
+    return string;
+}
+
+void TextField::setString(const sf::String& value) {
+    string = value;
+    text.setString(string);
+    placeCaret();
+}
+
+bool TextField::type(sf::Uint32 character) {
+    if (character == '\b') {
+        if (string.isEmpty()) return false;
+        string.erase(string.getSize() - 1);
+    }
+    else if (character >= 32 && character != 127 && string.getSize() < maxLength) {
+        string += character;
+    }
+    else {
+        return false;
+    }
+    text.setString(string);
+    placeCaret();
+    return true;
+}
+
+void TextField::clicked(const sf::Vector2f& point) {
+    setFocused(true);
+    if (onFocus) onFocus();
+}
+
+// Just after the last character
+void TextField::placeCaret() {
+    sf::Vector2f end = text.findCharacterPos(string.getSize());
+    caret.setPosition(end.x + 1.0f, text.getPosition().y + 4.0f);
+}
+
+void TextField::draw(sf::RenderTarget& target) {
+    target.draw(box);
+    PROFILE_DRAW(box);
+    target.draw(text);
+    PROFILE_DRAW(text);
+    if (focused) {
+        target.draw(caret);
+        PROFILE_DRAW(caret);
+    }
+}
@@ -0,0 +1,201 @@
+#ifndef WIDGET_HPP
+#define WIDGET_HPP
+
+#include <SFML/Graphics.hpp>
+#include <functional>
+#include <vector>
+
+class WidgetLayer;
+
+// Something on a screen's UI: a label, a panel, a button or a list. Widgets are
+// retained: the screen sets them up once and changes them only when something
+// happens, and a WidgetLayer tells them when the cursor comes, goes or clicks.
+// Everything is in view units (the 1600x900 screen).
+class Widget {
+public:
+    virtual ~Widget() = default;
+
+    virtual void draw(sf::RenderTarget& target) = 0;
+
+    void setVisible(bool visible);
+    bool isVisible() const;
+    const sf::FloatRect& getBounds() const;
+
+protected:
+    friend class WidgetLayer;
+
+    // Only interactive widgets are hit-tested; labels and panels let clicks through
+    explicit Widget(bool interactive = false);
+    void setBounds(const sf::FloatRect& bounds);    // Where the widget can be hit
+    virtual bool contains(const sf::Vector2f& point) const;
+
+    // Called by the layer, only when something changes
+    virtual void hoverChanged(bool hovered, const sf::Vector2f& point) {}
+    virtual void pointerMoved(const sf::Vector2f& point) {}    // Within the widget, still hovered
+    virtual void clicked(const sf::Vector2f& point) {}         // Left button pressed over it
+
+    void invalidate();      // The layer has to look at the widget's bounds again
+
+    WidgetLayer* layer = nullptr;
+
+private:
+    sf::FloatRect bounds;
+    bool visible = true;
+    bool interactive;
+};
+
+// Text that's only read
+class Label : public Widget {
+public:
+    void setup(const sf::Font& font, const sf::String& string, unsigned size, const sf::Color& color);
+    void setString(const sf::String& string);
+    void setPosition(float x, float y);
+    void setColor(const sf::Color& color);
+    sf::Text& getText();    // For anything else sf::Text does (origin, outline)
+    void draw(sf::RenderTarget& target) override;
+
+private:
+    sf::Text text;
+};
+
+// A plain box, e.g. behind the dialogue
+class Panel : public Widget {
+public:
+    void setup(const sf::FloatRect& area, const sf::Color& fill, const sf::Color& outline, float outlineThickness);
+    void draw(sf::RenderTarget& target) override;
+
+private:
+    sf::RectangleShape shape;
+};
+
+// How a button looks in one of its states
+struct ButtonStyle {
+    sf::Color fill = sf::Color::Transparent;
+    sf::Color outline = sf::Color::Transparent;
+    sf::Color content = sf::Color::White;   // Text colour, or the sprite's tint
+};
+
+// Anything that can be clicked. A button looks hovered while the cursor is over it,
+// otherwise selected (a toggle that's on) or normal.
+class Button : public Widget {
+public:
+    void setStyles(const ButtonStyle& normal, const ButtonStyle& hover);
+    void setStyles(const ButtonStyle& normal, const ButtonStyle& hover, const ButtonStyle& selected);
+    void setSelected(bool selected);
+    bool isSelected() const;
+
+    std::function<void()> onClick;
+
+protected:
+    Button();
+    void hoverChanged(bool hovered, const sf::Vector2f& point) override;
+    void clicked(const sf::Vector2f& point) override;
+    void restyle();
+    virtual void applyStyle(const ButtonStyle& style) = 0;
+
+private:
+    ButtonStyle normal, hover, selectedStyle;
+    bool hovered = false;
+    bool selected = false;
+};
+
+// Text, on its own or centred in a box
+class TextButton : public Button {
+public:
+    void setup(const sf::Font& font, const sf::String& string, unsigned size);
+    void setPosition(float x, float y);         // No box: the text is the button
+    void setBox(const sf::FloatRect& area, float outlineThickness);
+    void draw(sf::RenderTarget& target) override;
+
+private:
+    void applyStyle(const ButtonStyle& style) override;
+
+    sf::Text text;
+    sf::RectangleShape box;
+    bool hasBox = false;
+};
+
+// An image, scaled to a width and centred on a point
+class SpriteButton : public Button {
+public:
+    void setTexture(const sf::Texture& texture, const sf::Vector2f& center, float width);
+    void draw(sf::RenderTarget& target) override;
+
+private:
+    void applyStyle(const ButtonStyle& style) override;
+
+    sf::Sprite sprite;
+};
+
+// A column of boxed options, one of which gets picked. The whole list is a single
+// widget to the layer; the row under the cursor is worked out from its position.
+class ListBox : public Widget {
+public:
+    ListBox();
+
+    void setup(const sf::Font& font, unsigned characterSize, const ButtonStyle& normal, const ButtonStyle& hover);
+    // Rows of rowSize, gap apart, centred on center
+    void setItems(const std::vector<sf::String>& items, const sf::Vector2f& center,
+        const sf::Vector2f& rowSize, float gap);
+    std::size_t getCount() const;
+    void draw(sf::RenderTarget& target) override;
+
+    std::function<void(std::size_t)> onSelect;
+
+private:
+    static const std::size_t none = static_cast<std::size_t>(-1);
+
+    struct Row {
+        sf::RectangleShape box;
+        sf::Text text;
+    };
+
+    bool contains(const sf::Vector2f& point) const override;
+    void hoverChanged(bool hovered, const sf::Vector2f& point) override;
+    void pointerMoved(const sf::Vector2f& point) override;
+    void clicked(const sf::Vector2f& point) override;
+    std::size_t rowAt(const sf::Vector2f& point) const;
+    void setHoveredRow(std::size_t row);
+    void style(Row& row, const ButtonStyle& look);
+
+    const sf::Font* font = nullptr;
+    unsigned characterSize = 22;
+    ButtonStyle normal, hover;
+    std::vector<Row> rows;      // Kept between setItems calls, so a new menu reuses them
+    std::size_t count = 0;
+    float pitch = 0.0f;         // Row height plus the gap
+    float rowHeight = 0.0f;
+    std::size_t hoveredRow = none;
+};
+
+// A box to type a line into. Clicking it focuses it; the screen passes typed
+// characters on with type() while it has focus.
+class TextField : public Widget {
+public:
+    TextField();
+
+    void setup(const sf::Font& font, unsigned size, const sf::FloatRect& area, std::size_t maxLength);
+    void setFocused(bool focused);
+    bool isFocused() const;
+    const sf::String& getString() const;
+    void setString(const sf::String& string);
+    // A TextEntered character: printable ones are added, backspace removes one.
+    // Returns false if it did nothing.
+    bool type(sf::Uint32 character);
+    void draw(sf::RenderTarget& target) override;
+
+    std::function<void()> onFocus;
+
+private:
+    void clicked(const sf::Vector2f& point) override;
+    void placeCaret();
+
+    sf::RectangleShape box;
+    sf::Text text;
+    sf::RectangleShape caret;
+    sf::String string;
+    std::size_t maxLength = 0;
+    bool focused = false;
+};
+
+#endif // WIDGET_HPP
@@ -0,0 +1,163 @@
+#include "WidgetLayer.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cmath>
+
+const float WidgetLayer::cellSize = 100.0f;
+
+WidgetLayer::WidgetLayer(sf::RenderTarget& target) : target(target) {
+}
+
+void WidgetLayer::add(Widget& widget) {
+    widget.layer = this;
+    widgets.push_back(&widget);
+    stale = true;
+}
+
+bool WidgetLayer::handleEvent(const sf::Event& event) {
+    PROFILE_SCOPE(WidgetEvents);
+    if (stale)
+        rebuild();
+
+    switch (event.type) {
+    case sf::Event::MouseMoved: {
+        pointer = toView(event.mouseMove.x, event.mouseMove.y);
+        hasPointer = true;
+        Widget* under = pick(pointer);
+        if (under == hovered) {
+            if (hovered) hovered->pointerMoved(pointer);
+        }
+        else {
+            setHovered(under);
+        }
+        return hovered != nullptr;
+    }
+    case sf::Event::MouseButtonPressed: {
+        if (event.mouseButton.button != sf::Mouse::Left)
+            return false;
+        pointer = toView(event.mouseButton.x, event.mouseButton.y);
+        hasPointer = true;
+        setHovered(pick(pointer));
+        Widget* clickedWidget = hovered;
+        if (clickedWidget)
+            clickedWidget->clicked(pointer);   // May show, hide or move widgets, including this one
+        return clickedWidget != nullptr;
+    }
+    case sf::Event::MouseLeft:
+    case sf::Event::LostFocus:
+        hasPointer = false;
+        setHovered(nullptr);
+        return false;
+    default:
+        return false;
+    }
+}
+
+void WidgetLayer::setModal(Widget* widget) {
+    if (modal == widget) return;
+    modal = widget;
+    stale = true;
+}
+
+void WidgetLayer::syncPointer(const sf::Vector2i& pixel) {
+    pointer = toView(pixel.x, pixel.y);
+    hasPointer = true;
+    stale = true;
+}
+
+void WidgetLayer::update() {
+    if (stale)
+        rebuild();
+}
+
+void WidgetLayer::draw(sf::RenderTarget& renderTarget) {
+    for (Widget* widget : widgets) {
+        if (widget->isVisible())
+            widget->draw(renderTarget);
+    }
+}
+
+void WidgetLayer::invalidate() {
+    stale = true;
+}
+
+// Counting pass, then a filling pass, so each cell's widgets sit together in one array
+void WidgetLayer::rebuild() {
+    stale = false;
+    sf::Vector2f size = target.getDefaultView().getSize();
+    columns = std::max(1u, static_cast<unsigned>(std::ceil(size.x / cellSize)));
+    rows = std::max(1u, static_cast<unsigned>(std::ceil(size.y / cellSize)));
+    cellStart.assign(columns * rows + 1, 0);
+
+    auto cellRange = [this](const sf::FloatRect& bounds, unsigned& x0, unsigned& y0, unsigned& x1, unsigned& y1) {
+        auto clampCell = [](float value, unsigned count) {
+            return static_cast<unsigned>(std::min(std::max(value, 0.0f), static_cast<float>(count - 1)));
+        };
+        x0 = clampCell(std::floor(bounds.left / cellSize), columns);
+        y0 = clampCell(std::floor(bounds.top / cellSize), rows);
+        x1 = clampCell(std::floor((bounds.left + bounds.width) / cellSize), columns);
+        y1 = clampCell(std::floor((bounds.top + bounds.height) / cellSize), rows);
+    };
+    auto hittable = [this](const Widget* widget) {
+        return widget->interactive && widget->isVisible() && (!modal || widget == modal);
+    };
+
+    for (Widget* widget : widgets) {
+        if (!hittable(widget)) continue;
+        unsigned x0, y0, x1, y1;
+        cellRange(widget->getBounds(), x0, y0, x1, y1);
+        for (unsigned y = y0; y <= y1; ++y)
+            for (unsigned x = x0; x <= x1; ++x)
+                ++cellStart[y * columns + x + 1];
+    }
+    for (std::size_t cell = 1; cell < cellStart.size(); ++cell)
+        cellStart[cell] += cellStart[cell - 1];
+
+    cellWidgets.resize(cellStart.back());
+    std::vector<std::uint32_t> filled(cellStart.begin(), cellStart.end() - 1);
+    for (std::size_t i = 0; i < widgets.size(); ++i) {
+        if (!hittable(widgets[i])) continue;
+        unsigned x0, y0, x1, y1;
+        cellRange(widgets[i]->getBounds(), x0, y0, x1, y1);
+        for (unsigned y = y0; y <= y1; ++y)
+            for (unsigned x = x0; x <= x1; ++x)
+                cellWidgets[filled[y * columns + x]++] = static_cast<std::uint16_t>(i);
+    }
+
+    // Something may have appeared under (or gone from under) a cursor that hasn't moved
+    Widget* under = hasPointer ? pick(pointer) : nullptr;
+    if (under && under == hovered)
+        hovered->pointerMoved(pointer);
+    else
+        setHovered(under);
+}
+
+// Topmost first: later widgets are drawn over earlier ones
+Widget* WidgetLayer::pick(const sf::Vector2f& point) {
+    if (point.x < 0.0f || point.y < 0.0f)
+        return nullptr;
+    unsigned x = static_cast<unsigned>(point.x / cellSize);
+    unsigned y = static_cast<unsigned>(point.y / cellSize);
+    if (x >= columns || y >= rows)
+        return nullptr;
+
+    std::size_t cell = y * columns + x;
+    for (std::uint32_t i = cellStart[cell + 1]; i > cellStart[cell]; --i) {
+        Widget* widget = widgets[cellWidgets[i - 1]];
+        if (widget->contains(point))
+            return widget;
+    }
+    return nullptr;
+}
+
+void WidgetLayer::setHovered(Widget* widget) {
+    if (widget == hovered) return;
+    Widget* left = hovered;
+    hovered = widget;
+    if (left) left->hoverChanged(false, pointer);
+    if (hovered) hovered->hoverChanged(true, pointer);
+}
+
+sf::Vector2f WidgetLayer::toView(int x, int y) const {
+    return target.mapPixelToCoords(sf::Vector2i(x, y), target.getDefaultView());
+}
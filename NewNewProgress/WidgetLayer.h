@@ -0,0 +1,63 @@
+#ifndef WIDGETLAYER_HPP
+#define WIDGETLAYER_HPP
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+#include "Widget.h"
+
+// The widgets of one screen and the lookup that finds which of them is under a
+// point. The screen is split into a grid of cells, each listing the interactive
+// widgets that overlap it, so a hit test only looks at the few widgets in the
+// cursor's cell.
+//
+// Hover and clicks are worked out from mouse events alone: nothing is polled or
+// tested per frame. A widget hears about the cursor only when it arrives, leaves
+// or clicks. Moving, showing or hiding a widget marks the grid stale; update()
+// rebuilds it once and checks again what's under the cursor, since a widget can
+// appear under a cursor that isn't moving.
+class WidgetLayer {
+public:
+    explicit WidgetLayer(sf::RenderTarget& target);
+
+    // Widgets are drawn and hit in the order they're added, later ones on top.
+    // The layer doesn't own them; they have to outlive it.
+    void add(Widget& widget);
+
+    // Mouse events; true if a widget took it, so the screen shouldn't act on it too
+    bool handleEvent(const sf::Event& event);
+    // While set, only this widget can be hovered or clicked (a menu that needs an answer)
+    void setModal(Widget* widget);
+    // The cursor may have moved while another screen was up; call when coming back
+    void syncPointer(const sf::Vector2i& pixel);
+
+    void update();      // Nothing to do unless a widget moved or was shown or hidden
+    void draw(sf::RenderTarget& target);    // Every visible widget, in order
+
+    void invalidate();  // Called by widgets whose bounds or visibility changed
+
+private:
+    void rebuild();
+    Widget* pick(const sf::Vector2f& point);
+    void setHovered(Widget* widget);
+    sf::Vector2f toView(int x, int y) const;
+
+    static const float cellSize;
+
+    sf::RenderTarget& target;
+    std::vector<Widget*> widgets;
+
+    // The grid: cell c lists cellWidgets[cellStart[c] .. cellStart[c + 1]), indices into widgets
+    std::vector<std::uint32_t> cellStart;
+    std::vector<std::uint16_t> cellWidgets;
+    unsigned columns = 0;
+    unsigned rows = 0;
+    bool stale = true;
+
+    Widget* hovered = nullptr;
+    Widget* modal = nullptr;
+    sf::Vector2f pointer;
+    bool hasPointer = false;
+};
+
+#endif // WIDGETLAYER_HPP
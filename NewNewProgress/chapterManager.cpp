@@ -1,44 +1,109 @@
-#include "chapterManager.h"
-
-void ChapterManager::transitionToChapter(sf::RenderWindow& window, sf::Font& bodyFont, const std::string& titleText) {
-    sf::Text text;
-    text.setFont(bodyFont);
-    text.setString(titleText);
-    text.setCharacterSize(70);
-    text.setFillColor(sf::Color::White);
-    text.setStyle(sf::Text::Bold);
-
-    // Center the text using origin
-    sf::FloatRect textRect = text.getLocalBounds();
-    text.setOrigin(textRect.left + textRect.width / 2.0f, textRect.top + textRect.height / 2.0f);
-    text.setPosition(window.getSize().x / 2.0f, window.getSize().y / 2.0f);
-
-    // Instruction text
-    /*sf::Text continueText;
-    continueText.setFont(bodyFont);
-    //continueText.setString("Click or press any key to continue...");
-    continueText.setCharacterSize(30);
-    continueText.setFillColor(sf::Color(200, 200, 200));
-    sf::FloatRect instrRect = continueText.getLocalBounds();
-    continueText.setOrigin(instrRect.left + instrRect.width / 2.0f, instrRect.top + instrRect.height / 2.0f);
-    continueText.setPosition(window.getSize().x / 2.0f, window.getSize().y * 0.75f);*/
-
-    bool waiting = true;
-    while (waiting && window.isOpen()) {
-        sf::Event event;
-        while (window.pollEvent(event)) {
-            if (event.type == sf::Event::Closed) {
-                window.close();
-                return;
-            }
-            if (event.type == sf::Event::KeyPressed || event.type == sf::Event::MouseButtonPressed) {
-                waiting = false;
-            }
-        }
-
-        window.clear(sf::Color::Black);
-        window.draw(text);
-        //window.draw(continueText);
-        window.display();
-    }
-}
\ No newline at end of file
+#include "chapterManager.h"
+#include "Game.h"
+#include "Profiler.h"
+#include <algorithm>
+
+ChapterManager::ChapterManager(sf::RenderWindow& win, sf::Font& bodyFont, Game& game)
+    : window(win), font(bodyFont), game(game)
+{
+    text.setFont(font);
+    text.setCharacterSize(70);
+    text.setFillColor(sf::Color::White);
+    text.setStyle(sf::Text::Bold);
+
+    // Instruction text
+    /*sf::Text continueText;
+    continueText.setFont(bodyFont);
+    //continueText.setString("Click or press any key to continue...");
+    continueText.setCharacterSize(30);
+    continueText.setFillColor(sf::Color(200, 200, 200));
+    sf::FloatRect instrRect = continueText.getLocalBounds();
+    continueText.setOrigin(instrRect.left + instrRect.width / 2.0f, instrRect.top + instrRect.height / 2.0f);
+    continueText.setPosition(window.getSize().x / 2.0f, window.getSize().y * 0.75f);*/
+}
+
+void ChapterManager::transitionToChapter(const std::vector<std::string>& chapterTitles, std::function<void()> onFinished) {
+    if (chapterTitles.empty()) {
+        if (onFinished) onFinished();
+        return;
+    }
+    titles = chapterTitles;
+    finished = onFinished;
+    waitingForLoad = false;
+    showTitle(0);
+    game.changeState(GameState::CHAPTER);
+}
+
+void ChapterManager::waitFor(const JobHandle& job) {
+    if (job)
+        loadJobs.push_back(job);
+}
+
+bool ChapterManager::isLoading() const {
+    return std::any_of(loadJobs.begin(), loadJobs.end(), [](const JobHandle& job) {
+        return !JobSystem::isDone(job);
+    });
+}
+
+void ChapterManager::showTitle(std::size_t index) {
+    titleIndex = index;
+    cardTime = 0.0f;
+    text.setString(titles[titleIndex]);
+
+    // Center the text using origin
+    sf::FloatRect textRect = text.getLocalBounds();
+    text.setOrigin(textRect.left + textRect.width / 2.0f, textRect.top + textRect.height / 2.0f);
+    text.setPosition(window.getSize().x / 2.0f, window.getSize().y / 2.0f);
+}
+
+void ChapterManager::advance() {
+    if (titleIndex + 1 < titles.size()) {
+        showTitle(titleIndex + 1);
+        return;
+    }
+
+    // Hold the last card until the next scene is fully loaded
+    if (isLoading()) {
+        waitingForLoad = true;
+        return;
+    }
+
+    loadJobs.clear();
+    game.getScreens().pop();
+    if (finished) {
+        std::function<void()> callback = finished;
+        finished = nullptr;
+        callback();
+    }
+}
+
+void ChapterManager::handleEvent(const sf::Event& event) {
+    if (event.type == sf::Event::KeyPressed || event.type == sf::Event::MouseButtonPressed)
+        advance();
+}
+
+void ChapterManager::update(float deltaTime) {
+    if (waitingForLoad) {
+        if (!isLoading())
+            advance();
+        return;
+    }
+
+    cardTime += deltaTime;
+
+    // Fade in, hold, fade out
+    float alpha = 1.0f;
+    if (cardTime < fadeDuration)
+        alpha = cardTime / fadeDuration;
+    else if (cardTime > cardDuration - fadeDuration)
+        alpha = std::max(0.0f, (cardDuration - cardTime) / fadeDuration);
+    text.setFillColor(sf::Color(255, 255, 255, static_cast<sf::Uint8>(alpha * 255)));
+
+    if (cardTime >= cardDuration)
+        advance();
+}
+
+void ChapterManager::draw(sf::RenderTarget& target) {
+    target.draw(text);
+    PROFILE_DRAW(text);
+}
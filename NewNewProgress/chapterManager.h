@@ -1,12 +1,54 @@
-#ifndef CHAPTER_MANAGER_H
-#define CHAPTER_MANAGER_H
-
-#include <SFML/Graphics.hpp>
-#include <string>
-
-class ChapterManager {
-public:
-    static void transitionToChapter(sf::RenderWindow& window, sf::Font& font, const std::string& chapterTitle);
-};
-
-#endif
\ No newline at end of file
+#ifndef CHAPTER_MANAGER_H
+#define CHAPTER_MANAGER_H
+
+#include <SFML/Graphics.hpp>
+#include <functional>
+#include <string>
+#include <vector>
+#include "Screen.h"
+#include "JobSystem.h"
+
+class Game;
+
+// Chapter title cards. Pushed on top of gameplay so the scene underneath stays alive.
+// Each card fades in, holds and fades out on its own, or is skipped with a key/click.
+// Jobs registered with waitFor load the next scene in the background while the cards
+// are up, and the last card is only dismissed once all of them have finished.
+class ChapterManager : public Screen {
+public:
+    ChapterManager(sf::RenderWindow& window, sf::Font& font, Game& game);
+
+    // Queue one or more cards; onFinished runs after the last one is dismissed
+    void transitionToChapter(const std::vector<std::string>& chapterTitles, std::function<void()> onFinished);
+
+    // Hold the last card until this job is done; jobs may register further jobs
+    void waitFor(const JobHandle& job);
+    bool isLoading() const;
+
+    void handleEvent(const sf::Event& event) override;
+    void update(float deltaTime) override;
+    void draw(sf::RenderTarget& target) override;
+
+private:
+    void showTitle(std::size_t index);
+    void advance();
+
+    sf::RenderWindow& window;
+    sf::Font& font;
+    Game& game;
+
+    sf::Text text;
+    std::vector<std::string> titles;
+    std::size_t titleIndex = 0;
+    std::function<void()> finished;
+
+    std::vector<JobHandle> loadJobs;
+
+    float cardTime = 0.0f;
+    bool waitingForLoad = false;    // Last card was dismissed but loading isn't done yet
+
+    const float cardDuration = 2.5f;
+    const float fadeDuration = 0.5f;
+};
+
+#endif